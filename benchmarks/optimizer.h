@@ -24,55 +24,279 @@
 
 /*! @file   benchmarks/optimizer.h
  * @ingroup benchmarks
+ * @brief Threshold autotuner.
  *
+ * Times two or more implementations of the same operation over a sweep of
+ * a parameter and finds the thresholds between them:
+ * \code
+ *   if (a <= threshold) then
+ *        toto()
+ *   else
+ *        titi()
+ * \endcode
+ * or that one of them is always better.  With a single implementation, the
+ * tuned value is the parameter of least time (a block size for instance).
+ *
+ * \code
+ * Optimizer opt("LINBOX_MATPOLY_KARA_THRESHOLD");
+ * opt.addCandidate("naive", prepareNaive);
+ * opt.addCandidate("Karatsuba", prepareKara);
+ * opt.setLinearSweep(2, 64, 2);
+ * opt.run();
+ * opt.fit();
+ * opt.report("tuned-thresholds.h", true); // #define LINBOX_MATPOLY_KARA_THRESHOLD ...
+ * \endcode
  */
 
 #ifndef __LINBOX_benchmarks_optimizer_H_
 #define __LINBOX_benchmarks_optimizer_H_
 
-namespace LinBox {
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <functional>
+#include <limits>
+#include <string>
+#include <vector>
 
-	/* optimiser from a graph. */
+#include "benchmarks/benchmark.h"
+#include "linbox/util/error.h"
+#include "linbox/util/timer.h"
 
-	/*
-	 *   -----
-	 *   if (a < threshold) then
-	 *        toto()
-	 *   else
-	 *        titi()
-	 *   ----
+namespace LinBox {
+
+	/** @brief Finds the thresholds between implementations from their timings.
 	 *
-	 * OR (always better)
+	 * Candidates are given in the order they are used when the parameter
+	 * grows.  Each one is timed at every point of the sweep with the
+	 * repetition policy of \c PlotData::keepon; the timings are the series
+	 * of \c data(), one per candidate, ready for a \c PlotGraph.
 	 *
-	 *   ----
-	 *   toto();
-	 *   ----
+	 * \c fit() assigns to each point the candidate of a monotone
+	 * assignment (candidate indices never decrease with the parameter) of
+	 * least total time, so that noisy isolated points do not create
+	 * spurious thresholds.  A threshold is then interpolated, on the log
+	 * of the time ratio, between the last point of a candidate and the
+	 * first point of the next one.
 	 */
-
-	// Optimizer opt(Data,Skeleton);
-	// opt.run();
-	// opt.report("file");
-
-	/* optimiser from two timers */
-	// Optimizer opt(class1,class2,Skeleton);
-	// opt.run();
-	// opt.report("file")
-	//
-	// opt.fit()
-	//
-	//
 	class Optimizer {
+	public:
+		typedef std::function<void()>       Run;     //!< one timed run
+		typedef std::function<Run(size_t)>  Prepare; //!< untimed set-up at a parameter, returns the run
+
+		/** @param name name of the tuned macro.  With more than two
+		 * candidates, the thresholds are <code>name_1, name_2,...</code>
+		 * unless named by \c setThresholdNames.
+		 */
+		Optimizer(const std::string & name) :
+			_name(name)
+		{}
+
+		void addCandidate(const std::string & label, const Prepare & prepare)
+		{
+			_labels.push_back(label);
+			_prepare.push_back(prepare);
+		}
+
+		void setThresholdNames(const std::vector<std::string> & names)
+		{
+			_thresholdNames = names;
+		}
+
+		void setSweep(const std::vector<size_t> & points)
+		{
+			_points = points;
+			std::sort(_points.begin(), _points.end());
+			_points.erase(std::unique(_points.begin(), _points.end()), _points.end());
+		}
+
+		void setLinearSweep(size_t min, size_t max, size_t step)
+		{
+			linbox_check(step);
+			std::vector<size_t> points;
+			for (size_t x = min; x <= max; x += step)
+				points.push_back(x);
+			setSweep(points);
+		}
+
+		void setGeometricSweep(size_t min, size_t max, double ratio = 2.)
+		{
+			linbox_check(min && ratio > 1.);
+			std::vector<size_t> points;
+			for (double x = (double)min; x <= (double)max; x *= ratio)
+				points.push_back((size_t)std::round(x));
+			setSweep(points);
+		}
+
+		//! Times every candidate at every point.
+		void run()
+		{
+			if (_prepare.empty() || _points.empty())
+				throw LinBoxError("Optimizer: no candidate or no point to time");
+			_data.clear();
+			_times.assign(_prepare.size(), dvector_t(_points.size()));
+			for (size_t c = 0; c < _prepare.size(); ++c) {
+				_data.newSeries(_labels[c]);
+				for (size_t i = 0; i < _points.size(); ++i) {
+					showAdvanceLinear(c*_points.size()+i+1, 1, _prepare.size()*_points.size());
+					Run f = _prepare[c](_points[i]);
+					Chrono<Givaro::Timer> TW;
+					size_t j = 0;
+					while (_data.keepon(j, TW.time())) {
+						TW.start();
+						f();
+						TW.stop();
+					}
+					dvector_t t = TW.times();
+					std::sort(t.begin(), t.end());
+					_times[c][i] = t[t.size()/2];
+					_data.setCurrentSeriesEntry(_points[i], _times[c][i], (double)_points[i], TW.time());
+				}
+				_data.finishSeries();
+			}
+			_fitted = false;
+		}
+
+		//! Computes the thresholds (or the best parameter) from the timings.
+		void fit()
+		{
+			const size_t k = _times.size(), n = _points.size();
+			if (k == 0 || _times[0].size() != n)
+				throw LinBoxError("Optimizer: fit() before run()");
+
+			_thresholds.clear();
+			if (k == 1) {
+				_best = _points[std::min_element(_times[0].begin(), _times[0].end()) - _times[0].begin()];
+				_fitted = true;
+				return;
+			}
+
+			// cost[c][i]: least time of points 0..i with point i on candidate c
+			dmatrix_t cost(k, dvector_t(n));
+			std::vector<std::vector<size_t> > from(k, std::vector<size_t>(n, 0));
+			for (size_t c = 0; c < k; ++c)
+				cost[c][0] = _times[c][0];
+			for (size_t i = 1; i < n; ++i) {
+				size_t arg = 0;
+				for (size_t c = 0; c < k; ++c) {
+					if (cost[c][i-1] < cost[arg][i-1]) arg = c;
+					cost[c][i] = cost[arg][i-1] + _times[c][i];
+					from[c][i] = arg;
+				}
+			}
+			std::vector<size_t> assign(n);
+			assign[n-1] = 0;
+			for (size_t c = 1; c < k; ++c)
+				if (cost[c][n-1] < cost[assign[n-1]][n-1]) assign[n-1] = c;
+			for (size_t i = n-1; i > 0; --i)
+				assign[i-1] = from[assign[i]][i];
+			_assign = assign;
+
+			for (size_t c = 0; c+1 < k; ++c) {
+				// last point on a candidate <= c
+				size_t i = 0;
+				while (i < n && assign[i] <= c) ++i;
+				double T;
+				if (i == 0)
+					T = _points[0] ? (double)_points[0] - 1 : 0.;
+				else if (i == n)
+					T = (double)_points[n-1];
+				else {
+					T = (double)_points[i-1];
+					const size_t a = assign[i-1], b = assign[i];
+					const double g0 = std::log(_times[a][i-1] / _times[b][i-1]);
+					const double g1 = std::log(_times[a][i] / _times[b][i]);
+					if (g0 < 0 && g1 > 0)
+						T += std::floor(((double)_points[i] - T) * (-g0) / (g1 - g0));
+				}
+				_thresholds.push_back(T);
+			}
+			_fitted = true;
+		}
+
+		//! Thresholds between candidates c and c+1, after \c fit().
+		const dvector_t & thresholds() const { return _thresholds; }
+
+		//! Parameter of least time, after \c fit() with a single candidate.
+		size_t best() const { return _best; }
+
+		//! Timings, one series per candidate.
+		PlotData & refData() { return _data; }
+
+		/** Writes the tuned values, with the timings in comments.
+		 * @param os output stream
+		 * @param header a C header (<code>\#define</code>) or a
+		 * configuration file (<code>name value</code> lines).
+		 */
+		std::ostream & report(std::ostream & os, bool header = false) const
+		{
+			if (!_fitted)
+				throw LinBoxError("Optimizer: report() before fit()");
+			const char * open = header ? "/* " : "# ";
+			const char * close = header ? " */" : "";
+			os << open << _name << ", tuned by benchmarks/optimizer.h" << close << std::endl;
+			os << open << "parameter";
+			for (size_t c = 0; c < _labels.size(); ++c)
+				os << ' ' << _labels[c];
+			os << close << std::endl;
+			for (size_t i = 0; i < _points.size(); ++i) {
+				os << open << _points[i];
+				for (size_t c = 0; c < _times.size(); ++c)
+					os << ' ' << _times[c][i];
+				os << close << std::endl;
+			}
 
+			if (_times.size() == 1)
+				write(os, _name, (double)_best, header);
+			for (size_t c = 0; c < _thresholds.size(); ++c)
+				write(os, thresholdName(c), _thresholds[c], header);
+			return os;
+		}
 
+		//! Same, to a file; a <code>.h</code> file gets a header.
+		void report(const std::string & filename, bool append = false) const
+		{
+			std::ofstream file(filename, append ? std::ios::app : std::ios::out);
+			const bool header = filename.size() > 2 && filename.compare(filename.size()-2, 2, ".h") == 0;
+			report(file, header);
+		}
 
-		void report(const std::string & filename) ;
+	protected:
+		std::string thresholdName(size_t c) const
+		{
+			if (c < _thresholdNames.size())
+				return _thresholdNames[c];
+			if (_thresholds.size() == 1)
+				return _name;
+			const size_t k = c+1;
+			return _name + "_" + toString(k);
+		}
 
-		void run() ;
+		static void write(std::ostream & os, const std::string & name, double value, bool header)
+		{
+			const long v = (long)value;
+			if (header)
+				os << "#ifndef " << name << std::endl
+				   << "#define " << name << ' ' << v << std::endl
+				   << "#endif" << std::endl;
+			else
+				os << name << ' ' << v << std::endl;
+		}
 
-		void fit();
+		std::string                 _name;
+		std::vector<std::string>    _labels;
+		std::vector<Prepare>        _prepare;
+		std::vector<std::string>    _thresholdNames;
+		std::vector<size_t>         _points;
+		dmatrix_t                   _times;       //!< median time, candidate by point
+		std::vector<size_t>         _assign;      //!< candidate of each point, after fit()
+		dvector_t                   _thresholds;
+		size_t                      _best = 0;
+		bool                        _fitted = false;
+		PlotData                    _data;
+	};
 
-	}
-}
+} // LinBox
 
 #endif // __LINBOX_benchmarks_optimizer_H_
 
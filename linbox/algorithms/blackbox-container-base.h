@@ -64,7 +64,7 @@ namespace LinBox
 		BlackboxContainerBase (const Blackbox *BB, const Field &F) :
 			_field (&F), _VD (F), _BB (BB), _size ((long)MIN (BB->rowdim (), BB->coldim ()))
 			,casenumber(0)
-			,u(F),v(F)
+			,u(F),v(F), _applies(0)
 		{
 			_size <<= 1;
 		}
@@ -74,7 +74,7 @@ namespace LinBox
 		BlackboxContainerBase (const Blackbox *BB, const Field &F, size_t Size) :
 			_field (&F), _VD (F), _BB (BB), _size ((long)Size)
 			,casenumber(0)
-			,u(F),v(F)
+			,u(F),v(F), _applies(0)
 		{}
 
 		virtual ~BlackboxContainerBase ()
@@ -101,6 +101,9 @@ namespace LinBox
 		const Field &field () const { return *_field; }
 		Blackbox    *getBB    () const { return _BB; }
 
+		/// Number of applies of the blackbox done so far.
+		size_t applies () const { return _applies; }
+
 	protected:
 
 		friend class const_iterator;
@@ -129,6 +132,7 @@ namespace LinBox
 		long                 casenumber;
 		BlasVector<Field>    u, v;
 		Element              _value;
+		size_t               _applies;
 
 		const Element &getvalue() { return _value; }
 
@@ -0,0 +1,283 @@
+/* linbox/algorithms/blackbox-container-multi.h
+ * Copyright (C) 2026 The LinBox group
+ *
+ * ========LICENCE========
+ * This file is part of the library LinBox.
+ *
+  * LinBox is free software: you can redistribute it and/or modify
+ * it under the terms of the  GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.	 See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ * ========LICENCE========
+ */
+
+/*! @file algorithms/blackbox-container-multi.h
+ * @ingroup algorithms
+ * @brief Several projections of a Krylov sequence per blackbox apply.
+ */
+
+#ifndef __LINBOX_blackbox_container_multi_H
+#define __LINBOX_blackbox_container_multi_H
+
+#include <algorithm>
+#include <vector>
+
+#include <givaro/givpoly1.h>
+
+#include "linbox/util/debug.h"
+#include "linbox/solutions/constants.h"
+#include "linbox/vector/blas-vector.h"
+#include "linbox/vector/vector-domain.h"
+#include "linbox/algorithms/massey-domain.h"
+
+namespace LinBox
+{
+
+	/** \brief Krylov sequence of a square blackbox, projected on several vectors.
+	 *
+	 * The terms \f$u_j^T A^i v\f$, for k random left vectors \f$u_j\f$,
+	 * are computed with a single apply of \f$A\f$ per index i.
+	 * Each projection is a sequence in the sense of \ref MasseyDomain,
+	 * see projection(j): the terms are computed when a projection first
+	 * needs them, and are kept for the other projections.
+	 *
+	 * A projection with an early terminated Berlekamp/Massey does not stop
+	 * the others, which may need more terms; see \ref MultiMasseyDomain.
+	 */
+	template<class Field, class _Blackbox>
+	class BlackboxMultiContainer {
+	public:
+		typedef _Blackbox Blackbox;
+		typedef typename Field::Element Element;
+
+		/// The j-th projected sequence, \f$(u_j^T A^i v)_i\f$.
+		class Projection {
+		public:
+			class const_iterator {
+				Projection *_p;
+				size_t _i;
+			public:
+				const_iterator () : _p(nullptr), _i(0) {}
+				const_iterator (Projection &P) : _p(&P), _i(0) {}
+				const_iterator &operator ++ () { ++_i; return *this; }
+				const Element  &operator *  () { return _p->_container->value (_p->_index, _i); }
+			};
+
+			Projection (BlackboxMultiContainer *C, size_t j) : _container(C), _index(j) {}
+
+			const_iterator begin () { return const_iterator (*this); }
+			long size () const { return _container->size (); }
+			const Field &field () const { return _container->field (); }
+
+		protected:
+			friend class const_iterator;
+			BlackboxMultiContainer *_container;
+			size_t _index;
+		};
+
+		/** Random projections.
+		 * @param BB square blackbox
+		 * @param F its field
+		 * @param k number of left projections
+		 * @param g random iterator for \f$u_j\f$ and \f$v\f$
+		 * @param Size length of the sequences, \f$2 n\f$ by default
+		 */
+		template<class RandIter>
+		BlackboxMultiContainer (const Blackbox *BB, const Field &F, size_t k, RandIter &g, size_t Size = 0) :
+			_field (&F), _VD (F), _BB (BB),
+			_size ( (long) (Size ? Size : (BB->rowdim () << 1)) ),
+			_a (F, BB->coldim ()), _b (F, BB->rowdim ()), _x (&_a), _y (&_b),
+			_count (0), _applies (0)
+		{
+			linbox_check (BB->rowdim () == BB->coldim ());
+			linbox_check (k > 0);
+
+			for (size_t i = 0; i < _a.size (); ++i)
+				g.random (_a[i]);
+
+			_u.reserve (k);
+			_values.resize (k);
+			_projections.reserve (k);
+			for (size_t j = 0; j < k; ++j) {
+				_u.emplace_back (F, BB->rowdim ());
+				for (size_t i = 0; i < _u[j].size (); ++i)
+					g.random (_u[j][i]);
+				_values[j].reserve ((size_t)_size + DEFAULT_ADDITIONAL_ITERATION);
+				_projections.emplace_back (this, j);
+			}
+		}
+
+		// the projections point to this container
+		BlackboxMultiContainer (const BlackboxMultiContainer&) = delete;
+
+		/// Number of projections.
+		size_t projections () const { return _u.size (); }
+
+		/// The j-th projected sequence.
+		Projection &projection (size_t j) { return _projections[j]; }
+
+		long size () const { return _size; }
+		const Field &field () const { return *_field; }
+		const Blackbox *getBB () const { return _BB; }
+
+		/// Number of applies of the blackbox done so far.
+		size_t applies () const { return _applies; }
+
+	protected:
+		const Field *_field;
+		VectorDomain<Field> _VD;
+		const Blackbox *_BB;
+		long _size;
+
+		std::vector<BlasVector<Field> > _u;
+		// *_x is A^(_count-1) v, *_y is scratch
+		BlasVector<Field> _a, _b;
+		BlasVector<Field> *_x, *_y;
+		std::vector<std::vector<Element> > _values;
+		std::vector<Projection> _projections;
+		size_t _count, _applies;
+
+		const Element &value (size_t j, size_t i)
+		{
+			while (_count <= i) next ();
+			return _values[j][i];
+		}
+
+		// All the projections of the next term
+		void next ()
+		{
+			if (_count) {
+				_BB->apply (*_y, *_x);
+				std::swap (_x, _y);
+				++_applies;
+			}
+			for (size_t j = 0; j < _u.size (); ++j) {
+				_values[j].emplace_back ();
+				_VD.dot (_values[j].back (), _u[j], *_x);
+			}
+			++_count;
+		}
+	};
+
+	/** \brief Berlekamp/Massey on all the projections of a \ref BlackboxMultiContainer.
+	 *
+	 * The result is the least common multiple of the generators of the
+	 * projected sequences: it divides the minimal polynomial of the blackbox
+	 * and equals it with a higher probability than a single projection.
+	 * The interface is that of \ref MasseyDomain.
+	 */
+	template<class Field, class Sequence>
+	class MultiMasseyDomain {
+	public:
+		typedef typename Field::Element Element;
+
+		MultiMasseyDomain (Sequence *S, size_t ett = LINBOX_DEFAULT_EARLY_TERMINATION_THRESHOLD) :
+			_container (S), _ett (ett)
+		{}
+
+		const Field &field () const { return _container->field (); }
+		Sequence *getSequence () const { return _container; }
+
+		/// Terms of the sequences read by the last run, the longest projection.
+		size_t sequenceLength () const { return _sequenceLength; }
+		/// Term at which the last projection terminated early, 0 if one did not.
+		size_t earlyTerminationStep () const { return _earlyTerminationStep; }
+
+		/// Monic lcm of the minimal polynomials of the projections, low degree first.
+		template<class Polynomial>
+		void minpoly (Polynomial &phi, size_t &rank, bool full_poly = true)
+		{
+			combine (phi, rank, full_poly, false);
+		}
+
+		/// Monic lcm of the pseudo minimal polynomials of the projections.
+		template<class Polynomial>
+		size_t pseudo_minpoly (Polynomial &phi, size_t &rank, bool full_poly = true)
+		{
+			combine (phi, rank, full_poly, true);
+			return phi.size () ? phi.size () - 1 : 0;
+		}
+
+	protected:
+		Sequence *_container;
+		size_t _ett;
+		size_t _sequenceLength = 0;
+		size_t _earlyTerminationStep = 0;
+
+		template<class Polynomial>
+		void combine (Polynomial &phi, size_t &rank, bool full_poly, bool pseudo)
+		{
+			typedef typename Sequence::Projection Projection;
+			typedef Givaro::Poly1Dom<Field, Givaro::Dense> PolyDom;
+			const Field &F = field ();
+			PolyDom PD (F);
+
+			commentator().start ("Multiple projections Massey", "multimassey", _container->projections ());
+
+			typename PolyDom::Element L;
+			PD.assign (L, PD.one);
+			_sequenceLength = 0;
+			bool terminated = true;
+			for (size_t j = 0; j < _container->projections (); ++j) {
+				MasseyDomain<Field, Projection> WD (&_container->projection (j), _ett);
+				BlasVector<Field> psi (F);
+				size_t r;
+				if (pseudo)
+					WD.pseudo_minpoly (psi, r, full_poly);
+				else
+					WD.minpoly (psi, r, full_poly);
+				_sequenceLength = std::max (_sequenceLength, WD.sequenceLength ());
+				terminated = terminated && (WD.earlyTerminationStep () != 0);
+
+				typename PolyDom::Element f, t;
+				f.resize (psi.size ());
+				for (size_t i = 0; i < psi.size (); ++i)
+					F.assign (f[i], psi[i]);
+				PD.setdegree (f);
+				if (f.size ()) {
+					PD.lcm (t, L, f);
+					L.swap (t);
+					PD.setdegree (L);
+				}
+				commentator().progress ((long)j+1);
+			}
+
+			_earlyTerminationStep = terminated ? _sequenceLength : 0;
+
+			// monic, low degree first
+			const size_t d (L.size () - 1);
+			Element lc; F.inv (lc, L[d]);
+			phi.resize (d+1);
+			for (size_t i = 0; i <= d; ++i)
+				F.mul (phi[i], L[i], lc);
+
+			size_t v (0);
+			while ( (v < d) && F.isZero (phi[v]) ) ++v;
+			rank = d - v;
+
+			commentator().report (Commentator::LEVEL_NORMAL, INTERNAL_DESCRIPTION)
+				<< "degree " << d << " with " << _container->applies () << " applies" << std::endl;
+			commentator().stop ("done", NULL, "multimassey");
+		}
+	};
+
+}
+
+#endif // __LINBOX_blackbox_container_multi_H
+
+// Local Variables:
+// mode: C++
+// tab-width: 4
+// indent-tabs-mode: nil
+// c-basic-offset: 4
+// End:
+// vim:sts=4:sw=4:ts=4:et:sr:cino=>s,f0,{0,g0,(0,\:0,t0,+0,=s
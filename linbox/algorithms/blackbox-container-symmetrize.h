@@ -89,11 +89,13 @@ namespace LinBox
 			if (this->casenumber) {
 				this->casenumber = 0;
 				this->_BB->apply (this->v, this->u);
+				++this->_applies;
 				this->_VD.dot (this->_value, this->v, this->v);
 			}
 			else {
 				this->casenumber = 1;
 				this->_BB->applyTranspose (this->u, this->v);
+				++this->_applies;
 				this->_VD.dot (this->_value, this->u, this->u);
 			}
 		}
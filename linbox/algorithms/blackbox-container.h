@@ -130,6 +130,7 @@ namespace LinBox
 				_timer.start ();
 #endif // INCLUDE_TIMING
 				this->_BB->apply (this->v, w);  // GV
+				++this->_applies;
 
 #ifdef INCLUDE_TIMING
 				_timer.stop ();
@@ -151,6 +152,7 @@ namespace LinBox
 				_timer.start ();
 #endif // INCLUDE_TIMING
 				this->_BB->apply (w, this->v);  // GV
+				++this->_applies;
 
 #ifdef INCLUDE_TIMING
 				_timer.stop ();
@@ -36,6 +36,8 @@
 #include <linbox/algorithms/smith-form-iliopoulos.h>
 #include <linbox/algorithms/poly-det.h>
 #include "linbox/ring/givaro-poly-mod-poly.h"
+#include "linbox/matrix/polynomial-matrix.h"
+#include "linbox/algorithms/polynomial-matrix/matpoly-det-adjoint.h"
 
 #include <omp.h>
 
@@ -55,6 +57,7 @@ public:
 	typedef typename PolyRing::Element PolyElement;
 	typedef MatrixDomain<PolyRing> PolyMatDom;
 	typedef typename PolyMatDom::OwnMatrix PolyBlock;
+	typedef PolynomialMatrix<Field,PMType::polfirst> PolyMatrix;
 
 	CoppersmithInvariantFactors():
 		M_(NULL), n_(0), b_(0) {}
@@ -128,6 +131,30 @@ public:
 		}
 #endif
 
+		// Fast path: if the largest invariant factor is the determinant,
+		// the other ones are 1.
+		{
+			PolyMatrix G(F_,b_,b_,d);
+			for (uint32_t i = 0; i < b_; ++i)
+				for (uint32_t j = 0; j < b_; ++j)
+					for (uint32_t k = 0; k < d; ++k)
+						F_.assign(G.ref(i,j,k),gen[k].getEntry(i,j));
+
+			PolyElement sb;
+			if (largestInvariantFactor(detPoly,sb,G) &&
+			    PD.degree(sb) == PD.degree(detPoly)) {
+				commentator().report(Commentator::LEVEL_IMPORTANT,PROGRESS_REPORT)
+					<<"Largest invariant factor is the determinant"<<std::endl;
+				diag.resize(b_);
+				for (uint32_t i = 0; i+1 < b_; ++i) {
+					PD.assign(diag[i],PD.one);
+				}
+				PD.assign(diag[b_-1],sb);
+				R.normalizeIn(diag[b_-1]);
+				return diag.size();
+			}
+		}
+
 		for (uint32_t i = 0; i < b_; ++i) {
 			for (uint32_t j = 0; j < b_; ++j) {
 				for (uint32_t k = 0; k < d; ++k) {
@@ -174,6 +201,54 @@ public:
 		return diag.size();
 	}
 
+	/** Determinant and largest invariant factor of a b x b polynomial matrix.
+	 *
+	 * \f$\det G\f$ and \f$\mathrm{adj}(G)\,w\f$, for a random w, are
+	 * computed by evaluation and interpolation (with FFT when the field
+	 * allows it, see \ref PolynomialMatrixDetAdjointDomain).  The result
+	 * \f$\det G / \gcd(\det G, \mathrm{adj}(G)\,w)\f$ always divides the
+	 * largest invariant factor of \p G, and equals it with high probability.
+	 * When its degree is that of \f$\det G\f$ it is certified.
+	 * @return false if \p G is singular or the field too small.
+	 */
+	template <class PMatrix>
+	bool largestInvariantFactor(PolyElement& detPoly, PolyElement& sb, const PMatrix& G)
+	{
+		typedef PolynomialMatrixDetAdjointDomain<Field> DetAdjDomain;
+		DetAdjDomain DAD(F_);
+		RandIter RI(F_);
+		BlasVector<Field> w(F_,G.rowdim());
+		for (size_t i = 0; i < w.size(); ++i) {
+			RI.random(w[i]);
+		}
+
+		typename DetAdjDomain::Polynomial det;
+		std::vector<typename DetAdjDomain::Polynomial> adjw;
+		if (!DAD.solve(det,adjw,G,w)) {
+			return false;
+		}
+
+		PolyDom PD(F_,"x");
+		PolyElement g,t,q;
+		detPoly.resize(det.size());
+		for (size_t k = 0; k < det.size(); ++k) {
+			F_.assign(detPoly[k],det[k]);
+		}
+		PD.setdegree(detPoly);
+		PD.assign(g,detPoly);
+		for (size_t i = 0; i < adjw.size(); ++i) {
+			t.resize(adjw[i].size());
+			for (size_t k = 0; k < adjw[i].size(); ++k) {
+				F_.assign(t[k],adjw[i][k]);
+			}
+			PD.setdegree(t);
+			PD.gcd(q,g,t);
+			g.swap(q);
+		}
+		PD.div(sb,detPoly,g);
+		return true;
+	}
+
 protected:
 
 	Domain MD_;
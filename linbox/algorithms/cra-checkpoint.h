@@ -0,0 +1,284 @@
+/* Copyright (C) 2026 The LinBox group
+ *
+ * ========LICENCE========
+ * This file is part of the library LinBox.
+ *
+  * LinBox is free software: you can redistribute it and/or modify
+ * it under the terms of the  GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.	 See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ * ========LICENCE========
+ */
+
+/*! @file algorithms/cra-checkpoint.h
+ * @brief Checkpoint/restart of the \ref CRA loops.
+ * @ingroup CRA
+ */
+
+#pragma once
+
+#include <iterator>
+#include <type_traits>
+#include <vector>
+
+#include "linbox/integer.h"
+#include "linbox/util/checkpoint.h"
+#include "linbox/util/commentator.h"
+#include "linbox/util/error.h"
+#include "linbox/util/serialization-stream.h"
+
+namespace LinBox {
+    /**
+     * \brief Journal of the images incorporated by a CRA loop.
+     *
+     * Each good iteration records its modulus (usually a prime) and its residue(s).
+     * The images recorded since the last write are periodically appended to the checkpoint file,
+     * so that writing costs the size of the new images, not of the whole history.
+     * On resume, the loop replays the journal through its builder:
+     * this restores the builder modulus and value, its early termination state
+     * and the set of primes used, at the cost of the reconstruction only,
+     * which is small compared to the cost of the iterations.
+     *
+     * Checkpoint payload, the kind of loop (varint, see Loop), then a sequence of batches, each one made of:
+     *  - number of bad primes so far (varint)
+     *  - number of entries (varint)
+     *  - for each entry: the modulus (Integer), the residue count (varint), the residues (Integers)
+     *
+     * When the checkpoint is not enabled, nothing is recorded.
+     * A checkpoint written by another kind of loop is not resumed.
+     */
+    class CRAJournal {
+    public:
+        struct Entry {
+            Integer modulus;
+            std::vector<Integer> residue;
+        };
+
+        /// What the entries are, which decides how a loop replays them.
+        enum class Loop : uint64_t {
+            Primes = 0,  //!< One entry per prime (Dispatch::Sequential, SMP and Distributed).
+            Combined = 1 //!< The first prime of the master, then products of primes (Dispatch::Combined).
+        };
+
+        CRAJournal() = default;
+
+        void configure(const Checkpoint& checkpoint)
+        {
+            _checkpoint = checkpoint;
+            _clock = CheckpointClock(checkpoint.interval);
+            _loaded = false;
+            _fresh = true;
+        }
+
+        /// Sets the kind of loop, before load().
+        void setLoop(Loop loop) { _loop = loop; }
+
+        bool enabled() const { return _checkpoint.enabled(); }
+
+        /// Entries of the loaded checkpoint, to be replayed.
+        const std::vector<Entry>& entries() const { return _entries; }
+
+        uint64_t bad() const { return _bad; }
+
+        /// Records a residue modulo the characteristic of D.
+        template <class Domain, class Residue>
+        void record(const Domain& D, const Residue& r)
+        {
+            if (!enabled()) return;
+
+            Entry entry;
+            D.characteristic(entry.modulus);
+            toIntegers(entry.residue, D, r, std::is_same<Residue, typename Domain::Element>());
+            _pending.emplace_back(std::move(entry));
+        }
+
+        /// Records residues given as integers modulo a composite modulus.
+        template <class IntVector>
+        void record(const Integer& modulus, const IntVector& r)
+        {
+            if (!enabled()) return;
+
+            Entry entry;
+            entry.modulus = modulus;
+            entry.residue.assign(r.begin(), r.end());
+            _pending.emplace_back(std::move(entry));
+        }
+
+        /// Forgets all entries, when the loop restarts: the next write replaces the file.
+        void restart()
+        {
+            _pending.clear();
+            _fresh = true;
+        }
+
+        /// Writes the entries recorded since the last write, if it is due or if forced.
+        void commit(uint64_t bad, bool force = false)
+        {
+            if (!enabled() || (!force && !_clock.due())) return;
+
+            _bad = bad;
+            auto writer = [this](std::ostream& os) { writeBatch(os, _pending); };
+            if (_fresh) {
+                write_checkpoint(_checkpoint.path, CheckpointKind::CRA, [this, &writer](std::ostream& os) {
+                    write_varint(os, (uint64_t)_loop);
+                    writer(os);
+                });
+                _fresh = false;
+            }
+            else {
+                append_checkpoint(_checkpoint.path, writer);
+            }
+            _pending.clear();
+            _clock.reset();
+        }
+
+        /**
+         * Loads the checkpoint file, once.
+         * Returns true if the caller has entries to replay.
+         * A batch truncated by a crash is dropped, and the file rewritten without it.
+         */
+        bool load()
+        {
+            if (_loaded || !enabled() || !_checkpoint.resume) return false;
+            _loaded = true;
+
+            _entries.clear();
+            bool truncated = false, mismatch = false;
+            bool found = read_checkpoint(_checkpoint.path, CheckpointKind::CRA, [this, &truncated, &mismatch](std::istream& is) {
+                try {
+                    mismatch = (read_varint(is) != (uint64_t)_loop);
+                }
+                catch (const LinboxError&) {
+                    truncated = true;
+                    return;
+                }
+                while (!mismatch && is.peek() != std::char_traits<char>::eof()) {
+                    std::vector<Entry> batch;
+                    uint64_t bad;
+                    try {
+                        bad = readBatch(batch, is);
+                    }
+                    catch (const LinboxError&) {
+                        truncated = true;
+                        break;
+                    }
+                    _bad = bad;
+                    std::move(batch.begin(), batch.end(), std::back_inserter(_entries));
+                }
+            });
+            if (!found) return false;
+
+            if (mismatch) {
+                commentator().report(Commentator::LEVEL_IMPORTANT, INTERNAL_WARNING)
+                    << "CRA checkpoint was made by another kind of loop, starting over." << std::endl;
+                return false;
+            }
+            if (truncated) {
+                write_checkpoint(_checkpoint.path, CheckpointKind::CRA, [this](std::ostream& os) {
+                    write_varint(os, (uint64_t)_loop);
+                    writeBatch(os, _entries);
+                });
+            }
+            _fresh = false;
+
+            return !_entries.empty();
+        }
+
+        /// Sets the residue r over D from an entry.
+        template <class Domain, class Residue>
+        static void assign(const Domain& D, Residue& r, const Entry& entry)
+        {
+            fromIntegers(r, D, entry.residue, std::is_same<Residue, typename Domain::Element>());
+        }
+
+    protected:
+        void writeBatch(std::ostream& os, const std::vector<Entry>& entries) const
+        {
+            write_varint(os, _bad);
+            write_varint(os, entries.size());
+            for (const auto& entry : entries) {
+                write_integer(os, entry.modulus);
+                write_varint(os, entry.residue.size());
+                for (const auto& x : entry.residue) {
+                    write_integer(os, x);
+                }
+            }
+        }
+
+        static uint64_t readBatch(std::vector<Entry>& entries, std::istream& is)
+        {
+            uint64_t bad = read_varint(is);
+            uint64_t count = read_varint(is);
+            for (uint64_t k = 0u; k < count; ++k) {
+                Entry entry;
+                read_integer(entry.modulus, is);
+                uint64_t size = read_varint(is);
+                for (uint64_t i = 0u; i < size; ++i) {
+                    Integer x;
+                    read_integer(x, is);
+                    entry.residue.emplace_back(std::move(x));
+                }
+                entries.emplace_back(std::move(entry));
+            }
+            return bad;
+        }
+
+        template <class Domain, class Element>
+        static void toIntegers(std::vector<Integer>& out, const Domain& D, const Element& e, std::true_type)
+        {
+            out.resize(1);
+            D.convert(out[0], e);
+        }
+
+        template <class Domain, class Vect>
+        static void toIntegers(std::vector<Integer>& out, const Domain& D, const Vect& v, std::false_type)
+        {
+            out.resize(v.size());
+            for (size_t i = 0; i < v.size(); ++i) {
+                D.convert(out[i], v[i]);
+            }
+        }
+
+        template <class Domain, class Element>
+        static void fromIntegers(Element& e, const Domain& D, const std::vector<Integer>& in, std::true_type)
+        {
+            D.init(e, in[0]);
+        }
+
+        template <class Domain, class Vect>
+        static void fromIntegers(Vect& v, const Domain& D, const std::vector<Integer>& in, std::false_type)
+        {
+            v.resize(in.size());
+            for (size_t i = 0; i < in.size(); ++i) {
+                D.init(v[i], in[i]);
+            }
+        }
+
+    protected:
+        Checkpoint _checkpoint;
+        CheckpointClock _clock;
+        std::vector<Entry> _entries; // loaded from the checkpoint
+        std::vector<Entry> _pending; // recorded since the last write
+        uint64_t _bad = 0u;
+        Loop _loop = Loop::Primes;
+        bool _loaded = false;
+        bool _fresh = true; // the next write creates the file
+    };
+}
+
+// Local Variables:
+// mode: C++
+// tab-width: 4
+// indent-tabs-mode: nil
+// c-basic-offset: 4
+// End:
+// vim:sts=4:sw=4:ts=4:et:sr:cino=>s,f0,{0,g0,(0,\:0,t0,+0,=s
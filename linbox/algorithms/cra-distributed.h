@@ -26,23 +26,43 @@
 
 #pragma once
 
+#include <exception>
 #include <unordered_set>
 #include <utility>
 #include <vector>
 
+#include <fflas-ffpack/paladin/parallel.h>
+
+#include "linbox/algorithms/cra-builder-full-multip.h"
+#include "linbox/algorithms/cra-checkpoint.h"
 #include "linbox/algorithms/cra-domain.h"
 #include "linbox/algorithms/rational-cra.h"
 #include "linbox/algorithms/rational-cra-var-prec.h"
 #include "linbox/integer.h"
 #include "linbox/randiter/random-prime.h"
 #include "linbox/solutions/methods.h"
+#include "linbox/util/commentator.h"
 #include "linbox/util/mpicpp.h"
+#include "linbox/util/statistics.h"
 #include "linbox/util/timer.h"
 
 #if defined(__LINBOX_HAVE_MPI)
 
 namespace LinBox {
 
+    /**
+     * \brief MPI version of the \ref CRA.
+     *
+     * The master node reconstructs the result while each worker node
+     * computes residues for its own subset of primes.
+     *
+     * When more than one thread per node is requested (Dispatch::Combined),
+     * each worker runs batches of iterations on its thread pool,
+     * reduces the batch residues locally to a single residue modulo
+     * the product of the batch primes, and only ships that one to the master.
+     * The master node runs such batches too, receiving between them.
+     * This is meant to be launched with one MPI process per node.
+     */
     template <class CRABase>
     struct ChineseRemainderDistributed {
         using Domain = typename CRABase::Domain;
@@ -53,21 +73,47 @@ namespace LinBox {
 
     protected:
         CRABase Builder_;
+        CRAJournal Journal_;
+        Checkpoint _checkpoint;
+        Statistics* _statistics = nullptr;
+        Integer _done = 1; //!< Product of the moduli already in the checkpoint.
         Communicator* _pCommunicator;
         double _hadamardLogBound;
         double _workerHadamardLogBound = 0.0; //!< Each worker will compute primes until this is hit.
+        size_t _numThreads = 1;               //!< Number of concurrent iterations on each worker.
 
     public:
-        ChineseRemainderDistributed(double b, Communicator* c)
+        ChineseRemainderDistributed(double b, Communicator* c, size_t numThreads = 1)
             : Builder_(b)
             , _pCommunicator(c)
             , _hadamardLogBound(b)
+            , _numThreads(numThreads)
         {
             if (c && c->size() > 1) {
                 _workerHadamardLogBound = _hadamardLogBound / (c->size() - 1);
             }
         }
 
+        /** \brief Enables periodic checkpointing of the loop, on the master.
+         *
+         * On resume, the master replays the checkpoint and broadcasts
+         * the product of its moduli, so that workers skip the primes already done.
+         */
+        void setCheckpoint(const Checkpoint& checkpoint)
+        {
+            _checkpoint = checkpoint;
+            if (_pCommunicator == nullptr || _pCommunicator->master()) {
+                Journal_.configure(checkpoint);
+            }
+        }
+
+        /** \brief Counts in statistics the primes this process computes a residue for.
+         */
+        void setStatistics(Statistics* statistics)
+        {
+            _statistics = statistics;
+        }
+
         /** \brief The CRA loop.
          *
          * \param Iteration  Function object of two arguments, \c
@@ -88,6 +134,8 @@ namespace LinBox {
             // Defer to standard CRA loop if no parallel usage is desired
             if (_pCommunicator == 0 || _pCommunicator->size() == 1) {
                 RationalChineseRemainder<CRABase> sequential(Builder_);
+                sequential.setCheckpoint(_checkpoint);
+                sequential.setStatistics(_statistics);
                 return sequential(num, den, Iteration, primeGenerator);
             }
 
@@ -107,6 +155,8 @@ namespace LinBox {
             // Defer to standard CRA loop if no parallel usage is desired
             if (_pCommunicator == 0 || _pCommunicator->size() == 1) {
                 ChineseRemainder<CRABase> sequential(Builder_);
+                sequential.setCheckpoint(_checkpoint);
+                sequential.setStatistics(_statistics);
                 return sequential(res, Iteration, primeGenerator);
             }
 
@@ -139,6 +189,16 @@ namespace LinBox {
             Domain D(*primeGenerator);
             BlasVector<Domain> r(D);
 
+            if (_numThreads > 1) {
+                if (_pCommunicator->master()) {
+                    master_process_combined_task(Iteration, D, r);
+                }
+                else {
+                    worker_process_combined_task(Iteration);
+                }
+                return;
+            }
+
             if (_pCommunicator->master()) {
                 master_process_task(Iteration, D, r);
             }
@@ -147,8 +207,12 @@ namespace LinBox {
             }
         }
 
+        /**
+         * Returns false, without computing anything,
+         * if the residue for the next prime is already in the checkpoint.
+         */
         template <class Any, class PrimeIterator, class Function>
-        void worker_compute(PrimeIterator& gen, Function& Iteration, Any& r)
+        bool worker_compute(PrimeIterator& gen, Function& Iteration, Any& r)
         {
             // Process mutual independent prime number generation
             ++gen;
@@ -156,8 +220,86 @@ namespace LinBox {
                 ++gen;
             }
 
+            if (done(*gen)) {
+                return false;
+            }
+
             Domain D(*gen);
             Iteration(r, D);
+            count();
+            return true;
+        }
+
+        void count(size_t n = 1)
+        {
+            if (_statistics != nullptr) _statistics->primes += n;
+        }
+
+        bool done(const Integer& p) const
+        {
+            Integer g;
+            return gcd(g, p, _done) != 1;
+        }
+
+        /**
+         * Master side of the resume, when all moduli are primes.
+         * Returns true if the builder has been initialized.
+         */
+        template <class Any>
+        bool replay(Any& r)
+        {
+            bool initialized = false;
+            if (Journal_.load()) {
+                for (const auto& entry : Journal_.entries()) {
+                    Domain D(entry.modulus);
+                    CRAJournal::assign(D, r, entry);
+                    if (!initialized) Builder_.initialize(D, r);
+                    else Builder_.progress(D, r);
+                    initialized = true;
+                    _done *= entry.modulus;
+                }
+            }
+            return initialized;
+        }
+
+        /**
+         * Master side of the resume for Dispatch::Combined.
+         * The first entry is the prime of the master,
+         * the others are products of the primes of a worker round.
+         */
+        bool replay_combined(BlasVector<Domain>& r)
+        {
+            using Ring = Givaro::ZRing<Integer>;
+            Ring ZZ;
+
+            bool initialized = false;
+            if (Journal_.load()) {
+                for (const auto& entry : Journal_.entries()) {
+                    if (!initialized) {
+                        Domain D(entry.modulus);
+                        CRAJournal::assign(D, r, entry);
+                        Builder_.initialize(D, r);
+                        initialized = true;
+                    }
+                    else {
+                        BlasVector<Ring> residue(ZZ, entry.residue.size());
+                        for (size_t i = 0; i < entry.residue.size(); ++i) {
+                            residue[i] = entry.residue[i];
+                        }
+                        Builder_.progress(entry.modulus, residue);
+                    }
+                    _done *= entry.modulus;
+                }
+            }
+            return initialized;
+        }
+
+        /**
+         * Everybody agrees on the product of the moduli already in the checkpoint.
+         */
+        void share_done()
+        {
+            _pCommunicator->bcast(_done, 0);
         }
 
         template <class Any, class Function>
@@ -165,13 +307,19 @@ namespace LinBox {
         {
             MaskedPrimeGenerator gen(_pCommunicator->rank() - 1, _pCommunicator->size() - 1);
 
+            share_done();
+
             // Each worker will work until _workerHadamardLogBound is hit
             double primesLogSum = 0.0;
             while (primesLogSum < _workerHadamardLogBound) {
-                worker_compute(gen, Iteration, r);
+                bool computed = worker_compute(gen, Iteration, r);
 
                 uint64_t p = *gen;
                 primesLogSum += Givaro::logtwo(p);
+                if (!computed) {
+                    continue;
+                }
+
                 _pCommunicator->send(p, 0);
                 _pCommunicator->send(r, 0);
             }
@@ -183,8 +331,14 @@ namespace LinBox {
         template <class Any, class Function>
         void master_process_task(Function& Iteration, Domain& D, Any& r)
         {
-            Iteration(r, D);
-            Builder_.initialize(D, r);
+            bool resumed = replay(r);
+            share_done();
+            if (!resumed) {
+                Iteration(r, D);
+                count();
+                Builder_.initialize(D, r);
+                Journal_.record(D, r);
+            }
 
             uint32_t workersDone = _pCommunicator->size() - 1;
             while (workersDone > 0) {
@@ -201,7 +355,200 @@ namespace LinBox {
 
                 Domain D(p);
                 Builder_.progress(D, r);
+                Journal_.record(D, r);
+                Journal_.commit(0u);
+            }
+        }
+
+        /**
+         * One round of Dispatch::Combined.
+         *
+         * Computes _numThreads residues concurrently, for the next primes of gen,
+         * and combines them into one residue modulo the product of the round primes.
+         * Returns false if there was nothing to compute,
+         * all the primes of the round being already known.
+         */
+        template <class Function>
+        bool combined_round(MaskedPrimeGenerator& gen, double& primesLogSum, Function& Iteration, Integer& modulus,
+                            BlasVector<Givaro::ZRing<Integer>>& residue)
+        {
+            const size_t NN = _numThreads;
+            std::vector<Domain> ROUNDdomains;
+            ROUNDdomains.reserve(NN);
+            std::vector<BlasVector<Domain>> ROUNDresidues;
+            ROUNDresidues.reserve(NN);
+
+            for (size_t i = 0; i < NN; ++i) {
+                ++gen;
+                primesLogSum += Givaro::logtwo(*gen);
+                if (done(*gen) || Builder_.noncoprime(*gen)) {
+                    continue;
+                }
+                ROUNDdomains.emplace_back(*gen);
+                ROUNDresidues.emplace_back(ROUNDdomains.back());
             }
+
+            const size_t roundSize = ROUNDdomains.size();
+            if (roundSize == 0u) {
+                return false;
+            }
+
+            // The tasks report to their own commentator, the global one is not thread safe.
+            // An exception must not leave a task: it is kept and thrown again by the caller thread.
+            std::vector<std::exception_ptr> ROUNDerrors(roundSize);
+            SYNCH_GROUP(
+            for (size_t i = 0; i < roundSize; ++i) {
+            { TASK(MODE(CONSTREFERENCE(ROUNDdomains, ROUNDresidues, ROUNDerrors)
+                        WRITE(ROUNDresidues[i], ROUNDerrors[i]) ),
+            {
+                TaskCommentator taskCommentator;
+                try {
+                    Iteration(ROUNDresidues[i], ROUNDdomains[i]);
+                }
+                catch (...) {
+                    ROUNDerrors[i] = std::current_exception();
+                }
+            })}
+            }
+            )
+            for (auto& error : ROUNDerrors) {
+                if (error) std::rethrow_exception(error);
+            }
+            count(roundSize);
+
+            // Local reduction: only one residue per round goes through MPI.
+            CRABuilderFullMultip<Domain> localBuilder;
+            localBuilder.initialize(ROUNDdomains[0], ROUNDresidues[0]);
+            for (size_t i = 1; i < roundSize; ++i) {
+                localBuilder.progress(ROUNDdomains[i], ROUNDresidues[i]);
+            }
+
+            localBuilder.getModulus(modulus);
+            localBuilder.result(residue);
+            return true;
+        }
+
+        /**
+         * Worker side of Dispatch::Combined.
+         *
+         * Each round gives a modulus and a residue which are sent to the master.
+         * A zero modulus is the poison pill.
+         */
+        template <class Function>
+        void worker_process_combined_task(Function& Iteration)
+        {
+            using Ring = Givaro::ZRing<Integer>;
+            Ring ZZ;
+
+            share_done();
+
+            // The master computes its share of the primes too.
+            MaskedPrimeGenerator gen(_pCommunicator->rank(), _pCommunicator->size());
+            const double logBound = _hadamardLogBound / _pCommunicator->size();
+
+            Integer modulus;
+            BlasVector<Ring> residue(ZZ);
+            double primesLogSum = 0.0;
+            while (primesLogSum < logBound) {
+                if (!combined_round(gen, primesLogSum, Iteration, modulus, residue)) {
+                    continue;
+                }
+
+                _pCommunicator->send(modulus, 0);
+                _pCommunicator->send(residue, 0);
+            }
+
+            Integer poisonPill(0);
+            _pCommunicator->send(poisonPill, 0);
+        }
+
+        /**
+         * Master side of Dispatch::Combined.
+         *
+         * The master runs the same rounds as the workers on its own share of the primes,
+         * and receives the residues the workers sent in between its rounds,
+         * so that its threads do not idle.
+         */
+        template <class Function>
+        void master_process_combined_task(Function& Iteration, Domain& D, BlasVector<Domain>& r)
+        {
+            using Ring = Givaro::ZRing<Integer>;
+            Ring ZZ;
+
+            Journal_.setLoop(CRAJournal::Loop::Combined);
+            bool resumed = replay_combined(r);
+            share_done();
+
+            // Product of the moduli given to the builder.
+            Integer used = _done;
+            if (!resumed) {
+                Iteration(r, D);
+                count();
+                Builder_.initialize(D, r);
+                Journal_.record(D, r);
+                D.characteristic(used);
+            }
+
+            MaskedPrimeGenerator gen(0, _pCommunicator->size());
+            const double logBound = _hadamardLogBound / _pCommunicator->size();
+
+            Integer modulus;
+            BlasVector<Ring> residue(ZZ);
+            uint32_t workersDone = _pCommunicator->size() - 1;
+            double primesLogSum = 0.0;
+            while (primesLogSum < logBound) {
+                if (combined_round(gen, primesLogSum, Iteration, modulus, residue)) {
+                    master_progress(used, modulus, residue);
+                }
+
+                while (workersDone > 0 && _pCommunicator->iprobe(MPI_ANY_SOURCE)) {
+                    master_receive_combined(workersDone, used, modulus, residue);
+                }
+            }
+
+            while (workersDone > 0) {
+                master_receive_combined(workersDone, used, modulus, residue);
+            }
+        }
+
+        void master_receive_combined(uint32_t& workersDone, Integer& used, Integer& modulus,
+                                     BlasVector<Givaro::ZRing<Integer>>& residue)
+        {
+            _pCommunicator->recv(modulus, MPI_ANY_SOURCE);
+            if (modulus == 0) {
+                workersDone -= 1;
+                return;
+            }
+
+            _pCommunicator->recv(residue, _pCommunicator->status().MPI_SOURCE);
+            master_progress(used, modulus, residue);
+        }
+
+        /**
+         * Gives the builder a residue modulo a product of distinct primes.
+         *
+         * The primes of the modulus which divide used, the product of the moduli
+         * the builder already has (e.g. the first prime of the master,
+         * which does not come from the masked generators), are stripped
+         * and the residue is reduced accordingly, as get_coprime does for the sequential loop.
+         */
+        void master_progress(Integer& used, Integer& modulus, BlasVector<Givaro::ZRing<Integer>>& residue)
+        {
+            Integer g;
+            gcd(g, modulus, used);
+            if (g != 1) {
+                modulus /= g;
+                if (modulus == 1) return;
+                for (auto& x : residue) {
+                    x %= modulus;
+                    if (x < 0) x += modulus;
+                }
+            }
+
+            Builder_.progress(modulus, residue);
+            Journal_.record(modulus, residue);
+            Journal_.commit(0u);
+            used *= modulus;
         }
     };
 }
@@ -34,12 +34,10 @@
 #ifndef __LINBOX_parallel_cra_H
 #define __LINBOX_parallel_cra_H
 
-#  ifndef DISABLE_COMMENTATOR
-#    warning "commentator is not thread safe"
-#    define DISABLE_COMMENTATOR
-#  endif
+#include <exception>
 
 #include "linbox/algorithms/cra-domain-sequential.h"
+#include "linbox/util/commentator.h"
 
 #ifndef __LB_CRA_REPORTING__
 # ifdef _LB_DEBUG
@@ -97,9 +95,13 @@ namespace LinBox
 			using ResidueType = typename CRAResidue<ResultType,Function>::template ResidueType<Domain>;
 			if (NN == 1) return Father_t::operator()(k, res,Iteration,primeiter);
 
+			this->template resume<ResultType,Function>();
+			const int iter0 = this->iterCount(), bad0 = this->nbad_;
+
 			std::vector<Domain> ROUNDdomains; ROUNDdomains.reserve(NN);
 			std::vector<ResidueType> ROUNDresidues; ROUNDresidues.reserve(NN);
 			std::vector<IterationResult> ROUNDresults(NN);
+			std::vector<std::exception_ptr> ROUNDerrors(NN);
 			std::set<Integer> coprimeset;
 
 			while (k != 0 && ! this->Builder_.terminated()) {
@@ -122,8 +124,8 @@ namespace LinBox
 
                 SYNCH_GROUP(
                 for(size_t i=0;i<NN;++i) {
-                { TASK(MODE(CONSTREFERENCE(ROUNDdomains,ROUNDresidues,ROUNDresults)
-                            WRITE(ROUNDresults[i], ROUNDresidues[i]) ),
+                { TASK(MODE(CONSTREFERENCE(ROUNDdomains,ROUNDresidues,ROUNDresults,ROUNDerrors)
+                            WRITE(ROUNDresults[i], ROUNDresidues[i], ROUNDerrors[i]) ),
                 {
 #if __LB_CRA_REPORTING__
                     std::ostringstream report;
@@ -134,11 +136,24 @@ namespace LinBox
                     std::clog << report.str();
 #endif
 
-                    ROUNDresults[i] = Iteration(ROUNDresidues[i], ROUNDdomains[i]);
+                    // the tasks report to their own commentator, the global one is not thread safe
+                    TaskCommentator taskCommentator;
+                    Instrumentation::Scope scope("cra: residue");
+                    scope.counter(0, (int64_t)i);
+                    // an exception must not leave the task, it is thrown again below
+                    try {
+                        ROUNDresults[i] = Iteration(ROUNDresidues[i], ROUNDdomains[i]);
+                    }
+                    catch (...) {
+                        ROUNDerrors[i] = std::current_exception();
+                    }
 
                 })}
                 }
                 )
+				for (auto& error : ROUNDerrors) {
+					if (error) std::rethrow_exception(error);
+				}
 
 
 				// if any thread says RESTART, then all CONTINUEs become SKIPs
@@ -149,6 +164,7 @@ namespace LinBox
 				if (anyrestart) {
 					this->nbad_ += this->ngood_;
 					this->ngood_ = 0;
+					this->Journal_.restart();
 				}
 
 				for (size_t i = 0; i < NN; ++i) {
@@ -162,12 +178,15 @@ namespace LinBox
 					else if (this->ngood_ == 0) {
 						this->ngood_ = 1;
 						this->Builder_.initialize(ROUNDdomains[i], ROUNDresidues[i]);
+						this->Journal_.record(ROUNDdomains[i], ROUNDresidues[i]);
 					}
 					else {
 						++this->ngood_;
 						this->Builder_.progress(ROUNDdomains[i], ROUNDresidues[i]);
+						this->Journal_.record(ROUNDdomains[i], ROUNDresidues[i]);
 					}
 				}
+				this->Journal_.commit(this->nbad_);
 
 #if __LB_CRA_REPORTING__
                 std::clog << "Current good/bad residues: "
@@ -177,6 +196,7 @@ namespace LinBox
 
 			}
 
+			this->count(iter0, bad0);
 			this->Builder_.result(res);
 			return this->Builder_.terminated();
 		}
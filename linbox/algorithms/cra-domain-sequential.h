@@ -34,6 +34,8 @@
 #include "linbox/integer.h"
 #include "linbox/solutions/methods.h"
 #include "linbox/vector/blas-vector.h"
+#include "linbox/algorithms/cra-checkpoint.h"
+#include "linbox/util/statistics.h"
 #include <utility>
 #include <stdlib.h>
 #include "linbox/util/commentator.h"
@@ -55,9 +57,12 @@ namespace LinBox
 
 	protected:
 		CRABase Builder_;
+		CRAJournal Journal_;
 		int ngood_ = 0;
 		int nbad_ = 0;
 		int nskip_ = 0;
+		bool resumed_ = false; // the primes of a checkpoint are not known to the prime iterator
+		Statistics* statistics_ = nullptr;
 
 		/** \brief Helper class to sample unique primes.
 		*/
@@ -102,9 +107,40 @@ namespace LinBox
 		 */
 		template <class PrimeIterator>
 		inline auto get_coprime(PrimeIterator& primeiter) const -> decltype(*primeiter) {
+			if (resumed_) {
+				while (Builder_.noncoprime(*primeiter)) ++primeiter;
+			}
 			return PrimeSampler<PrimeIterator>(*this, primeiter)();
 		}
 
+		/** \brief Adds the primes of a loop which started with
+		 * iter0 iterations and bad0 bad primes to the statistics.
+		 */
+		void count(int iter0, int bad0) const {
+			if (statistics_ == nullptr) return;
+			statistics_->primes += (uint64_t)(iterCount() - iter0);
+			statistics_->badPrimes += (uint64_t)(nbad_ - bad0);
+		}
+
+		/** \brief Replays the checkpoint, if any, through the builder.
+		 */
+		template <class ResultType, class Function>
+		void resume() {
+			if (ngood_ != 0 || ! Journal_.load()) return;
+
+			for (const auto& entry : Journal_.entries()) {
+				Domain D(entry.modulus);
+				auto r = CRAResidue<ResultType,Function>::create(D);
+				CRAJournal::assign(D, r, entry);
+				if (ngood_ == 0) Builder_.initialize(D, r);
+				else Builder_.progress(D, r);
+				++ngood_;
+			}
+			nbad_ = (int)Journal_.bad();
+			resumed_ = true;
+			commentator().report(Commentator::LEVEL_IMPORTANT, INTERNAL_DESCRIPTION) << "Resumed CRA from checkpoint with " << ngood_ << " primes" << std::endl;
+		}
+
 	public:
 		/** \brief Pass-through constructor to create the underlying builder.
 		 */
@@ -121,6 +157,28 @@ namespace LinBox
 			return ngood_ + nbad_;
 		}
 
+		/** \brief Enables periodic checkpointing of the loop.
+		 *
+		 * If checkpoint.resume is set and a checkpoint exists,
+		 * the next loop starts from it.
+		 */
+		void setCheckpoint(const Checkpoint& checkpoint) {
+			Journal_.configure(checkpoint);
+		}
+
+		/** \brief Counts the primes of the next loops in statistics,
+		 * the ones of a checkpoint excluded.
+		 */
+		void setStatistics(Statistics* statistics) {
+			statistics_ = statistics;
+		}
+
+		/** \brief Writes the checkpoint now.
+		 */
+		void checkpoint() {
+			Journal_.commit(nbad_, true);
+		}
+
             /** \brief The \ref CRA loop
              *
              * Given a function to generate residues \c mod a single prime,
@@ -174,6 +232,9 @@ namespace LinBox
 		template<class ResultType, class Function, class PrimeIterator>
 		bool operator() (int k, ResultType& res, Function& Iteration, PrimeIterator& primeiter)
             {
+				resume<ResultType,Function>();
+				const int iter0 = iterCount(), bad0 = nbad_;
+
 				while (k != 0 && ngood_ == 0) {
 					--k;
 					Domain D(*primeiter);
@@ -189,6 +250,7 @@ namespace LinBox
 					else {
 						++ngood_;
 						Builder_.initialize(D,r);
+						Journal_.record(D,r);
 					}
 #ifdef __LB_CRA_TIMING__
                     chrono.stop();
@@ -207,6 +269,8 @@ namespace LinBox
 					case IterationResult::CONTINUE:
 						++ngood_;
 						Builder_.progress(D, r);
+						Journal_.record(D, r);
+						Journal_.commit(nbad_);
 						break;
 					case IterationResult::SKIP:
 						doskip();
@@ -216,10 +280,13 @@ namespace LinBox
 						nbad_ += ngood_;
 						ngood_ = 1;
 						Builder_.initialize(D, r);
+						Journal_.restart();
+						Journal_.record(D, r);
 						break;
 					}
 				}
 
+				count(iter0, bad0);
                 Builder_.result(res);
 				return ngood_ > 0 && Builder_.terminated();
             }
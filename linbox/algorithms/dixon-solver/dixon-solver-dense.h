@@ -92,19 +92,29 @@ namespace LinBox {
 
         BlasMatrixDomain<Field> _bmdf;
 
+        Checkpoint _checkpoint;
+        Statistics* _statistics = nullptr;
+
 #ifdef RSTIMING
-        mutable Timer tSetup, ttSetup, tFastInvert,
-            ttFastInvert,                                               // only done in deterministic or inconsistent
-            tCheckConsistency, ttCheckConsistency,                      // includes lifting the certificate
-            tMakeConditioner, ttMakeConditioner, tInvertBP, ttInvertBP, // only done in random
-            tCheckAnswer, ttCheckAnswer, tCertSetup,
+        mutable Timer ttSetup,
+            ttFastInvert,                       // only done in deterministic or inconsistent
+            ttCheckConsistency,                 // includes lifting the certificate
+            ttMakeConditioner, ttInvertBP,      // only done in random
+            ttCheckAnswer,
             ttCertSetup, // remaining 3 only done when makeMinDenomCert = true
-            tCertMaking, ttCertMaking,
+            ttCertMaking,
 
-            tNonsingularSetup, ttNonsingularSetup, tNonsingularInv, ttNonsingularInv,
+            ttNonsingularSetup, ttNonsingularInv,
 
             totalTimer;
 
+        // the phases are traced as well, see linbox/util/instrumentation.h
+        mutable Instrumentation::TracedTimer tSetup{"dixon: setup"}, tFastInvert{"dixon: fast invert"},
+            tCheckConsistency{"dixon: check consistency"}, tMakeConditioner{"dixon: make conditioner"},
+            tInvertBP{"dixon: invert BP"}, tCheckAnswer{"dixon: check answer"}, tCertSetup{"dixon: certificate setup"},
+            tCertMaking{"dixon: certificate making"}, tNonsingularSetup{"dixon: nonsingular setup"},
+            tNonsingularInv{"dixon: nonsingular inverse"};
+
         mutable DixonTimer ttConsistencySolve, ttSystemSolve, ttCertSolve, ttNonsingularSolve;
 #endif
 
@@ -143,6 +153,28 @@ namespace LinBox {
 #endif
         }
 
+        /** Enables checkpointing of the p-adic lifting of solveNonsingular.
+         * If resuming, the prime of the existing checkpoint is tried first,
+         * so that its digits can be used.
+         */
+        void setCheckpoint(const Checkpoint& checkpoint)
+        {
+            _checkpoint = checkpoint;
+
+            LinBox::Integer p;
+            if (checkpoint.enabled() && checkpoint.resume && read_lifting_checkpoint_prime(p, checkpoint.path)) {
+                _prime = p;
+            }
+        }
+
+        /** Counts in statistics the lifted digits and times the phases
+         * (inverse mod p, lifting and reconstruction) of solveNonsingular.
+         */
+        void setStatistics(Statistics* statistics)
+        {
+            _statistics = statistics;
+        }
+
         /** Solve a linear system \c Ax=b over quotient field of a ring.
          *
          * @param num Vector of numerators of the solution
@@ -111,7 +111,10 @@ namespace LinBox {
                 tNonsingularInv.start();
 #endif
                 assert(FMP != NULL);
-                BMDF.invin(*invA, *FMP, notfr); // notfr <- nullity
+                {
+                    Statistics::Phase phase(_statistics, "dixon: inverse mod p");
+                    BMDF.invin(*invA, *FMP, notfr); // notfr <- nullity
+                }
                 delete FMP;
                 FMP = invA;
 
@@ -131,8 +134,15 @@ namespace LinBox {
 
         typedef DixonLiftingContainer<Ring, Field, IMatrix, BlasMatrix<Field>> LiftingContainer;
         LiftingContainer lc(_ring, *F, A, *FMP, b, _prime);
+        lc.setCheckpoint(_checkpoint);
+        lc.setStatistics(_statistics);
         RationalReconstruction<LiftingContainer> re(lc);
-        if (!re.getRational(num, den, 0)) {
+        bool lifted;
+        {
+            Statistics::Phase phase(_statistics, "dixon: lifting and reconstruction");
+            lifted = re.getRational(num, den, 0);
+        }
+        if (!lifted) {
             delete FMP;
             return SS_FAILED;
         }
@@ -298,6 +308,7 @@ namespace LinBox {
 #endif
 
         LiftingContainer lc(_ring, _field, At_minor, *Atp_minor_inv, zt, _prime);
+        lc.setStatistics(_statistics);
         RationalReconstruction<LiftingContainer> re(lc);
 
         BlasVector<Ring> shortNum(A.field(), rank);
@@ -524,6 +535,7 @@ namespace LinBox {
 
         using LiftingContainer = DixonLiftingContainer<Ring, Field, BlasMatrix<Ring>, BlasMatrix<Field>>;
         LiftingContainer lc2(_ring, _field, A_minor, Ap_minor_inv, q, _prime);
+        lc2.setStatistics(_statistics);
 
         RationalReconstruction<LiftingContainer> rere(lc2);
         Vector1 u_num(_ring, rank);
@@ -705,6 +717,7 @@ namespace LinBox {
 
             BlasMatrix<Ring> BBA_minor(A_minor);
             LiftingContainer lc(_ring, _field, BBA_minor, *Ap_minor_inv, newb, _prime);
+            lc.setStatistics(_statistics);
 
             // ----- Reconstruct rational
 
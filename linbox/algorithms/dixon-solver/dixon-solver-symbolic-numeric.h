@@ -38,6 +38,7 @@
 #include <cmath>
 #include "linbox/integer.h"
 #include "linbox/algorithms/rational-reconstruction2.h"
+#include "linbox/algorithms/numeric-solver-lapack.h"
 
 namespace LinBox
 {
@@ -170,8 +171,6 @@ namespace LinBox
 		inline static int cblas_hbound (integer& b, int m, int n, const double* M);
 
 #if __LINBOX_HAVE_CLAPACK
-		// compute the inverse of a general matrix
-		inline static int cblas_dgeinv(double* M, int n);
 		/* solve Ax = b
 		 * A, the integer matrix
 		 * b, integer rhs
@@ -185,34 +184,18 @@ namespace LinBox
 #endif
 	};
 #if __LINBOX_HAVE_CLAPACK
-	template <class Ring, class Field, class RandomPrime>
-	inline int DixonSolver<Ring, Field, RandomPrime, Method::SymbolicNumericNorm>::cblas_dgeinv(double* M, int n)
-	{
-		enum CBLAS_ORDER order = CblasRowMajor;
-		int lda = n;
-		int *P = new int[n];
-		int ierr = clapack_dgetrf (order, n, n, M, lda, P);
-		if (ierr != 0) {
-			commentator().report (Commentator::LEVEL_IMPORTANT, PARTIAL_RESULT)
-			/*std::cerr*/ << "In DixonSolver::cblas_dgeinv Matrix is not full rank" << std::endl;
-			delete[] P ;
-			return -1;
-		}
-		clapack_dgetri (order, n, M, lda, P);
-		delete[] P ;
-		return 0;
-	}
-
 	template <class Ring, class Field, class RandomPrime>
 	inline int DixonSolver<Ring, Field, RandomPrime, Method::SymbolicNumericNorm>::cblas_rsol (int n, const double* M, integer* numx, integer& denx, double* b)
 	{
 		if (n < 1) return 0;
-		double* IM = new double[n * n];
-		memcpy ((void*)IM, (const void*)M, sizeof(double)*(size_t)(n*n));
-		int ret;
-		//compute the inverse by flops
-		ret = cblas_dgeinv (IM, n);
-		if (ret != 0) {delete[] IM; return 1;}
+		// factor once, solve at each step
+		NumericLU LU;
+		if (LU.init (M, (size_t)n) != 0) {
+			commentator().report (Commentator::LEVEL_IMPORTANT, PARTIAL_RESULT)
+			<< "In DixonSolver::cblas_rsol Matrix is not full rank" << std::endl;
+			return 1;
+		}
+		const int correctBits = (int)LU.correctBits ();
 
 		double mnorm = cblas_dOOnorm(M, n, n);
 		// residual
@@ -246,7 +229,7 @@ namespace LinBox
 		memcpy ((void*) r, (const void*) b, sizeof(double)*(size_t)n);
 
 		do  {
-			cblas_dapply (n, n, IM, r, x);
+			LU.solve (x, r);
 			// compute ax
 			cblas_dapply (n, n, M, x, ax);
 			// compute ax = ax -r, the negative of residual
@@ -268,6 +251,7 @@ namespace LinBox
 			normr3 = normr3 > 2 ? normr3 : 2;
 			shift2 = floor(53. * log2 / log (normr3));
 			shift = (int)(shift < shift2 ? shift : shift2);
+			shift = (shift < correctBits ? shift : correctBits);
 
 			if (shift <= 0) {
 #ifdef DEBUGRC
@@ -275,10 +259,10 @@ namespace LinBox
 				printf("%f, %f\n", normr1, normr2);
 				printf ("%d, shift = ", shift);
 				printf ("OO-norm of matrix: %f\n", cblas_dOOnorm(M, n, n));
-				printf ("OO-norm of inverse: %f\n", cblas_dOOnorm(IM, n, n));
+				printf ("condition estimate: %g\n", 1. / LU.rcond());
 				printf ("Error, abort\n");
 #endif
-				delete[] IM; delete[] r; delete[] x; delete[] ax; delete[] d; delete[] num;
+				delete[] r; delete[] x; delete[] ax; delete[] d; delete[] num;
 				return 2;
 			}
 
@@ -411,7 +395,7 @@ namespace LinBox
 #endif
 
 		// garbage collector
-		delete[] IM; delete[] r; delete[] x; delete[] ax; delete[] d; delete[] num; delete[] sb;
+		delete[] r; delete[] x; delete[] ax; delete[] d; delete[] num; delete[] sb;
 
 		return ret;
 	}
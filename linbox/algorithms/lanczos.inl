@@ -34,7 +34,7 @@
 
 #include "linbox/blackbox/archetype.h"
 #include "linbox/blackbox/diagonal.h"
-#include "linbox/blackbox/transpose.h"
+#include "linbox/blackbox/preconditioned.h"
 #include "linbox/util/debug.h"
 #include "linbox/vector/vector-domain.h"
 
@@ -81,7 +81,9 @@ namespace LinBox
 
 		bool success = false;
 
-		LVector d1(field()), d2(field()), b1(field()), b2(field()), bp(field()), y(field()), Ax(field()), ATAx(field()), ATb(field());
+		typedef Diagonal<Field, VectorCategories::DenseVectorTag> DiagonalMatrix;
+
+		LVector d1(field()), d2(field()), b1(field()), bp(field()), y(field()), Ax(field()), ATAx(field()), ATb(field());
 
 		VectorWrapper::ensureDim (_w[0], A.coldim ());
 		VectorWrapper::ensureDim (_w[1], A.coldim ());
@@ -102,10 +104,9 @@ namespace LinBox
 				{
 					VectorWrapper::ensureDim (bp, A.coldim ());
 
-					Transpose<Blackbox> AT (&A);
-					Compose<Transpose<Blackbox>, Blackbox> B (&AT, &A);
+					DiagonalSymmetrized<Blackbox> B (nullptr, &A, nullptr);
 
-					AT.apply (bp, b);
+					A.applyTranspose (bp, b);
 
 					success = iterate (B, x, bp);
 
@@ -118,8 +119,8 @@ namespace LinBox
 					VectorWrapper::ensureDim (y, A.coldim ());
 
 					stream >> d1;
-					Diagonal<Field, typename VectorTraits<LVector>::VectorCategory> D (d1);
-					Compose<Blackbox, Diagonal<Field, typename VectorTraits<LVector>::VectorCategory> > B (&A, &D);
+					DiagonalMatrix D (d1);
+					Preconditioned<Blackbox, DiagonalMatrix> B (nullptr, &A, &D);
 
 					report << "Random D: ";
 					_VD.write (report, d1) << std::endl;
@@ -137,16 +138,14 @@ namespace LinBox
 					VectorWrapper::ensureDim (bp, A.coldim ());
 
 					stream >> d1;
-					Diagonal<Field, typename VectorTraits<LVector>::VectorCategory> D (d1);
-					Transpose<Blackbox> AT (&A);
-					Compose<Diagonal<Field, typename VectorTraits<LVector>::VectorCategory>, Blackbox> B1 (&D, &A);
-					Compose<Transpose<Blackbox>, Compose<Diagonal<Field, typename VectorTraits<LVector>::VectorCategory>, Blackbox> > B (&AT, &B1);
+					DiagonalMatrix D (d1);
+					DiagonalSymmetrized<Blackbox> B (nullptr, &A, &D);
 
 					report << "Random D: ";
 					_VD.write (report, d1) << std::endl;
 
 					D.apply (b1, b);
-					AT.apply (bp, b1);
+					A.applyTranspose (bp, b1);
 
 					success = iterate (B, x, bp);
 
@@ -158,32 +157,13 @@ namespace LinBox
 					VectorWrapper::ensureDim (d1, A.coldim ());
 					VectorWrapper::ensureDim (d2, A.rowdim ());
 					VectorWrapper::ensureDim (b1, A.rowdim ());
-					VectorWrapper::ensureDim (b2, A.coldim ());
 					VectorWrapper::ensureDim (bp, A.coldim ());
 					VectorWrapper::ensureDim (y, A.coldim ());
 
 					stream >> d1 >> d2;
-					Diagonal<Field, typename VectorTraits<LVector>::VectorCategory> D1 (d1);
-					Diagonal<Field, typename VectorTraits<LVector>::VectorCategory> D2 (d2);
-					Transpose<Blackbox> AT (&A);
-
-					Compose<Blackbox,
-					Diagonal<Field, typename VectorTraits<LVector>::VectorCategory> > B1 (&A, &D1);
-
-					Compose<Diagonal<Field, typename VectorTraits<LVector>::VectorCategory>,
-					Compose<Blackbox,
-					Diagonal<Field, typename VectorTraits<LVector>::VectorCategory> > > B2 (&D2, &B1);
-
-					Compose<Transpose<Blackbox>,
-					Compose<Diagonal<Field, typename VectorTraits<LVector>::VectorCategory>,
-					Compose<Blackbox,
-					Diagonal<Field, typename VectorTraits<LVector>::VectorCategory> > > > B3 (&AT, &B2);
-
-					Compose<Diagonal<Field, typename VectorTraits<LVector>::VectorCategory>,
-					Compose<Transpose<Blackbox>,
-					Compose<Diagonal<Field, typename VectorTraits<LVector>::VectorCategory>,
-					Compose<Blackbox,
-					Diagonal<Field, typename VectorTraits<LVector>::VectorCategory> > > > > B (&D1, &B3);
+					DiagonalMatrix D1 (d1);
+					DiagonalMatrix D2 (d2);
+					DiagonalSymmetrized<Blackbox> B (&D1, &A, &D2);
 
 					report << "Random D_1: ";
 					_VD.write (report, d1) << std::endl;
@@ -192,8 +172,8 @@ namespace LinBox
 					_VD.write (report, d2) << std::endl;
 
 					D2.apply (b1, b);
-					AT.apply (b2, b1);
-					D1.apply (bp, b2);
+					A.applyTranspose (bp, b1);
+					D1.applyIn (bp);
 
 					if ((success = iterate (B, y, bp)))
 						D1.apply (x, y);
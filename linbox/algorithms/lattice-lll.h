@@ -0,0 +1,474 @@
+/* linbox/algorithms/lattice-lll.h
+ * Copyright (C) 2026 The LinBox group
+ *
+ * ========LICENCE========
+ * This file is part of the library LinBox.
+ *
+ * LinBox is free software: you can redistribute it and/or modify
+ * it under the terms of the  GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.	 See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ * ========LICENCE========
+ */
+
+/*! @file algorithms/lattice-lll.h
+ * @ingroup algorithms
+ * @ingroup lattice
+ * @brief Floating point LLL reduction working directly on a \c BlasMatrix.
+ *
+ * This is the reduction behind \c latticeMethod::latticeNative of
+ * lattice.h; it needs neither NTL nor fplll.
+ */
+
+#ifndef __LINBOX_algorithms_lattice_lll_H
+#define __LINBOX_algorithms_lattice_lll_H
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <utility>
+#include <vector>
+
+#include <gmp.h>
+#ifdef __LINBOX_HAVE_MPFR
+#include <mpfr.h>
+#endif
+
+#include "linbox/integer.h"
+#include "linbox/util/debug.h"
+#include "linbox/util/error.h"
+#include "linbox/matrix/dense-matrix.h"
+
+namespace LinBox
+{
+
+	//! Floating point type of the Gram-Schmidt orthogonalisation in \ref LLLDomain.
+	enum class LLLPrecision {
+		Auto,       //!< double, then long double, then MPFR when the previous one fails
+		Double,
+		LongDouble,
+		MPFR        //!< only available with MPFR
+	};
+
+	namespace Protected
+	{
+		// the number d of type FT, of precision prec bits if FT has a variable precision
+		template<class FT>
+		inline FT lllNumber (double d, long) { return FT (d); }
+
+#ifdef __LINBOX_HAVE_MPFR
+		/*! Minimal MPFR number for the LLL.
+		 * The precision is given at construction, and copies keep it: the
+		 * MPFR default precision is global and the segments are reduced
+		 * concurrently, each with its own precision.
+		 */
+		class LLLMpfr {
+			mpfr_t _x;
+		public:
+			LLLMpfr (double d, mpfr_prec_t p) { mpfr_init2 (_x, p); mpfr_set_d (_x, d, MPFR_RNDN); }
+			LLLMpfr (const LLLMpfr &y) { mpfr_init2 (_x, mpfr_get_prec (y._x)); mpfr_set (_x, y._x, MPFR_RNDN); }
+			~LLLMpfr () { mpfr_clear (_x); }
+			LLLMpfr &operator= (const LLLMpfr &y) { mpfr_set (_x, y._x, MPFR_RNDN); return *this; }
+
+			mpfr_ptr get () { return _x; }
+			mpfr_srcptr get () const { return _x; }
+
+			LLLMpfr &operator+= (const LLLMpfr &y) { mpfr_add (_x, _x, y._x, MPFR_RNDN); return *this; }
+			LLLMpfr &operator-= (const LLLMpfr &y) { mpfr_sub (_x, _x, y._x, MPFR_RNDN); return *this; }
+			LLLMpfr &operator*= (const LLLMpfr &y) { mpfr_mul (_x, _x, y._x, MPFR_RNDN); return *this; }
+			LLLMpfr &operator/= (const LLLMpfr &y) { mpfr_div (_x, _x, y._x, MPFR_RNDN); return *this; }
+			friend LLLMpfr operator+ (LLLMpfr a, const LLLMpfr &b) { return a += b; }
+			friend LLLMpfr operator- (LLLMpfr a, const LLLMpfr &b) { return a -= b; }
+			friend LLLMpfr operator* (LLLMpfr a, const LLLMpfr &b) { return a *= b; }
+			friend LLLMpfr operator/ (LLLMpfr a, const LLLMpfr &b) { return a /= b; }
+			friend bool operator<  (const LLLMpfr &a, const LLLMpfr &b) { return mpfr_less_p (a._x, b._x); }
+			friend bool operator<= (const LLLMpfr &a, const LLLMpfr &b) { return mpfr_lessequal_p (a._x, b._x); }
+			friend bool operator>  (const LLLMpfr &a, const LLLMpfr &b) { return mpfr_greater_p (a._x, b._x); }
+		};
+
+		inline void lllConvert (LLLMpfr &x, const Integer &z) { mpfr_set_z (x.get (), z.get_mpz_const (), MPFR_RNDN); }
+		inline void lllRound (Integer &z, const LLLMpfr &x) { mpfr_get_z (z.get_mpz (), x.get (), MPFR_RNDN); }
+		inline LLLMpfr lllAbs (const LLLMpfr &x) { LLLMpfr y (x); mpfr_abs (y.get (), y.get (), MPFR_RNDN); return y; }
+		inline bool lllFinite (const LLLMpfr &x) { return mpfr_number_p (x.get ()); }
+
+		template<>
+		inline LLLMpfr lllNumber<LLLMpfr> (double d, long prec) { return LLLMpfr (d, (mpfr_prec_t) prec); }
+#endif
+
+		// nearest double, +-inf out of range
+		inline void lllConvert (double &x, const Integer &z)
+		{
+			long e;
+			double d = mpz_get_d_2exp (&e, z.get_mpz_const ());
+			x = std::ldexp (d, (int) std::min (e, 4096L));
+		}
+
+		// the 64 leading bits, so that a long double keeps its precision
+		inline void lllConvert (long double &x, const Integer &z)
+		{
+			const size_t nb = mpz_sizeinbase (z.get_mpz_const (), 2);
+			if (nb <= 53) {
+				x = (long double) mpz_get_d (z.get_mpz_const ());
+				return;
+			}
+			const long shift = (nb > 64) ? (long) nb - 64 : 0;
+			mpz_t t, h;
+			mpz_init (t);
+			mpz_tdiv_q_2exp (t, z.get_mpz_const (), (mp_bitcnt_t) shift);
+			const double hi = mpz_get_d (t);
+			mpz_init_set_d (h, hi);
+			mpz_sub (t, t, h);
+			const double lo = mpz_get_d (t);
+			mpz_clear (h);
+			mpz_clear (t);
+			x = std::ldexp ((long double) hi + (long double) lo, (int) std::min (shift, 65536L));
+		}
+
+		template<class FT>
+		inline void lllRoundBuiltin (Integer &z, FT x)
+		{
+			// x = y 2^sh, y an integer of at most 64 bits split in two exact doubles
+			int e;
+			x = std::nearbyint (x);
+			std::frexp (x, &e);
+			const int sh = (e > 64) ? e - 64 : 0;
+			x = std::ldexp (x, -sh);
+			const double hi = (double) x;
+			const double lo = (double) (x - (FT) hi);
+			mpz_set_d (z.get_mpz (), hi);
+			if (lo != 0) {
+				mpz_t t;
+				mpz_init_set_d (t, lo);
+				mpz_add (z.get_mpz (), z.get_mpz (), t);
+				mpz_clear (t);
+			}
+			if (sh)
+				mpz_mul_2exp (z.get_mpz (), z.get_mpz (), (mp_bitcnt_t) sh);
+		}
+		inline void lllRound (Integer &z, double x) { lllRoundBuiltin (z, x); }
+		inline void lllRound (Integer &z, long double x) { lllRoundBuiltin (z, x); }
+		inline double lllAbs (double x) { return std::fabs (x); }
+		inline long double lllAbs (long double x) { return std::fabs (x); }
+		inline bool lllFinite (double x) { return std::isfinite (x); }
+		inline bool lllFinite (long double x) { return std::isfinite (x); }
+
+		// the Gram-Schmidt orthogonalisation lost too much precision
+		struct LLLPrecisionFailure {};
+	}
+
+	/** \brief LLL reduction of the rows of a \c BlasMatrix over the integers.
+	 *
+	 * This is the L² algorithm of Nguyen and Stehlé: the Gram matrix of the
+	 * basis is kept exactly, the Gram-Schmidt coefficients are computed in
+	 * floating point from it, and the size reduction is lazy.  The basis is
+	 * always a basis of the lattice, so that when the floating point type
+	 * fails (the size reduction does not converge, or the numbers overflow)
+	 * the reduction goes on from where it stopped with a larger type:
+	 * \c double, \c long \c double, then MPFR with a doubling precision.
+	 *
+	 * The row operations on the basis and on the transformation are shared
+	 * among OpenMP threads when the rows have at least \c grain entries.
+	 *
+	 * With a segment size \f$s\f$, the rows are cut in segments of \f$s\f$
+	 * rows reduced independently and in parallel, then the reduced segments
+	 * are merged two by two, each merge being a reduction of a basis whose
+	 * two halves are reduced.  The merges redo part of the work: on one
+	 * thread this is usually slower than the plain reduction, it is meant
+	 * for large dimensions on several threads.
+	 *
+	 * As in NTL, the rows may be linearly dependent: the zero vectors end
+	 * up first, and reduce returns the rank.
+	 */
+	template<class Ring>
+	class LLLDomain {
+	public:
+		typedef typename Ring::Element Element;
+		typedef BlasMatrix<Ring>        Matrix;
+
+	private:
+		double       _delta;
+		double       _eta;
+		LLLPrecision _prec;
+		size_t       _segment;
+		size_t       _grain;
+
+		Element   *_b;     // basis, row major
+		Element   *_u;     // transformation, or null
+		size_t     _ldb, _ldu, _m, _n;
+
+	public:
+		/**
+		 * @param delta   Lovász constant, in (1/4, 1)
+		 * @param eta     size reduction constant, in (1/2, sqrt(delta))
+		 * @param prec    floating point type
+		 * @param segment rows per segment, 0 for a plain reduction
+		 * @param grain   smallest row length with parallel row operations
+		 */
+		LLLDomain (double delta = 0.99, double eta = 0.51,
+			   LLLPrecision prec = LLLPrecision::Auto, size_t segment = 0, size_t grain = 64) :
+			_delta (delta), _eta (eta), _prec (prec), _segment (segment), _grain (grain),
+			_b (nullptr), _u (nullptr), _ldb (0), _ldu (0), _m (0), _n (0)
+		{
+			linbox_check (delta > 0.25 && delta < 1);
+			linbox_check (eta >= 0.5 && eta * eta < delta);
+		}
+
+		/** Reduces the rows of \p B in place.
+		 * @return the rank of the rows of \p B.
+		 */
+		size_t reduceIn (Matrix &B)
+		{
+			return reduceIn (B, nullptr);
+		}
+
+		/** Reduces the rows of \p B in place, and sets \p U to the unimodular
+		 * matrix such that the new \p B is \p U times the old one.
+		 * \p U must be square of dimension the row dimension of \p B.
+		 * @return the rank of the rows of \p B.
+		 */
+		size_t reduceIn (Matrix &B, Matrix &U)
+		{
+			linbox_check (U.rowdim () == B.rowdim () && U.coldim () == B.rowdim ());
+			for (size_t i = 0; i < U.rowdim (); ++i)
+				for (size_t j = 0; j < U.coldim (); ++j)
+					U.setEntry (i, j, (i == j) ? U.field ().one : U.field ().zero);
+			return reduceIn (B, &U);
+		}
+
+	private:
+		size_t reduceIn (Matrix &B, Matrix *U)
+		{
+			_b = B.getPointer (); _ldb = B.getStride ();
+			_m = B.coldim (); _n = B.rowdim ();
+			_u = U ? U->getPointer () : nullptr;
+			_ldu = U ? U->getStride () : 0;
+			if (_n == 0) return 0;
+
+			if (_segment == 0 || _n <= _segment)
+				return _n - reduceRange (0, _n);
+
+			// bottom up: the segments, then the merges of pairs of segments
+			size_t zeros = 0;
+			for (size_t s = _segment; ; s *= 2) {
+				const long nb = (long) ((_n + s - 1) / s);
+				if (nb == 1) {
+					zeros = reduceRange (0, _n);
+					break;
+				}
+				bool failed = false;
+#pragma omp parallel for schedule(dynamic)
+				for (long i = 0; i < nb; ++i) {
+					try { reduceRange ((size_t) i * s, std::min ((size_t) (i+1) * s, _n)); }
+					catch (...) {
+#pragma omp atomic write
+						failed = true;
+					}
+				}
+				if (failed)
+					throw LinboxError ("LLL: the floating point precision is not enough");
+			}
+			return _n - zeros;
+		}
+
+		// reduction of the rows [lo, hi), returns the number of zero rows
+		size_t reduceRange (size_t lo, size_t hi)
+		{
+			if (_prec == LLLPrecision::Double || _prec == LLLPrecision::Auto) {
+				try { return reduceRange<double> (lo, hi); }
+				catch (const Protected::LLLPrecisionFailure &) {
+					if (_prec == LLLPrecision::Double)
+						throw LinboxError ("LLL: double precision is not enough");
+				}
+			}
+			if (_prec == LLLPrecision::LongDouble
+			    || (_prec == LLLPrecision::Auto && std::numeric_limits<long double>::digits > 53)) {
+				try { return reduceRange<long double> (lo, hi); }
+				catch (const Protected::LLLPrecisionFailure &) {
+					if (_prec == LLLPrecision::LongDouble)
+						throw LinboxError ("LLL: long double precision is not enough");
+				}
+			}
+#ifdef __LINBOX_HAVE_MPFR
+			// heuristic precision of L², doubled until it works
+			for (mpfr_prec_t p = std::max<mpfr_prec_t> (128, (mpfr_prec_t) (1.6 * double (hi-lo)) + 64); p < (1 << 20); p *= 2) {
+				try { return reduceRange<Protected::LLLMpfr> (lo, hi, (long) p); }
+				catch (const Protected::LLLPrecisionFailure &) {}
+			}
+#endif
+			throw LinboxError ("LLL: the floating point precision is not enough");
+		}
+
+		// rows i of the basis and of the transformation
+		Element *brow (size_t i) const { return _b + i * _ldb; }
+		Element *urow (size_t i) const { return _u + i * _ldu; }
+
+		void swapRows (size_t i, size_t j)
+		{
+			std::swap_ranges (brow (i), brow (i) + _m, brow (j));
+			if (_u) std::swap_ranges (urow (i), urow (i) + _n, urow (j));
+		}
+
+		// b_k <- b_k - sum_j X_j b_j, same on the transformation
+		void subRows (size_t k, const std::vector<std::pair<size_t, Element> > &X)
+		{
+			Element *bk = brow (k);
+#pragma omp parallel for if (_m >= _grain) schedule(static)
+			for (long c = 0; c < (long) _m; ++c)
+				for (const auto &x : X)
+					mpz_submul (bk[c].get_mpz (), x.second.get_mpz_const (), brow (x.first)[c].get_mpz_const ());
+			if (! _u) return;
+			Element *uk = urow (k);
+#pragma omp parallel for if (_n >= _grain) schedule(static)
+			for (long c = 0; c < (long) _n; ++c)
+				for (const auto &x : X)
+					mpz_submul (uk[c].get_mpz (), x.second.get_mpz_const (), urow (x.first)[c].get_mpz_const ());
+		}
+
+		// with numbers of type FT, of precision prec for MPFR
+		template<class FT>
+		size_t reduceRange (size_t lo, size_t hi, long prec = 0)
+		{
+			using namespace Protected;
+			const size_t d = hi - lo;
+			const FT delta = lllNumber<FT> (_delta, prec), eta = lllNumber<FT> (_eta, prec);
+			const FT half = lllNumber<FT> (0.5, prec), zero = lllNumber<FT> (0, prec);
+
+			// exact Gram matrix, local indices, lower half, known up to row kmax
+			std::vector<Element> G (d * d);
+			auto g = [&] (size_t i, size_t j) -> Element& { return (i < j) ? G[j*d+i] : G[i*d+j]; };
+			size_t kmax = 0;
+			auto newRow = [&] (size_t k) {
+				const Element *bk = brow (lo+k);
+#pragma omp parallel for if (_m >= _grain) schedule(static)
+				for (long j = 0; j <= (long) k; ++j) {
+					Element s (0);
+					const Element *bj = brow (lo+j);
+					for (size_t c = 0; c < _m; ++c)
+						mpz_addmul (s.get_mpz (), bk[c].get_mpz_const (), bj[c].get_mpz_const ());
+					g (k, j) = s;
+				}
+			};
+			newRow (0);
+			auto swapVectors = [&] (size_t a, size_t b) {
+				swapRows (lo+a, lo+b);
+				for (size_t j = 0; j <= kmax; ++j)
+					if (j != a && j != b)
+						std::swap (g (a, j), g (b, j));
+				std::swap (g (a, a), g (b, b));
+			};
+
+			std::vector<FT> r (d * d, zero), mu (d * d, zero), s (d + 1, zero);
+			std::vector<std::pair<size_t, Element> > X;
+			std::vector<Element> v (d);
+			FT t (zero);
+			Element x;
+
+			size_t z = 0; // zero rows, first
+			size_t k = 0;
+			while (k < d) {
+				if (k > kmax)
+					newRow (kmax = k);
+
+				// lazy size reduction of b_k against b_z..b_{k-1}
+				FT prevmu (zero);
+				for (size_t iter = 0, stall = 0; ; ++iter) {
+					if (iter > 64 + 4 * d)
+						throw LLLPrecisionFailure ();
+					FT maxmu (zero);
+					for (size_t j = z; j < k; ++j) {
+						lllConvert (r[k*d+j], g (k, j));
+						for (size_t i = z; i < j; ++i)
+							r[k*d+j] -= mu[j*d+i] * r[k*d+i];
+						mu[k*d+j] = r[k*d+j] / r[j*d+j];
+						if (! lllFinite (mu[k*d+j]))
+							throw LLLPrecisionFailure ();
+						maxmu = std::max (maxmu, lllAbs (mu[k*d+j]));
+					}
+					if (maxmu <= eta)
+						break;
+					// no progress: the orthogonalisation is wrong
+					stall = (iter > 0 && ! (maxmu < prevmu)) ? stall + 1 : 0;
+					if (stall > 2)
+						throw LLLPrecisionFailure ();
+					prevmu = maxmu;
+
+					X.clear ();
+					for (size_t j = k; j-- > z; ) {
+						if (! lllFinite (mu[k*d+j]))
+							throw LLLPrecisionFailure ();
+						if (lllAbs (mu[k*d+j]) <= half)
+							continue;
+						lllRound (x, mu[k*d+j]);
+						lllConvert (t, x);
+						for (size_t i = z; i < j; ++i)
+							mu[k*d+i] -= t * mu[j*d+i];
+						X.emplace_back (lo + j, x);
+					}
+					if (X.empty ())
+						break;
+					subRows (lo + k, X);
+
+					// Gram matrix: v_i = sum_j X_j g_ji, g_kk -= 2 v_k - sum_j X_j v_j
+#pragma omp parallel for if (kmax * X.size () >= 4 * _grain) schedule(static)
+					for (long i = 0; i <= (long) kmax; ++i) {
+						v[i] = Element (0);
+						for (const auto &y : X)
+							mpz_addmul (v[i].get_mpz (), y.second.get_mpz_const (), g (y.first-lo, i).get_mpz_const ());
+					}
+					Element &gkk = g (k, k);
+					for (const auto &y : X)
+						mpz_addmul (gkk.get_mpz (), y.second.get_mpz_const (), v[y.first-lo].get_mpz_const ());
+					mpz_submul_ui (gkk.get_mpz (), v[k].get_mpz_const (), 2);
+					for (size_t i = 0; i <= kmax; ++i)
+						if (i != k)
+							mpz_sub (g (k, i).get_mpz (), g (k, i).get_mpz_const (), v[i].get_mpz_const ());
+				}
+
+				// a zero vector goes first, the orthogonalisation starts again after it
+				if (mpz_sgn (g (k, k).get_mpz_const ()) == 0) {
+					for (size_t i = k; i > z; --i)
+						swapVectors (i, i-1);
+					k = ++z;
+					continue;
+				}
+
+				// s_j = |b_k|^2 - sum_{i<j} mu_ki r_ki
+				lllConvert (s[z], g (k, k));
+				for (size_t j = z; j < k; ++j)
+					s[j+1] = s[j] - mu[k*d+j] * r[k*d+j];
+				r[k*d+k] = s[k];
+
+				// Lovász condition, or swap with the previous vector
+				if (k == z || delta * r[(k-1)*d+(k-1)] <= s[k-1]) {
+					if (! lllFinite (r[k*d+k]) || ! (r[k*d+k] > zero))
+						throw LLLPrecisionFailure ();
+					++k;
+					continue;
+				}
+				swapVectors (k, k-1);
+				--k;
+			}
+			return z;
+		}
+	};
+
+} // LinBox
+
+#endif // __LINBOX_algorithms_lattice_lll_H
+
+// Local Variables:
+// mode: C++
+// tab-width: 4
+// indent-tabs-mode: nil
+// c-basic-offset: 4
+// End:
+// vim:sts=4:sw=4:ts=4:et:sr:cino=>s,f0,{0,g0,(0,\:0,t0,+0,=s
@@ -29,17 +29,15 @@
  * @ingroup algorithms
  * @ingroup lattice
  *
- * This is an interface to NTL/FPLLL.
+ * This is an interface to NTL/FPLLL, and to the LLL of LinBox
+ * (\ref LLLDomain) that works in place on the \c BlasMatrix.
  *
  * @todo Create a BlasMatrix<NTL_ZZ> that is just like a mat_ZZ !
  * @todo Create a BlasMatrix<FPLLL_ZZ> that is just like a IntMatrix !
  * @todo This will avoid copy back/forth a BlasMatrix<Givaro::ZRing<Integer> >
  */
 
-#if !defined(__LINBOX_HAVE_FPLLL) && !defined(__LINBOX_HAVE_NTL)
-#error "you need either FPLLL or NTL here"
-#endif
-
+#include "linbox/algorithms/lattice-lll.h"
 
 #ifdef __LINBOX_HAVE_NTL
 #include <NTL/LLL.h>
@@ -62,6 +60,69 @@ namespace LinBox
 	class latticeMethod {
 	public:
 		struct genericMethod {};
+
+		/*! LLL of LinBox.
+		 * L² with precision escalation, no conversion of the matrix.
+		 * The entries must be \c Integer.
+		 */
+		struct latticeNative : public virtual genericMethod {
+		private :
+			double        _delta ;
+			double        _eta ;
+			LLLPrecision  _prec ;
+			size_t        _segment ;
+			size_t        _grain ;
+		public :
+			latticeNative() :
+				_delta(0.99),
+				_eta(0.51),
+				_prec(LLLPrecision::Auto),
+				_segment(0),
+				_grain(64)
+			{}
+			void setDelta(const double & delta)
+			{
+				_delta = delta ;
+			}
+			void setEta(const double & eta)
+			{
+				_eta = eta ;
+			}
+			void setPrecision(LLLPrecision prec)
+			{
+				_prec = prec ;
+			}
+			//! rows per segment of the segmented reduction, 0 for none
+			void setSegment(size_t segment)
+			{
+				_segment = segment ;
+			}
+			//! smallest row length with parallel row operations
+			void setGrain(size_t grain)
+			{
+				_grain = grain ;
+			}
+			double getDelta() const
+			{
+				return _delta ;
+			}
+			double getEta() const
+			{
+				return _eta ;
+			}
+			LLLPrecision getPrecision() const
+			{
+				return _prec ;
+			}
+			size_t getSegment() const
+			{
+				return _segment ;
+			}
+			size_t getGrain() const
+			{
+				return _grain ;
+			}
+		};
 #ifdef __LINBOX_HAVE_NTL
 		/*! NTL_LLL.
 		 * This is NTL's LLL
@@ -265,10 +326,12 @@ namespace LinBox
 #include "linbox/algorithms/lattice.inl"
 
 
-#ifdef __LINBOX_HAVE_FPLLL
+#if defined(__LINBOX_HAVE_FPLLL)
 #define defaultLllMeth latticeMethod::latticeFPLLL
-#else
+#elif defined(__LINBOX_HAVE_NTL)
 #define defaultLllMeth latticeMethod::latticeNTL_LLL
+#else
+#define defaultLllMeth latticeMethod::latticeNative
 #endif
 
 namespace LinBox
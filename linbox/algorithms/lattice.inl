@@ -33,6 +33,24 @@
  * Implements the various wrappers
  */
 
+/*  LLL of LinBox */
+namespace LinBox
+{
+	template<class Ring, bool withU>
+	void
+	lllReduceInBase(BlasMatrix<Ring>                      & H,
+			BlasMatrix<Ring>                      & UU,
+			const latticeMethod::latticeNative    & meth)
+	{
+		LLLDomain<Ring> LLL(meth.getDelta(), meth.getEta(), meth.getPrecision(),
+				    meth.getSegment(), meth.getGrain());
+		if (withU)
+			LLL.reduceIn(H,UU);
+		else
+			LLL.reduceIn(H);
+	}
+}
+
 /*  Interface to NTL LLL */
 namespace LinBox
 {
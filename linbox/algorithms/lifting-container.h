@@ -31,10 +31,13 @@
 #ifndef __LINBOX_lifting_container_H
 #define __LINBOX_lifting_container_H
 
+#include <iterator>
+#include <sstream>
 #include <vector>
 
 #include "linbox/linbox-config.h"
 #include "linbox/util/debug.h"
+#include "linbox/util/instrumentation.h"
 
 #include "linbox/blackbox/apply.h"
 #include "linbox/blackbox/diagonal.h"
@@ -52,11 +55,25 @@
 #include "linbox/matrix/transpose-matrix.h"
 #include "linbox/blackbox/transpose.h"
 #include "linbox/solutions/hadamard-bound.h"
+#include "linbox/util/checkpoint.h"
+#include "linbox/util/commentator.h"
+#include "linbox/util/serialization-stream.h"
+#include "linbox/util/statistics.h"
 //#include "linbox/algorithms/vector-hom.h"
 
 namespace LinBox
 {
 
+	/** \brief Reads the prime of the lifting checkpoint at path.
+	 * @returns false if there is no such checkpoint.
+	 */
+	inline bool read_lifting_checkpoint_prime(Integer& prime, const std::string& path)
+	{
+		return read_checkpoint(path, CheckpointKind::Lifting, [&prime](std::istream& is) {
+			read_integer(prime, is);
+		});
+	}
+
 	template< class _Ring>
 	class LiftingContainer {
 	public:
@@ -88,7 +105,8 @@ namespace LinBox
 		typedef typename _Ring::Element   Integer_t;
 		typedef BlasVector<_Ring>      IVector;
 #ifdef RSTIMING
-		mutable Timer ttSetup, tRingApply, tRingOther, ttRingOther, ttRingApply;
+		mutable Timer ttSetup, ttRingOther, ttRingApply;
+		mutable Instrumentation::TracedTimer tRingApply{"lifting: ring apply"}, tRingOther{"lifting: ring other"};
 #endif
 
 	protected:
@@ -102,6 +120,9 @@ namespace LinBox
 		Integer_t                     _numbound;
 		Integer_t                     _denbound;
 		MatrixApplyDomain<Ring,IMatrix>    _MAD;
+		Checkpoint                  _checkpoint;
+		uint64_t                   _fingerprint = 0u;
+		Statistics*                 _statistics = nullptr;
 		//BlasApply<Ring>          _BA;
 
 
@@ -187,15 +208,182 @@ namespace LinBox
 
 		virtual IVector& nextdigit (IVector& , const IVector&) const = 0;
 
+		/** \brief Enables periodic checkpointing of the p-adic lifting.
+		 *
+		 * The iterator records the digits it computes and periodically appends
+		 * the new digits and the current residue to the checkpoint.
+		 * A new iterator resumes from the checkpoint if it was made with the same prime
+		 * and the same system: it first gives back the saved digits, then lifts from the saved residue.
+		 */
+		void setCheckpoint(const Checkpoint& checkpoint)
+		{
+			_checkpoint = checkpoint;
+			if (_checkpoint.enabled())
+				_fingerprint = fingerprint();
+		}
+
+		/** \brief Hash of the system, to recognize its checkpoints.
+		 *
+		 * A is seen through A v, for a fixed vector v of small entries,
+		 * which costs one product, whatever the storage of A.
+		 */
+		uint64_t fingerprint() const
+		{
+			IVector v(_intRing, _matA.coldim()), y(_intRing, _matA.rowdim()), z(_intRing, _matA.rowdim());
+			for (size_t j = 0; j < v.size(); ++j)
+				_intRing.init(v[j], int64_t((j * 40503u + 1u) % 251u));
+			_MAD.applyV(y, v, z);
+
+			std::ostringstream os;
+			Integer tmp;
+			for (const auto& x : y)
+				write_integer(os, _intRing.convert(tmp, x));
+			for (const auto& x : _b)
+				write_integer(os, _intRing.convert(tmp, x));
+
+			// FNV-1a
+			uint64_t hash = 14695981039346656037ull;
+			for (unsigned char c : os.str()) {
+				hash ^= c;
+				hash *= 1099511628211ull;
+			}
+			return hash;
+		}
+
+		/// Counts in statistics the digits the iterators compute, the ones of a checkpoint excluded.
+		void setStatistics(Statistics* statistics)
+		{
+			_statistics = statistics;
+		}
+
 		class const_iterator {
 		private:
 			BlasVector<Ring>              _res;
 			const LiftingContainerBase    &_lc;
 			size_t                   _position;
+			std::vector<IVector>        _saved; // digits of the checkpoint, to give back
+			size_t                     _replay; // next saved digit to give back
+			std::vector<IVector>      _pending; // digits computed since the last write
+			CheckpointClock             _clock;
+			bool                        _fresh; // the next write creates the file
+
+			/*  Checkpoint payload:
+			 *  prime, fingerprint of the system (varint), residue size n,
+			 *  then records, each one made of a number of digits k, the k digits
+			 *  (varint sizes, Integer values) and the n entries of the residue after them.
+			 */
+			void writeHeader(std::ostream& os) const
+			{
+				Integer tmp;
+				write_integer(os, _lc._intRing.convert(tmp, _lc._p));
+				write_varint(os, _lc._fingerprint);
+				write_varint(os, _res.size());
+			}
+
+			void writeRecord(std::ostream& os, const std::vector<IVector>& digits) const
+			{
+				Integer tmp;
+				write_varint(os, digits.size());
+				for (const auto& digit : digits) {
+					write_varint(os, digit.size());
+					for (const auto& x : digit)
+						write_integer(os, _lc._intRing.convert(tmp, x));
+				}
+				for (const auto& x : _res)
+					write_integer(os, _lc._intRing.convert(tmp, x));
+			}
+
+			void save()
+			{
+				if (_fresh) {
+					write_checkpoint(_lc._checkpoint.path, CheckpointKind::Lifting, [this](std::ostream& os) {
+						writeHeader(os);
+						writeRecord(os, _pending);
+					});
+					_fresh = false;
+				}
+				else {
+					append_checkpoint(_lc._checkpoint.path, [this](std::ostream& os) {
+						writeRecord(os, _pending);
+					});
+				}
+				_pending.clear();
+				_clock.reset();
+			}
+
+			void load()
+			{
+				Integer prime, expected, tmp;
+				_lc._intRing.convert(expected, _lc._p);
+				uint64_t fingerprint = 0u;
+				std::vector<Integer> res;
+				std::vector<IVector> digits;
+				bool truncated = false;
+				size_t records = 0u;
+
+				bool found = read_checkpoint(_lc._checkpoint.path, CheckpointKind::Lifting, [&](std::istream& is) {
+					read_integer(prime, is);
+					fingerprint = read_varint(is);
+					res.resize(read_varint(is));
+					if (prime != expected || fingerprint != _lc._fingerprint || res.size() != _res.size())
+						return;
+
+					while (is.peek() != std::char_traits<char>::eof()) {
+						std::vector<IVector> record;
+						std::vector<Integer> recordRes(res.size());
+						try {
+							uint64_t k = read_varint(is);
+							for (uint64_t d = 0u; d < k; ++d) {
+								record.emplace_back(_lc._intRing, read_varint(is));
+								for (auto& x : record.back()) {
+									read_integer(tmp, is);
+									_lc._intRing.init(x, tmp);
+								}
+							}
+							for (auto& x : recordRes)
+								read_integer(x, is);
+						}
+						catch (const LinboxError&) {
+							truncated = true;
+							break;
+						}
+						std::move(record.begin(), record.end(), std::back_inserter(digits));
+						res = std::move(recordRes);
+						++records;
+					}
+				});
+				if (! found) return;
+
+				if (prime != expected || fingerprint != _lc._fingerprint || res.size() != _res.size()) {
+					commentator().report(Commentator::LEVEL_IMPORTANT, INTERNAL_WARNING)
+						<< "Lifting checkpoint was made with another prime or system, starting over." << std::endl;
+					return;
+				}
+				if (records == 0u) return;
+
+				for (size_t i = 0; i < res.size(); ++i)
+					_lc._intRing.init(_res[i], res[i]);
+				_saved = std::move(digits);
+				_fresh = false;
+
+				// Drop the record truncated by a crash, so that the next ones can be appended.
+				if (truncated) {
+					write_checkpoint(_lc._checkpoint.path, CheckpointKind::Lifting, [this](std::ostream& os) {
+						writeHeader(os);
+						writeRecord(os, _saved);
+					});
+				}
+				commentator().report(Commentator::LEVEL_IMPORTANT, INTERNAL_DESCRIPTION)
+					<< "Resumed lifting from checkpoint with " << _saved.size() << " digits" << std::endl;
+			}
+
 		public:
 			const_iterator(const LiftingContainerBase& lc,size_t end=0) :
-				_res(lc._b), _lc(lc), _position(end)
-			{}
+				_res(lc._b), _lc(lc), _position(end), _replay(0), _clock(lc._checkpoint.interval), _fresh(true)
+			{
+				if (end == 0 && _lc._checkpoint.enabled() && _lc._checkpoint.resume)
+					load();
+			}
 
 			/**
 			 * @returns False if the next digit cannot be computed
@@ -207,59 +395,82 @@ namespace LinBox
 #ifdef DEBUG_LC
 				linbox_check (digit.size() == _lc._matA.coldim());
 #endif
+				// give back the digits of the checkpoint first
+				if (_replay < _saved.size()) {
+					digit = _saved[_replay++];
+					++_position;
+					if (_replay == _saved.size()) {
+						std::vector<IVector>().swap(_saved);
+						_replay = 0;
+					}
+					return true;
+				}
+
+				Instrumentation::Scope scope("lifting: digit");
+				scope.counter(0, (int64_t)_position);
+
 				// compute next p-adic digit
 				_lc.nextdigit(digit,_res);
+				{
+					Instrumentation::Scope update("lifting: residue update");
 #ifdef RSTIMING
-				_lc.tRingApply.start();
+					_lc.tRingApply.start();
 #endif
 
 #ifdef DEBUG_LC
-				std::cout<<"\n residu "<<_position<<": ";
-				for (size_t i=0;i<_res.size();++i)
-					std::cout<<_res[i]<<",";
-				std::cout<<"\n digit "<<_position<<": ";
-				for (size_t i=0;i<digit.size();++i)
-					std::cout<<digit[i]<<",";
-				std::cout<<"\n";
+					std::cout<<"\n residu "<<_position<<": ";
+					for (size_t i=0;i<_res.size();++i)
+						std::cout<<_res[i]<<",";
+					std::cout<<"\n digit "<<_position<<": ";
+					for (size_t i=0;i<digit.size();++i)
+						std::cout<<digit[i]<<",";
+					std::cout<<"\n";
 #endif
-				/*  prepare for updating residu */
+					/*  prepare for updating residu */
 
-				// compute v2 = _matA * digit
-				IVector v2 (_lc.ring(),_lc._matA.rowdim());
-				_lc._MAD.applyV(v2,digit, _res);
+					// compute v2 = _matA * digit
+					IVector v2 (_lc.ring(),_lc._matA.rowdim());
+					_lc._MAD.applyV(v2,digit, _res);
 
 #ifdef DEBUG_LC
 
-				//_matA.write(std::cout<<"\n _matA :\n");
-				std::cout<<"\n A * digit "<<_position<<": ";
-				for (size_t i=0;i<v2.size();++i)
-					std::cout<<v2[i]<<",";
+					//_matA.write(std::cout<<"\n _matA :\n");
+					std::cout<<"\n A * digit "<<_position<<": ";
+					for (size_t i=0;i<v2.size();++i)
+						std::cout<<v2[i]<<",";
 
 #endif
 #ifdef RSTIMING
-				_lc.tRingApply.stop();
-				_lc.ttRingApply += _lc.tRingApply;
-				_lc.tRingOther.start();
+					_lc.tRingApply.stop();
+					_lc.ttRingApply += _lc.tRingApply;
+					_lc.tRingOther.start();
 #endif
 
-				// update _res -= v2
-				_lc._VDR.subin (_res, v2);
-				typename BlasVector<Ring>::iterator p0;
-				// update _res = _res / p
-				int index=0;
-				for ( p0 = _res.begin(); p0 != _res.end(); ++ p0, ++index){
+					// update _res -= v2
+					_lc._VDR.subin (_res, v2);
+					typename BlasVector<Ring>::iterator p0;
+					// update _res = _res / p
+					int index=0;
+					for ( p0 = _res.begin(); p0 != _res.end(); ++ p0, ++index){
 #ifdef LC_CHECK_DIVISION
-					if (! _lc._intRing.isDivisor(*p0,_lc._p)) {
-						std::cout<<"residue "<<*p0<<" not divisible by modulus "<<_lc._p<<std::endl;
-						std::cout<<"residue "<<*p0<<" not divisible by modulus "<<_lc._p<<std::endl;
-						return false;
-					}
+						if (! _lc._intRing.isDivisor(*p0,_lc._p)) {
+							std::cout<<"residue "<<*p0<<" not divisible by modulus "<<_lc._p<<std::endl;
+							std::cout<<"residue "<<*p0<<" not divisible by modulus "<<_lc._p<<std::endl;
+							return false;
+						}
 #endif
-					_lc._intRing.divin(*p0, _lc._p);
+						_lc._intRing.divin(*p0, _lc._p);
+					}
 				}
 
 				// increase position of the iterator
 				++_position;
+				if (_lc._statistics != nullptr) ++_lc._statistics->digits;
+
+				if (_lc._checkpoint.enabled()) {
+					_pending.push_back(digit);
+					if (_clock.due()) save();
+				}
 #ifdef RSTIMING
 				_lc.tRingOther.stop();
 				_lc.ttRingOther += _lc.tRingOther;
@@ -397,7 +608,8 @@ namespace LinBox
 
 	public:
 #ifdef RSTIMING
-		mutable Timer tGetDigit, ttGetDigit, tGetDigitConvert, ttGetDigitConvert;
+		mutable Timer ttGetDigit, ttGetDigitConvert;
+		mutable Instrumentation::TracedTimer tGetDigit{"dixon: get digit"}, tGetDigitConvert{"dixon: get digit convert"};
 #endif
 
 		template <class Prime_Type, class VectorIn>
@@ -530,7 +742,8 @@ namespace LinBox
 		typename Field::RandIter      _rand;
 #ifdef RSTIMING
 	public:
-		mutable Timer tGetDigit, ttGetDigit, tGetDigitConvert, ttGetDigitConvert;
+		mutable Timer ttGetDigit, ttGetDigitConvert;
+		mutable Instrumentation::TracedTimer tGetDigit{"wiedemann: get digit"}, tGetDigitConvert{"wiedemann: get digit convert"};
 #endif
 	public:
 
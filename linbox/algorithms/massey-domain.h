@@ -48,6 +48,7 @@
 // =======================================================================
 
 #include "linbox/solutions/methods.h"
+#include "linbox/algorithms/massey-recursive.h"
 #include "linbox/util/commentator.h"
 #include "linbox/vector/reverse.h"
 #include "linbox/vector/subvector.h"
@@ -63,6 +64,17 @@ namespace LinBox
 
 #ifndef DEFAULT_ADDITIONAL_ITERATION
 #define DEFAULT_ADDITIONAL_ITERATION 2
+#endif
+
+// After LINBOX_MASSEY_FAST_THRESHOLD terms, the steps continue with the recursive Berlekamp/Massey
+#ifndef LINBOX_MASSEY_FAST_THRESHOLD
+#define LINBOX_MASSEY_FAST_THRESHOLD 32768
+#endif
+
+// The recursive Berlekamp/Massey reads the next terms by segments of
+// 1/LINBOX_MASSEY_FAST_SEGMENT_RATIO of the terms already read
+#ifndef LINBOX_MASSEY_FAST_SEGMENT_RATIO
+#define LINBOX_MASSEY_FAST_SEGMENT_RATIO 4
 #endif
 
 	const long _DEGINFTY_ = -1;
@@ -76,6 +88,12 @@ namespace LinBox
 	  2 additional iterations are needed to compute it
 	  (parameter DEFAULT_ADDITIONAL_ITERATION), but those
 	  iterations are not needed for the rank
+	  - After fastThreshold() terms, the steps continue with the
+	  sub-quadratic \ref Protected::RecursiveMassey, with the same result.
+	  Up to the threshold, early termination is checked at each term.
+	  After it, the sequence is read by segments, so that with early
+	  termination up to 1/LINBOX_MASSEY_FAST_SEGMENT_RATIO more terms
+	  than needed may be read.
 	  */
 	template<class Field, class Sequence>
 	class MasseyDomain {
@@ -84,6 +102,9 @@ namespace LinBox
 		const Field                *_field;
 		VectorDomain<Field>  _VD;
 		size_t         EARLY_TERM_THRESHOLD;
+		size_t         _fastThreshold = LINBOX_MASSEY_FAST_THRESHOLD;
+		size_t         _sequenceLength = 0;
+		size_t         _earlyTerminationStep = 0;
 
 #ifdef INCLUDE_TIMING
 		// Timings
@@ -139,6 +160,15 @@ namespace LinBox
 		const Field &getField    () const { return *_field; } // deprecated
 		Sequence    *getSequence () const { return _container; }
 
+		/// Number of terms after which the recursive Berlekamp/Massey takes over.
+		size_t fastThreshold () const { return _fastThreshold; }
+		void setFastThreshold (size_t t) { _fastThreshold = t; }
+
+		/// Terms of the sequence read by the last run.
+		size_t sequenceLength () const { return _sequenceLength; }
+		/// Term at which the last run terminated early, 0 if it did not.
+		size_t earlyTerminationStep () const { return _earlyTerminationStep; }
+
 #ifdef INCLUDE_TIMING
 		double       discrepencyTime () const { return _discrepencyTime; }
 		double       fixTime         () const { return _fixTime; }
@@ -203,7 +233,10 @@ namespace LinBox
 			//              const long ni = _container->n_row (), nj = _container->n_col ();
 			//              const long n = MIN(ni,nj);
 			const long END = _container->size () + (full_poly ? DEFAULT_ADDITIONAL_ITERATION:0);
-			const long n = END >> 1;
+			// The classic steps go up to the fast threshold, checking the early
+			// termination at each term; the recursive steps take over from there.
+			const long N0 = (END > (long)_fastThreshold) ? (long)_fastThreshold : END;
+			const long n = N0 >> 1;
 
 #ifdef INCLUDE_TIMING
 			Timer timer;
@@ -219,7 +252,7 @@ namespace LinBox
 			// Sequence and iterator initialization
 			//
 			typename Sequence::const_iterator _iter (_container->begin ());
-			Polynomial S (field(),(size_t)END + 1);
+			Polynomial S (field(),(size_t)N0 + 1);
 
 			// -----------------------------------------------
 			// Preallocation. No further allocation.
@@ -240,7 +273,8 @@ namespace LinBox
 			field().assign (b, field().one);
 
 
-			for (long NN = 0; NN < END && x < (long) EARLY_TERM_THRESHOLD; ++NN, ++_iter) {
+			long NN = 0;
+			for (; NN < N0 && x < (long) EARLY_TERM_THRESHOLD; ++NN, ++_iter) {
 
 				if (!(NN % COMMOD))
 					commentator().progress (NN);
@@ -346,11 +380,64 @@ namespace LinBox
 #endif // INCLUDE_TIMING
 			}
 
+			_sequenceLength = (size_t)NN;
+			_earlyTerminationStep = (x >= (long) EARLY_TERM_THRESHOLD) ? (size_t)NN : 0;
+
 			commentator().stop ("done", NULL, "masseyd");
 			//		commentator().stop ("Done", "Done", "LinBox::MasseyDomain::massey");
+
+			if ( (NN < END) && (x < (long) EARLY_TERM_THRESHOLD) )
+				return recursive_massey (C, END, S, NN, B, b_deg, b, L, x, _iter);
+
 			return L;
 		}
 
+		// -------------------------------------------------------------------
+		// Sub-quadratic Berlekamp/Massey on segments of the sequence
+		// -------------------------------------------------------------------
+
+		template<class Polynomial, class Iterator>
+		long recursive_massey (Polynomial &C, const long END,
+				       const Polynomial &S0, const long N0,
+				       const Polynomial &B, const long b_deg, const Element &b,
+				       const long L, const long x, Iterator &_iter)
+		{
+			commentator().start ("Recursive Massey", "masseyd", (unsigned int)END);
+
+			// State of the classic steps after the first N0 terms,
+			// with the previous polynomial shifted and normalized: x^x B / b
+			Protected::RecursiveMassey<Field> RM (field(), EARLY_TERM_THRESHOLD);
+			RM.C.assign (C.begin (), C.end ());
+			RM.Bx.assign ((size_t)x, field().zero);
+			Element ib, t; field().init (ib); field().init (t);
+			field().inv (ib, b);
+			for (long i = 0; i <= b_deg; ++i)
+				RM.Bx.push_back (field().mul (t, B[(size_t)i], ib));
+			RM.L = L;
+			RM.x = x;
+			RM.NN = (size_t)N0;
+
+			std::vector<Element> S (S0.begin (), S0.begin () + N0);
+			size_t N1 = (size_t)N0;
+			do {
+				N1 = MIN ((size_t)END, N1 + N1 / LINBOX_MASSEY_FAST_SEGMENT_RATIO + 1);
+				S.reserve (N1);
+				for (; S.size () < N1; ++_iter)
+					S.push_back (*_iter);
+				commentator().progress ((long)N1);
+			} while ( RM.advance (S, N1) && (N1 < (size_t)END) );
+
+			_sequenceLength = S.size ();
+			_earlyTerminationStep = RM.terminated () ? S.size () : 0;
+
+			C.resize (RM.C.size ());
+			for (size_t i = 0; i < RM.C.size (); ++i)
+				field().assign (C[i], RM.C[i]);
+
+			commentator().stop ("done", NULL, "masseyd");
+			return RM.L;
+		}
+
 	public:
 		// ---------------------------------------------
 		// Massey
@@ -0,0 +1,338 @@
+/* linbox/algorithms/massey-recursive.h
+ * Copyright (C) 2026 The LinBox group
+ *
+ * ========LICENCE========
+ * This file is part of the library LinBox.
+ *
+  * LinBox is free software: you can redistribute it and/or modify
+ * it under the terms of the  GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.	 See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ * ========LICENCE========
+ */
+
+/*! @file algorithms/massey-recursive.h
+ * @ingroup algorithms
+ * @brief Sub-quadratic Berlekamp/Massey, by divide and conquer.
+ *
+ * A step of Berlekamp/Massey is linear in the pair \f$(C, B)\f$ of the
+ * current connection polynomial and of the (shifted, normalized) previous one:
+ * k steps are a 2x2 polynomial matrix of degree at most k.
+ * This matrix only depends on k coefficients of the residuals \f$C S\f$
+ * and \f$B S\f$: the first half of the steps is computed recursively,
+ * the residuals of the second half are obtained by a middle product,
+ * as in the half-gcd.
+ * With Karatsuba products, n steps cost \f$O(n^{\log_2 3} \log n)\f$.
+ *
+ * The steps are exactly those of \ref MasseyDomain, including its early
+ * termination: the result is the same connection polynomial.
+ */
+
+#ifndef __LINBOX_massey_recursive_H
+#define __LINBOX_massey_recursive_H
+
+#include <algorithm>
+#include <vector>
+
+#ifndef LINBOX_MASSEY_RECURSIVE_BASE
+// Number of steps done iteratively at the leaves of the recursion
+#define LINBOX_MASSEY_RECURSIVE_BASE 32
+#endif
+
+#ifndef LINBOX_MASSEY_KARATSUBA_THRESHOLD
+// Smallest operand length multiplied by Karatsuba's algorithm
+#define LINBOX_MASSEY_KARATSUBA_THRESHOLD 32
+#endif
+
+namespace LinBox
+{
+	namespace Protected {
+
+		/** \brief Berlekamp/Massey steps, by divide and conquer.
+		 *
+		 * The state is the connection polynomial \f$C\f$, the
+		 * shifted and normalized previous one \f$B_x = x^x B / b\f$,
+		 * the linear complexity \f$L\f$ and the number \f$x\f$ of steps
+		 * since the last change of \f$L\f$.
+		 * A step with discrepancy d is then:
+		 * - d = 0: \f$B_x \gets x B_x\f$;
+		 * - 2L > N: \f$C \gets C - d B_x\f$, \f$B_x \gets x B_x\f$;
+		 * - otherwise: \f$(C, B_x) \gets (C - d B_x, x C / d)\f$, \f$L \gets N+1-L\f$.
+		 */
+		template<class Field>
+		class RecursiveMassey {
+		public:
+			typedef typename Field::Element Element;
+			typedef std::vector<Element> Polynomial;
+
+			/// 2x2 matrix of polynomials, acting on \f$(C, B_x)\f$.
+			struct Matrix {
+				Polynomial m[2][2];
+			};
+
+			/// Connection polynomial, low degree first.
+			Polynomial C;
+			/// Shifted and normalized previous connection polynomial.
+			Polynomial Bx;
+			/// Linear complexity.
+			long L;
+			/// Steps since the last change of L, plus one.
+			long x;
+			/// Number of steps done.
+			size_t NN;
+
+			RecursiveMassey (const Field& F, size_t ett) :
+				L(0), x(1), NN(0), _field(&F), _ett((long)ett)
+			{
+				C.assign(1, F.one);
+				Bx.assign(2, F.zero);
+				F.assign(Bx[1], F.one);
+			}
+
+			const Field& field () const { return *_field; }
+
+			/// Whether the early termination criterion is met.
+			bool terminated () const { return x >= _ett; }
+
+			/** Steps NN to N1-1, on the sequence S of size at least N1.
+			 * @return false if the early termination occured.
+			 */
+			bool advance (const Polynomial& S, size_t N1)
+			{
+				if ( terminated () ) return false;
+				if ( N1 <= NN) return true;
+
+				const size_t k(N1 - NN);
+				Polynomial eC, eB;
+				residual(eC, C, S, N1);
+				residual(eB, Bx, S, N1);
+
+				Matrix M;
+				recurse(M, eC.data(), eB.data(), k);
+
+				Polynomial nC, nB, t;
+				mul(nC, M.m[0][0], C); mul(t, M.m[0][1], Bx); addin(nC, t);
+				mul(nB, M.m[1][0], C); mul(t, M.m[1][1], Bx); addin(nB, t);
+				trim(nC); trim(nB);
+				C.swap(nC); Bx.swap(nB);
+
+				return ! terminated ();
+			}
+
+		protected:
+			const Field* _field;
+			long _ett;
+
+			void trim (Polynomial& p) const
+			{
+				size_t s(p.size());
+				while ( s && field().isZero(p[s-1]) ) --s;
+				p.resize(s);
+			}
+
+			// p <- p + q
+			void addin (Polynomial& p, const Polynomial& q) const
+			{
+				if (p.size() < q.size()) p.resize(q.size(), field().zero);
+				for (size_t i=0; i<q.size(); ++i) field().addin(p[i], q[i]);
+			}
+
+			// r[0..na+nb-1) += a b, schoolbook
+			void mulacc_naive (Element* r, const Element* a, size_t na, const Element* b, size_t nb) const
+			{
+				for (size_t i=0; i<na; ++i)
+					if (! field().isZero(a[i]))
+						for (size_t j=0; j<nb; ++j)
+							field().axpyin(r[i+j], a[i], b[j]);
+			}
+
+			// r[0..na+nb-1) += a b
+			void mulacc (Element* r, const Element* a, size_t na, const Element* b, size_t nb) const
+			{
+				if (na < nb) { std::swap(a, b); std::swap(na, nb); }
+				if (nb < LINBOX_MASSEY_KARATSUBA_THRESHOLD) {
+					mulacc_naive(r, a, na, b, nb);
+					return;
+				}
+				if (na > nb) {
+					// slices of a of the size of b
+					for (size_t i=0; i<na; i+=nb)
+						mulacc(r+i, a+i, std::min(nb, na-i), b, nb);
+					return;
+				}
+				// Karatsuba, na == nb
+				const size_t h(na >> 1), l(na - h);
+				Polynomial sa(a+h, a+na), sb(b+h, b+nb);
+				for (size_t i=0; i<h; ++i) {
+					field().addin(sa[i], a[i]);
+					field().addin(sb[i], b[i]);
+				}
+				Polynomial z0(2*h-1, field().zero), z1(2*l-1, field().zero), z2(2*l-1, field().zero);
+				mulacc(z0.data(), a, h, b, h);
+				mulacc(z2.data(), a+h, l, b+h, l);
+				mulacc(z1.data(), sa.data(), l, sb.data(), l);
+				for (size_t i=0; i<z0.size(); ++i) {
+					field().subin(z1[i], z0[i]);
+					field().addin(r[i], z0[i]);
+				}
+				for (size_t i=0; i<z2.size(); ++i) {
+					field().subin(z1[i], z2[i]);
+					field().addin(r[i+2*h], z2[i]);
+				}
+				for (size_t i=0; i<z1.size(); ++i)
+					field().addin(r[i+h], z1[i]);
+			}
+
+			void mul (Polynomial& r, const Polynomial& a, const Polynomial& b) const
+			{
+				if (a.empty() || b.empty()) { r.resize(0); return; }
+				r.assign(a.size()+b.size()-1, field().zero);
+				mulacc(r.data(), a.data(), a.size(), b.data(), b.size());
+			}
+
+			// e[j] = coefficient NN+j of p S, for NN+j < N1
+			void residual (Polynomial& e, const Polynomial& p, const Polynomial& S, size_t N1) const
+			{
+				const size_t k(N1 - NN);
+				e.assign(k, field().zero);
+				// only the coefficients NN-deg(p) .. N1-1 of S contribute
+				const size_t lo( (NN >= p.size()) ? NN - p.size() + 1 : 0 );
+				Polynomial r;
+				Polynomial s(S.begin()+(long)lo, S.begin()+(long)N1);
+				mul(r, p, s);
+				for (size_t j=0; j<k; ++j)
+					if (NN+j-lo < r.size()) e[j] = r[NN+j-lo];
+			}
+
+			// p <- x p
+			void shift (Polynomial& p) const
+			{
+				p.insert(p.begin(), field().zero);
+			}
+
+			/* k steps, with residuals eC and eB of C S and Bx S from step NN.
+			 * M is the matrix of the steps done, which are fewer than k
+			 * in case of early termination.
+			 */
+			size_t recurse (Matrix& M, const Element* eC, const Element* eB, size_t k)
+			{
+				if (k <= LINBOX_MASSEY_RECURSIVE_BASE)
+					return leaf(M, eC, eB, k);
+
+				const size_t k1(k >> 1), k2(k - k1);
+				Matrix M1;
+				const size_t n1 = recurse(M1, eC, eB, k1);
+				if (n1 < k1) {
+					M = M1;
+					return n1;
+				}
+
+				// residuals of the second half: coefficients k1..k-1 of M1 (eC, eB)
+				Polynomial E[2];
+				const Polynomial vC(eC, eC+k), vB(eB, eB+k);
+				for (size_t i=0; i<2; ++i) {
+					Polynomial r, t;
+					mul(r, M1.m[i][0], vC);
+					mul(t, M1.m[i][1], vB);
+					addin(r, t);
+					r.resize(k, field().zero);
+					E[i].assign(r.begin()+(long)k1, r.begin()+(long)k);
+				}
+
+				Matrix M2;
+				const size_t n2 = recurse(M2, E[0].data(), E[1].data(), k2);
+
+				// M <- M2 M1
+				for (size_t i=0; i<2; ++i)
+					for (size_t j=0; j<2; ++j) {
+						Polynomial t;
+						mul(M.m[i][j], M2.m[i][0], M1.m[0][j]);
+						mul(t, M2.m[i][1], M1.m[1][j]);
+						addin(M.m[i][j], t);
+						trim(M.m[i][j]);
+					}
+				return k1 + n2;
+			}
+
+			// k steps, iteratively, updating the residuals along
+			size_t leaf (Matrix& M, const Element* eC, const Element* eB, size_t k)
+			{
+				for (size_t i=0; i<2; ++i)
+					for (size_t j=0; j<2; ++j)
+						M.m[i][j].assign( (i==j)?1:0, field().one );
+				Polynomial rC(eC, eC+k), rB(eB, eB+k);
+
+				for (size_t i=0; i<k; ++i, ++NN) {
+					if (terminated ()) return i;
+
+					const Element d(rC[i]);
+					if (field().isZero(d)) {
+						++x;
+					}
+					else {
+						Element md; field().neg(md, d);
+						const bool lengthChange( ! (L > long(NN >> 1)) );
+						Polynomial T0, T1, Ti;
+						if (lengthChange) {
+							T0 = M.m[0][0]; T1 = M.m[0][1];
+							Ti.assign(rC.begin()+(long)i, rC.end());
+						}
+						// C <- C - d Bx
+						axpyin(M.m[0][0], md, M.m[1][0]);
+						axpyin(M.m[0][1], md, M.m[1][1]);
+						for (size_t j=i+1; j<k; ++j) field().axpyin(rC[j], md, rB[j]);
+
+						if (lengthChange) {
+							// Bx <- C / d, shifted below
+							Element id; field().inv(id, d);
+							scal(T0, id); scal(T1, id);
+							M.m[1][0].swap(T0); M.m[1][1].swap(T1);
+							for (size_t j=i; j<k; ++j) field().mul(rB[j], Ti[j-i], id);
+							L = (long)NN+1-L;
+							x = 1;
+						}
+						else
+							++x;
+					}
+					// Bx <- x Bx
+					shift(M.m[1][0]); shift(M.m[1][1]);
+					for (size_t j=k-1; j>i; --j) rB[j] = rB[j-1];
+				}
+				return k;
+			}
+
+			// p <- p + a q
+			void axpyin (Polynomial& p, const Element& a, const Polynomial& q) const
+			{
+				if (p.size() < q.size()) p.resize(q.size(), field().zero);
+				for (size_t i=0; i<q.size(); ++i) field().axpyin(p[i], a, q[i]);
+			}
+
+			void scal (Polynomial& p, const Element& a) const
+			{
+				for (auto& c : p) field().mulin(c, a);
+			}
+		};
+
+	} // Protected
+
+} // LinBox
+
+#endif // __LINBOX_massey_recursive_H
+
+// Local Variables:
+// mode: C++
+// tab-width: 4
+// indent-tabs-mode: nil
+// c-basic-offset: 4
+// End:
+// vim:sts=4:sw=4:ts=4:et:sr:cino=>s,f0,{0,g0,(0,\:0,t0,+0,=s
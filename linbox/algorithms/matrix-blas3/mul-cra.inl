@@ -30,6 +30,7 @@
 
 #include "givaro/random-integer.h"
 #include "linbox/randiter/random-prime.h"
+#include "linbox/util/instrumentation.h"
 
 
 namespace LinBox { namespace BLAS3 { namespace Protected {
@@ -42,35 +43,17 @@ namespace LinBox { namespace BLAS3 { namespace Protected {
 		typedef BlasMatrix<Field>   ModularMatrix ;
 		typedef BlasMatrix<Givaro::ZRing<Integer> > IntegerMatrix ;
 
-#ifdef _LB_MM_TIMING
-#ifdef __LINBOX_USE_OPENMP
-		typedef LinBox::OMPTimer Mytime;
-#else
-		typedef LinBox::Timer    Mytime;
-#endif
-#endif
-
 		const IntegerMatrix &_A_, &_B_;
 
-#ifdef _LB_MM_TIMING
-		mutable Mytime chrono;
-#endif
-
 		IntegerCraMatMul(const IntegerMatrix& A, const IntegerMatrix& B) :
 			_A_(A), _B_(B)
 		{
-#ifdef _LB_MM_TIMING
-			chrono.clear();
-#endif
 			linbox_check(A.getPointer() == _A_.getPointer());
 		}
 
 		IntegerCraMatMul(IntegerMatrix& A, IntegerMatrix& B) :
 			_A_(A), _B_(B)
 		{
-#ifdef _LB_MM_TIMING
-			chrono.clear();
-#endif
 			linbox_check(A.getPointer() == _A_.getPointer());
 		}
 
@@ -87,9 +70,8 @@ namespace LinBox { namespace BLAS3 { namespace Protected {
 
 			/*  multiplication mod p */
 
-#ifdef _LB_MM_TIMING
-			Mytime matmul; matmul.clear(); matmul.start();
-#endif
+			// the modular products are traced (see linbox/util/instrumentation.h)
+			Instrumentation::Scope scope("mul-cra: modular product");
 			BMD.mul(Cp,Ap,Bp);
 			// BMD.axpyin(Cp,Ap,Bp);
 #if 0
@@ -101,10 +83,6 @@ namespace LinBox { namespace BLAS3 { namespace Protected {
 			else if (FAM_TYPE == _maxpy)
 				BMD.maxpyin(Cp,Ap,Bp);
 #endif
-#ifdef _LB_MM_TIMING
-			matmul.stop();
-			this->chrono+=matmul;
-#endif
 #if 0
 			if (Ap.rowdim() <= 20 && Ap.coldim() <= 20) {
 				Integer chara;
@@ -153,10 +131,6 @@ namespace LinBox { namespace BLAS3 {
 			cra(C, iteration, genprime);
 
 #ifdef _LB_DEBUG
-#ifdef _LB_MM_TIMING
-			std::cout << "Sole modular matrix multiplications: " << iteration.chrono << std::endl;
-#endif
-
 			Integer mC; BMD.Magnitude(mC, C);
 			std::cout << "C max: " << logtwo(mC) <<  " (" << LinBox::naturallog(mC) << ')' << std::endl;
 #endif
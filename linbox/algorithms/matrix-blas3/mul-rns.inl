@@ -0,0 +1,98 @@
+/*  Copyright (C) 2014 the members of the LinBox group
+ *
+ * This file is part of the LinBox library.
+ *
+ * ========LICENCE========
+ * LinBox is free software: you can redistribute it and/or modify
+ * it under the terms of the  GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * LinBox is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ * ========LICENCE========
+ *
+ */
+
+#ifndef __LINBOX_matrix_blas3_mul_rns_INL
+#define __LINBOX_matrix_blas3_mul_rns_INL
+
+#include <set>
+#include <utility>
+#include "linbox/field/field-traits.h"
+#include "linbox/randiter/random-prime.h"
+#include "linbox/util/error.h"
+#include "fflas-ffpack/fflas/fflas.h"
+
+namespace LinBox { namespace BLAS3 {
+
+	inline MultiModDouble rnsBasis (const integer& bound, size_t k)
+	{
+		typedef Givaro::Modular<double> ModularField ;
+		PrimeIterator<IteratorCategories::HeuristicTag> genprime(FieldTraits<ModularField>::bestBitSize(k));
+		std::set<integer> seen;
+		std::vector<double> primes;
+		integer M(1);
+		while (M <= 2*bound) {
+			integer p = *genprime;
+			++genprime;
+			if (! seen.insert(p).second) continue;
+			primes.push_back((double)p);
+			M *= p;
+		}
+		return MultiModDouble(primes);
+	}
+
+	inline BlasMatrix<MultiModDouble> &
+	mul (BlasMatrix<MultiModDouble>& C,
+	     const BlasMatrix<MultiModDouble>& A,
+	     const BlasMatrix<MultiModDouble>& B,
+	     const mulMethod::RNS & )
+	{
+		linbox_check(A.coldim() == B.rowdim());
+		if (! A.sameBasis(B))
+			throw LinboxError("BLAS3::mul: the RNS operands have different moduli");
+		const size_t m = A.rowdim(), k = A.coldim(), n = B.coldim();
+		const integer mC = A.magnitude()*B.magnitude()*uint64_t(k);
+
+		// resizing C would wipe an operand
+		if (&C == &A || &C == &B) {
+			BlasMatrix<MultiModDouble> T(A.field(), m, n);
+			mul(T, A, B, mulMethod::RNS());
+			C = std::move(T);
+			return C;
+		}
+		// C gets the moduli of the operands
+		if (C.sameBasis(A))
+			C.resize(m, n);
+		else
+			C = BlasMatrix<MultiModDouble>(A.field(), m, n);
+		C.setMagnitude(mC);
+		if (m == 0 || n == 0) return C;
+
+		const long s = (long) A.size();
+#pragma omp parallel for schedule(dynamic)
+		for (long l = 0; l < s; ++l)
+			FFLAS::fgemm(A.residueField(l), FFLAS::FflasNoTrans, FFLAS::FflasNoTrans, m, n, k,
+				     1., A.getPointer(l), k, B.getPointer(l), n, 0., C.getPointer(l), n);
+		return C;
+	}
+
+} // BLAS3
+} // LinBox
+
+#endif // __LINBOX_matrix_blas3_mul_rns_INL
+
+// Local Variables:
+// mode: C++
+// tab-width: 4
+// indent-tabs-mode: nil
+// c-basic-offset: 4
+// End:
+// vim:sts=4:sw=4:ts=4:et:sr:cino=>s,f0,{0,g0,(0,\:0,t0,+0,=s
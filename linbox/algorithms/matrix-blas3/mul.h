@@ -59,6 +59,8 @@ namespace LinBox {
 			struct FLINT {};
 
 			struct CRA {} ;
+			//! products of integer matrices kept in RNS (BlasMatrix<MultiModDouble>)
+			struct RNS {} ;
 		}
 	}
 }
@@ -191,6 +193,31 @@ namespace LinBox {
 }
 #include "linbox/algorithms/matrix-blas3/mul-cra.inl"
 
+// RNS
+#include "linbox/matrix/densematrix/blas-matrix-multimod.h"
+namespace LinBox {
+	namespace BLAS3 {
+		/** RNS basis for integer matrix products.
+		 * Distinct primes small enough for products of inner dimension \p k,
+		 * whose product is more than twice \p bound.
+		 */
+		inline MultiModDouble rnsBasis (const integer& bound, size_t k);
+
+		/** Product of RNS matrices, prime by prime.
+		 * \p A and \p B must have the same primes.  \p C takes them, it may
+		 * be \p A or \p B.  The basis must be large enough for the
+		 * magnitude \f$ k\|A\|\|B\| \f$ of the result.  \c LinboxError is
+		 * thrown otherwise.
+		 */
+		inline BlasMatrix<MultiModDouble> &
+		mul (BlasMatrix<MultiModDouble>& C,
+		     const BlasMatrix<MultiModDouble>& A,
+		     const BlasMatrix<MultiModDouble>& B,
+		     const mulMethod::RNS & );
+	}
+}
+#include "linbox/algorithms/matrix-blas3/mul-rns.inl"
+
 // <+other algo+>
 namespace LinBox {
 	namespace BLAS3 {
@@ -0,0 +1,414 @@
+/* linbox/algorithms/multi-prime-valence.h
+ * Copyright (C) 2026 The LinBox group
+ *
+ * ========LICENCE========
+ * This file is part of the library LinBox.
+ *
+  * LinBox is free software: you can redistribute it and/or modify
+ * it under the terms of the  GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.	 See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ * ========LICENCE========
+ */
+
+/*! @file algorithms/multi-prime-valence.h
+ * @ingroup algorithms
+ * @brief Valence of a sparse integer matrix, several primes per pass.
+ *
+ * The scalar valence (\ref squarizeValence) rebinds the integer matrix
+ * and runs one Wiedemann sequence per prime: each sparse apply reads
+ * the whole index structure for a single residue.
+ * Here, k primes are processed together: the matrix is stored once in CSR,
+ * with k residues per nonzero, and every apply works on vectors of
+ * k-wide residues, one prime per lane.
+ * The index traffic is shared by the k primes,
+ * and the lane loops are vectorized by the compiler.
+ *
+ * The early terminated \ref CRA then consumes the k valences of a batch
+ * before each termination test.
+ */
+
+#ifndef __LINBOX_multi_prime_valence_H
+#define __LINBOX_multi_prime_valence_H
+
+#include <cmath>
+#include <set>
+#include <vector>
+
+#include <givaro/modular.h>
+
+#include "linbox/linbox-config.h"
+#include "linbox/integer.h"
+#include "linbox/util/debug.h"
+#include "linbox/util/commentator.h"
+#include "linbox/field/field-traits.h"
+#include "linbox/randiter/random-prime.h"
+#include "linbox/algorithms/cra-builder-single.h"
+
+#ifndef __LB_VALENCE_LANES__
+#define __LB_VALENCE_LANES__ 8
+#endif
+
+namespace LinBox
+{
+
+	/** \brief Sparse integer matrix reduced modulo k primes at once.
+	 *
+	 * CSR storage: one column index per nonzero, followed in \c _val by
+	 * the k residues of that nonzero.
+	 * Vectors are arrays of \c rowdim() (or \c coldim()) k-wide residues,
+	 * the residue modulo the l-th prime of entry i being at <code>i*k+l</code>.
+	 *
+	 * The primes must be below \f$2^{26}\f$: a product of two residues plus
+	 * a residue is then exactly representable in a double.
+	 */
+	class MultiPrimeSparseMatrix {
+	public:
+		typedef Givaro::Modular<double> Field;
+		typedef Field::Element Element;
+
+		/** Reduces the integer sparse matrix \p A modulo each of \p primes.
+		 * @param A sparse matrix with rows of (column, integer value) pairs
+		 * @param primes the k moduli
+		 */
+		template<class IMatrix>
+		MultiPrimeSparseMatrix (const IMatrix& A, const std::vector<Integer>& primes) :
+			_rowdim (A.rowdim ()), _coldim (A.coldim ()), _k (primes.size ()),
+			_p (primes.size ()), _invp (primes.size ())
+		{
+			_fields.reserve (_k);
+			for (size_t l = 0; l < _k; ++l) {
+				linbox_check (primes[l] < Integer (1) << 26);
+				_fields.emplace_back (primes[l]);
+				_p[l] = (double) primes[l];
+				_invp[l] = 1.0 / _p[l];
+			}
+
+			_start.reserve (_rowdim + 1);
+			_start.push_back (0);
+			for (auto row = A.rowBegin (); row != A.rowEnd (); ++row)
+				_start.push_back (_start.back () + row->size ());
+
+			_colid.reserve (_start.back ());
+			_val.resize (_start.back () * _k);
+			auto v = _val.begin ();
+			for (auto row = A.rowBegin (); row != A.rowEnd (); ++row)
+				for (const auto& entry : *row) {
+					_colid.push_back (entry.first);
+					for (size_t l = 0; l < _k; ++l, ++v)
+						_fields[l].init (*v, entry.second);
+				}
+		}
+
+		size_t rowdim () const { return _rowdim; }
+		size_t coldim () const { return _coldim; }
+
+		/// Number of primes, i.e. the width of the residue vectors.
+		size_t lanes () const { return _k; }
+
+		/// Prime field of the l-th lane.
+		const Field& field (size_t l) const { return _fields[l]; }
+
+		/// \f$y \gets A x\f$ modulo each prime, \p y has \c rowdim()*k entries, \p x has \c coldim()*k.
+		void apply (Element* y, const Element* x) const
+		{
+			for (size_t i = 0; i < _rowdim; ++i) {
+				Element* yi = y + i * _k;
+				for (size_t l = 0; l < _k; ++l) yi[l] = 0.0;
+				for (size_t nz = _start[i]; nz < _start[i+1]; ++nz)
+					axpyin (yi, _val.data () + nz * _k, x + _colid[nz] * _k);
+			}
+		}
+
+		/// \f$y \gets A^T x\f$ modulo each prime, \p y has \c coldim()*k entries, \p x has \c rowdim()*k.
+		void applyTranspose (Element* y, const Element* x) const
+		{
+			std::fill (y, y + _coldim * _k, 0.0);
+			for (size_t i = 0; i < _rowdim; ++i) {
+				const Element* xi = x + i * _k;
+				for (size_t nz = _start[i]; nz < _start[i+1]; ++nz)
+					axpyin (y + _colid[nz] * _k, _val.data () + nz * _k, xi);
+			}
+		}
+
+		/// \f$y_l \gets y_l + a_l x_l\f$ for every lane.
+		inline void axpyin (Element* y, const Element* a, const Element* x) const
+		{
+			for (size_t l = 0; l < _k; ++l) {
+				double t = y[l] + a[l] * x[l];
+				t -= std::floor (t * _invp[l]) * _p[l];
+				// floor may be off by one
+				t += (t < 0.0) ? _p[l] : 0.0;
+				t -= (t >= _p[l]) ? _p[l] : 0.0;
+				y[l] = t;
+			}
+		}
+
+	protected:
+		size_t _rowdim, _coldim, _k;
+		std::vector<Field> _fields;
+		std::vector<double> _p, _invp;
+
+		std::vector<size_t> _start;
+		std::vector<size_t> _colid;
+		std::vector<Element> _val;
+	};
+
+	namespace Protected {
+		/** Incremental Berlekamp/Massey over one lane.
+		 *
+		 * Terms are pushed one at a time, the generation stops when
+		 * the discrepancy has been zero EARLY_TERM_THRESHOLD times in a row,
+		 * or when the whole sequence has been consumed.
+		 */
+		class LaneMassey {
+		public:
+			typedef Givaro::Modular<double> Field;
+			typedef Field::Element Element;
+
+			LaneMassey (const Field& F, size_t bound, size_t ett) :
+				_field (F), _bound (bound), _ett (ett),
+				_C (1, F.one), _B (1, F.one), _b (F.one)
+			{
+				_S.reserve (bound);
+			}
+
+			bool done () const { return (_zeros >= _ett) || (_S.size () >= _bound); }
+
+			void push (const Element& s)
+			{
+				size_t N = _S.size ();
+				_S.push_back (s);
+
+				Element d = s;
+				for (size_t i = 1; i <= _L && i < _C.size (); ++i)
+					_field.axpyin (d, _C[i], _S[N-i]);
+
+				if (_field.isZero (d)) {
+					++_x; ++_zeros;
+					return;
+				}
+				_zeros = 0;
+
+				Element coef;
+				_field.divin (_field.neg (coef, d), _b);
+				std::vector<Element> T;
+				bool lengthChange = (2 * _L <= N);
+				if (lengthChange) T = _C;
+
+				if (_C.size () < _B.size () + _x) _C.resize (_B.size () + _x, _field.zero);
+				for (size_t i = 0; i < _B.size (); ++i)
+					_field.axpyin (_C[i+_x], coef, _B[i]);
+
+				if (lengthChange) {
+					_L = N + 1 - _L;
+					_B.swap (T);
+					_b = d;
+					_x = 1;
+				}
+				else
+					++_x;
+			}
+
+			/// Degree of the minimal polynomial.
+			size_t degree () const { return _L; }
+
+			/// Lowest non zero coefficient of the (monic) minimal polynomial.
+			Element& valence (Element& v) const
+			{
+				for (size_t i = std::min (_L, _C.size () - 1) + 1; i-- > 0; )
+					if (! _field.isZero (_C[i])) return v = _C[i];
+				return v = _field.zero;
+			}
+
+		protected:
+			const Field& _field;
+			size_t _bound, _ett;
+			std::vector<Element> _S, _C, _B;
+			Element _b;
+			size_t _L = 0, _x = 1, _zeros = 0;
+		};
+	}
+
+	/** \brief Valences of a square sparse integer matrix modulo k primes, in one pass.
+	 *
+	 * The valence is computed on \f$A\f$ when it is square,
+	 * otherwise on \f$A A^T\f$ or \f$A^T A\f$, as in \ref squarizeValence:
+	 * method 0 is automatic, 1 is \f$A A^T\f$ and 2 is \f$A^T A\f$.
+	 *
+	 * Each lane runs its own scalar Wiedemann sequence, with random projections;
+	 * the sparse applies are shared by all lanes.
+	 */
+	template<class IMatrix>
+	class MultiPrimeValence {
+	public:
+		typedef MultiPrimeSparseMatrix::Field Field;
+		typedef Field::Element Element;
+
+		MultiPrimeValence (const IMatrix& A, size_t method = 0,
+				   size_t ett = LINBOX_DEFAULT_EARLY_TERMINATION_THRESHOLD) :
+			_A (A), _method (method), _ett (ett)
+		{
+			if (A.rowdim () == A.coldim ())
+				_method = 0;
+			else if (! _method)
+				_method = (A.rowdim () > A.coldim ()) ? 2 : 1;
+		}
+
+		/// Order of the square matrix whose minimal polynomial is computed.
+		size_t dimension () const
+		{
+			return (_method == 2) ? _A.coldim () : _A.rowdim ();
+		}
+
+		/** Valences and minimal polynomial degrees modulo each of \p primes.
+		 * @param[out] valences residue of the valence modulo each prime
+		 * @param[out] degrees degree of the minimal polynomial modulo each prime
+		 * @param primes the k primes, below \f$2^{26}\f$
+		 */
+		void operator() (std::vector<Element>& valences, std::vector<size_t>& degrees,
+				 const std::vector<Integer>& primes) const
+		{
+			MultiPrimeSparseMatrix M (_A, primes);
+			const size_t k = M.lanes ();
+			const size_t n = dimension ();
+			const size_t bound = 2 * n + 1;
+
+			std::vector<Protected::LaneMassey> lanes;
+			lanes.reserve (k);
+			for (size_t l = 0; l < k; ++l)
+				lanes.emplace_back (M.field (l), bound, _ett);
+
+			// random projections, one per lane
+			std::vector<Element> u (n * k), v (n * k), w (n * k);
+			std::vector<Element> z ((_method == 0) ? 0 : ((_method == 1) ? _A.coldim () : _A.rowdim ()) * k);
+			for (size_t l = 0; l < k; ++l) {
+				typename Field::RandIter G (M.field (l));
+				for (size_t i = 0; i < n; ++i) {
+					G.random (u[i*k+l]);
+					G.random (v[i*k+l]);
+				}
+			}
+
+			std::vector<Element> a (k);
+			bool done = false;
+			while (! done) {
+				// a_l = u_l^T v_l, in every lane
+				std::fill (a.begin (), a.end (), 0.0);
+				for (size_t i = 0; i < n; ++i)
+					M.axpyin (a.data (), u.data () + i * k, v.data () + i * k);
+
+				done = true;
+				for (size_t l = 0; l < k; ++l) {
+					if (! lanes[l].done ()) lanes[l].push (a[l]);
+					done = done && lanes[l].done ();
+				}
+				if (done) break;
+
+				// v <- B v, B being A, A A^T or A^T A
+				if (_method == 0)
+					M.apply (w.data (), v.data ());
+				else if (_method == 1) {
+					M.applyTranspose (z.data (), v.data ());
+					M.apply (w.data (), z.data ());
+				}
+				else {
+					M.apply (z.data (), v.data ());
+					M.applyTranspose (w.data (), z.data ());
+				}
+				v.swap (w);
+			}
+
+			valences.resize (k);
+			degrees.resize (k);
+			for (size_t l = 0; l < k; ++l) {
+				lanes[l].valence (valences[l]);
+				degrees[l] = lanes[l].degree ();
+			}
+		}
+
+	protected:
+		const IMatrix& _A;
+		size_t _method;
+		size_t _ett;
+	};
+
+	/** \brief Integer valence of a sparse integer matrix, \p lanes primes per pass.
+	 *
+	 * Early terminated chinese remaindering of the valences given by \ref MultiPrimeValence.
+	 * The termination is tested after each whole batch of \p lanes primes.
+	 * A prime where the minimal polynomial has a smaller degree than the largest seen
+	 * is discarded, a larger degree restarts the reconstruction.
+	 *
+	 * @param[out] V the valence of \p A, \f$A A^T\f$ or \f$A^T A\f$
+	 * @param A sparse integer matrix
+	 * @param method 0 for automatic, 1 for \f$A A^T\f$, 2 for \f$A^T A\f$
+	 * @param lanes number of primes per pass
+	 */
+	template<class IMatrix>
+	Integer& multiPrimeValence (Integer& V, const IMatrix& A, size_t method = 0,
+				    size_t lanes = __LB_VALENCE_LANES__)
+	{
+		typedef MultiPrimeSparseMatrix::Field Field;
+		commentator().start ("Multi-prime Integer Valence", "MPvalence");
+
+		MultiPrimeValence<IMatrix> iteration (A, method);
+		PrimeIterator<IteratorCategories::HeuristicTag> genprime (FieldTraits<Field>::bestBitSize (iteration.dimension ()));
+		CRABuilderEarlySingle<Field> builder (LINBOX_DEFAULT_EARLY_TERMINATION_THRESHOLD);
+
+		bool initialized = false;
+		size_t degree = 0;
+		std::vector<Integer> primes;
+		std::vector<Field::Element> valences;
+		std::vector<size_t> degrees;
+
+		while (! initialized || ! builder.terminated ()) {
+			std::set<Integer> batch;
+			while (batch.size () < lanes) {
+				++genprime;
+				if (initialized && builder.noncoprime (*genprime)) continue;
+				batch.insert (*genprime);
+			}
+			primes.assign (batch.begin (), batch.end ());
+
+			iteration (valences, degrees, primes);
+
+			for (size_t l = 0; l < primes.size (); ++l) {
+				Field F (primes[l]);
+				if (! initialized || degrees[l] > degree) {
+					degree = degrees[l];
+					builder.initialize (F, valences[l]);
+					initialized = true;
+				}
+				else if (degrees[l] == degree)
+					builder.progress (F, valences[l]);
+			}
+			commentator().report (Commentator::LEVEL_IMPORTANT, INTERNAL_DESCRIPTION)
+			<< primes.size () << " more primes, minimal polynomial degree " << degree << std::endl;
+		}
+
+		builder.result (V);
+		commentator().stop ("done", NULL, "MPvalence");
+		return V;
+	}
+
+} // namespace LinBox
+
+#endif // __LINBOX_multi_prime_valence_H
+
+// Local Variables:
+// mode: C++
+// tab-width: 4
+// indent-tabs-mode: nil
+// c-basic-offset: 4
+// End:
+// vim:sts=4:sw=4:ts=4:et:sr:cino=>s,f0,{0,g0,(0,\:0,t0,+0,=s
@@ -23,36 +23,310 @@
  */
 
 /* numeric-solver-lapack.h
- *  numeric solver using lapack routines
+ *  numeric solver using blas routines
  *  to support development of iterative numeric/symbolic solver
  */
 
 #ifndef __LINBOX_numeric_solver_lapack_H
 #define __LINBOX_numeric_solver_lapack_H
 
-#if defined(__FFLASFFPACK_HAVE_LAPACK)
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <typeinfo>
+#include <vector>
+
+#include "linbox/linbox-config.h"
+#include "linbox/util/debug.h"
+#include <fflas-ffpack/config-blas.h>
 
 namespace LinBox {
 
-	template <class Matrix>
-	struct LPS {
+	namespace Protected {
+
+		// single and double precision kernels of NumericLU
+		inline void lpsTrsm (const enum CBLAS_UPLO uplo, const enum CBLAS_TRANSPOSE trans, const enum CBLAS_DIAG diag,
+				     int m, int n, const float *A, int lda, float *B, int ldb)
+		{
+			cblas_strsm (CblasRowMajor, CblasLeft, uplo, trans, diag, m, n, 1.f, A, lda, B, ldb);
+		}
+		inline void lpsTrsm (const enum CBLAS_UPLO uplo, const enum CBLAS_TRANSPOSE trans, const enum CBLAS_DIAG diag,
+				     int m, int n, const double *A, int lda, double *B, int ldb)
+		{
+			cblas_dtrsm (CblasRowMajor, CblasLeft, uplo, trans, diag, m, n, 1., A, lda, B, ldb);
+		}
+		// C <- C - A B
+		inline void lpsGemm (int m, int n, int k, const float *A, int lda, const float *B, int ldb, float *C, int ldc)
+		{
+			cblas_sgemm (CblasRowMajor, CblasNoTrans, CblasNoTrans, m, n, k, -1.f, A, lda, B, ldb, 1.f, C, ldc);
+		}
+		inline void lpsGemm (int m, int n, int k, const double *A, int lda, const double *B, int ldb, double *C, int ldc)
+		{
+			cblas_dgemm (CblasRowMajor, CblasNoTrans, CblasNoTrans, m, n, k, -1., A, lda, B, ldb, 1., C, ldc);
+		}
+
+		/* Blocked LU with partial pivoting of the n x n row major A, in place:
+		 * rows j and piv[j] are swapped at step j.
+		 * Returns 0, or j+1 if the j-th pivot is zero.
+		 */
+		template <class T>
+		int lpsGetrf (size_t n, T *A, std::vector<size_t> &piv)
+		{
+			const size_t nb = 64;
+			piv.resize (n);
+			for (size_t j0 = 0; j0 < n; j0 += nb) {
+				const size_t jb = std::min (nb, n - j0);
+				// unblocked panel, the swaps are applied to the whole rows
+				for (size_t j = j0; j < j0 + jb; ++j) {
+					size_t p = j;
+					for (size_t i = j + 1; i < n; ++i)
+						if (std::fabs (A[i*n+j]) > std::fabs (A[p*n+j]))
+							p = i;
+					piv[j] = p;
+					if (A[p*n+j] == T(0))
+						return (int)j + 1;
+					if (p != j)
+						std::swap_ranges (A + p*n, A + p*n + n, A + j*n);
+					const T inv = T(1) / A[j*n+j];
+					for (size_t i = j + 1; i < n; ++i) {
+						T *Ai = A + i*n;
+						Ai[j] *= inv;
+						for (size_t c = j + 1; c < j0 + jb; ++c)
+							Ai[c] -= Ai[j] * A[j*n+c];
+					}
+				}
+				const size_t r = n - j0 - jb;
+				if (r) {
+					lpsTrsm (CblasLower, CblasNoTrans, CblasUnit, (int)jb, (int)r,
+						 A + j0*n + j0, (int)n, A + j0*n + j0 + jb, (int)n);
+					lpsGemm ((int)r, (int)r, (int)jb, A + (j0+jb)*n + j0, (int)n,
+						 A + j0*n + j0 + jb, (int)n, A + (j0+jb)*n + j0 + jb, (int)n);
+				}
+			}
+			return 0;
+		}
+
+		/* Solve A X = B, or A^T X = B, for the n x k row major B in place,
+		 * with the factorization of lpsGetrf.
+		 */
+		template <class T>
+		void lpsGetrs (bool trans, size_t n, const T *LU, const std::vector<size_t> &piv, T *B, size_t k)
+		{
+			if (! trans) {
+				for (size_t j = 0; j < n; ++j)
+					if (piv[j] != j)
+						std::swap_ranges (B + piv[j]*k, B + piv[j]*k + k, B + j*k);
+				lpsTrsm (CblasLower, CblasNoTrans, CblasUnit, (int)n, (int)k, LU, (int)n, B, (int)k);
+				lpsTrsm (CblasUpper, CblasNoTrans, CblasNonUnit, (int)n, (int)k, LU, (int)n, B, (int)k);
+			}
+			else {
+				lpsTrsm (CblasUpper, CblasTrans, CblasNonUnit, (int)n, (int)k, LU, (int)n, B, (int)k);
+				lpsTrsm (CblasLower, CblasTrans, CblasUnit, (int)n, (int)k, LU, (int)n, B, (int)k);
+				for (size_t j = n; j-- > 0; )
+					if (piv[j] != j)
+						std::swap_ranges (B + piv[j]*k, B + piv[j]*k + k, B + j*k);
+			}
+		}
+	}
+
+	/** \brief Factor once, solve many numeric solver for a square double matrix.
+	 *
+	 * The matrix is factored once by LU with partial pivoting, each solve is
+	 * two triangular solves; no inverse is formed.  Several right hand
+	 * sides are solved at once with level 3 BLAS.
+	 *
+	 * With mixed precision, the factorization is in single precision and
+	 * each solution is refined in double precision against the original
+	 * matrix, which gives the accuracy of a double factorization at half
+	 * the factorization cost.  It falls back to a double factorization when
+	 * the matrix is too ill conditioned for the refinement to converge.
+	 *
+	 * The 1-norm condition number is estimated (Hager/Higham) at init;
+	 * correctBits() is the number of bits of a solution that can be
+	 * trusted, which bounds the shift of the symbolic-numeric lifting.
+	 */
+	class NumericLU {
+	public:
+		explicit NumericLU (bool mixed = false) :
+			_A(NULL), _n(0), _mixed(mixed), _single(false), _anorm(0), _rcond(0)
+		{}
+
+		/** Factor the n x n row major \p A, which must outlive the solver.
+		 * Returns 0, or -1 if \p A is numerically singular.
+		 */
+		int init (const double *A, size_t n)
+		{
+			_A = A;
+			_n = n;
+			_rcond = 0;
+			linbox_check (_n);
+
+			_anorm = 0;
+			for (size_t j = 0; j < _n; ++j) {
+				double s = 0;
+				for (size_t i = 0; i < _n; ++i)
+					s += std::fabs (_A[i*_n+j]);
+				_anorm = std::max (_anorm, s);
+			}
+
+			_single = false;
+			if (_mixed) {
+				_LUs.assign (_A, _A + _n*_n);
+				if (Protected::lpsGetrf (_n, _LUs.data (), _piv) == 0) {
+					_single = true;
+					estimateCondition ();
+					// refinement contracts if cond * 2^-24 is well below 1
+					if (_rcond * double (1 << 21) >= 1.)
+						return 0;
+					_single = false;
+				}
+				std::vector<float> ().swap (_LUs);
+			}
+
+			_LUd.assign (_A, _A + _n*_n);
+			if (Protected::lpsGetrf (_n, _LUd.data (), _piv) != 0) {
+				std::vector<double> ().swap (_LUd);
+				return -1;
+			}
+			estimateCondition ();
+			return 0;
+		}
+
+		/** Solve A X = B for the n x k row major B, into X (X may be B).
+		 * Returns 0.
+		 */
+		int solve (double *X, const double *B, size_t k = 1) const
+		{
+			if (X != B)
+				memcpy (X, B, sizeof (double) * _n * k);
+			if (! _single) {
+				Protected::lpsGetrs (false, _n, _LUd.data (), _piv, X, k);
+				return 0;
+			}
+
+			// iterative refinement: X += A^{-1} (B - A X), the residual in double
+			const std::vector<double> Bd (X, X + _n * k);
+			std::vector<double> R (_n * k);
+			std::vector<float> Ws (Bd.begin (), Bd.end ());
+			Protected::lpsGetrs (false, _n, _LUs.data (), _piv, Ws.data (), k);
+			std::copy (Ws.begin (), Ws.end (), X);
+
+			const double eps = std::numeric_limits<double>::epsilon ();
+			double prev = std::numeric_limits<double>::max ();
+			for (size_t it = 0; it < 30; ++it) {
+				std::copy (Bd.begin (), Bd.end (), R.begin ());
+				Protected::lpsGemm ((int)_n, (int)k, (int)_n, _A, (int)_n, X, (int)k, R.data (), (int)k);
+				std::copy (R.begin (), R.end (), Ws.begin ());
+				Protected::lpsGetrs (false, _n, _LUs.data (), _piv, Ws.data (), k);
+				double dnorm = 0, xnorm = 0;
+				for (size_t i = 0; i < _n * k; ++i) {
+					X[i] += Ws[i];
+					dnorm = std::max (dnorm, std::fabs ((double)Ws[i]));
+					xnorm = std::max (xnorm, std::fabs (X[i]));
+				}
+				if (dnorm <= eps * xnorm || dnorm >= prev / 2)
+					break;
+				prev = dnorm;
+			}
+			return 0;
+		}
+
+		/// y = A x for the n x k row major x
+		void apply (double *y, const double *x, size_t k = 1) const
+		{
+			cblas_dgemm (CblasRowMajor, CblasNoTrans, CblasNoTrans, (int)_n, (int)k, (int)_n,
+				     1., _A, (int)_n, x, (int)k, 0., y, (int)k);
+		}
+
+		/// Estimate of the reciprocal of the 1-norm condition number, 0 if singular.
+		double rcond () const { return _rcond; }
+
+		/// Number of bits of a solution that are correct, given the condition estimate.
+		size_t correctBits () const
+		{
+			if (_rcond <= 0) return 0;
+			const double lost = std::ceil (-std::log2 (_rcond)) + 2;
+			return lost >= 52 ? 0 : size_t (52 - lost);
+		}
+
+		/// Whether the factorization is in single precision.
+		bool singlePrecision () const { return _single; }
+
+		size_t dim () const { return _n; }
+
+	protected:
+		const double *_A;
+		size_t _n;
+		bool _mixed, _single;
+		std::vector<double> _LUd;
+		std::vector<float> _LUs;
+		std::vector<size_t> _piv;
+		double _anorm, _rcond;
+
+		template <class T>
+		void solveWith (bool trans, const std::vector<T> &LU, std::vector<double> &x) const
+		{
+			std::vector<T> w (x.begin (), x.end ());
+			Protected::lpsGetrs (trans, _n, LU.data (), _piv, w.data (), 1);
+			std::copy (w.begin (), w.end (), x.begin ());
+		}
+
+		void solveFactor (bool trans, std::vector<double> &x) const
+		{
+			if (_single) solveWith (trans, _LUs, x);
+			else solveWith (trans, _LUd, x);
+		}
 
-		LPS() : _Ap(NULL), _IM(NULL), _m(0), _n(0) {}
-		~LPS() {
-			if(_IM) {
-				// std::cout << "delete" << std::endl;
-				delete[] _IM;
+		// Hager's estimate of ||A^{-1}||_1, as in LAPACK's xLACON
+		void estimateCondition ()
+		{
+			std::vector<double> x (_n, 1. / double (_n)), z (_n);
+			double est = 0;
+			size_t jlast = _n;
+			for (size_t it = 0; it < 5; ++it) {
+				solveFactor (false, x);
+				est = 0;
+				for (size_t i = 0; i < _n; ++i) {
+					est += std::fabs (x[i]);
+					z[i] = (x[i] >= 0) ? 1. : -1.;
+				}
+				solveFactor (true, z);
+				size_t j = 0;
+				for (size_t i = 1; i < _n; ++i)
+					if (std::fabs (z[i]) > std::fabs (z[j])) j = i;
+				if (j == jlast) break;
+				jlast = j;
+				std::fill (x.begin (), x.end (), 0.);
+				x[j] = 1.;
 			}
+			const double cond = _anorm * est;
+			_rcond = (cond > 0 && std::isfinite (cond)) ? 1. / cond : 0.;
 		}
-		LPS(Matrix& A) { init(A); }
+	};
+
+	/** Numeric solver of RationalSolverSN on a dense matrix of doubles,
+	 * see \ref NumericLU.
+	 */
+	template <class Matrix>
+	struct LPS {
+
+		explicit LPS(bool mixed = false) : _Ap(NULL), _LU(mixed), _m(0), _n(0) {}
+		LPS(Matrix& A, bool mixed = false) : _LU(mixed) { init(A); }
 		int init(Matrix & A); // set up for solving - expect multiple subsequent calls to solve() and apply().
 
 		template<class Vector> int solve(Vector& x, const Vector& b); // x such that Ax = b (approx)
 		template<class Vector> Vector& apply(Vector& y, const Vector& x); // y = Ax (approx)
 
+		/// X such that AX = B for k right hand sides, n x k row major
+		int solve(double *X, const double *B, size_t k) { return _LU.solve(X, B, k); }
+
+		double rcond() const { return _LU.rcond(); }
+		size_t correctBits() const { return _LU.correctBits(); }
+
 	protected:
 		Matrix* _Ap; // for right now, assume this points to the input, double matrix A.
-		double *_IM;
+		NumericLU _LU;
 
 		size_t _m, _n;
 	};
@@ -60,32 +334,14 @@ namespace LinBox {
 	template <class Matrix>
 	int LPS<Matrix>::init(Matrix& A)
 	{
-		_Ap = &A; // would need memcpy if *_Ap to get mods.
+		_Ap = &A;
 		_m = A.rowdim();
 		_n = A.coldim();
+		linbox_check(_m == _n);
 
 		//  kludgey pointer to beginning of double vals
-		void *thedata = &*(_Ap->Begin());
-
-		linbox_check(_n);
-		_IM = new double[_n * _n];
-		memcpy((void *)_IM, thedata, sizeof(double)*_m*_n);
-
-		// time to set up inverse of matrix
-		int lda = (int)_n;
-		int * P = new int[_n];
-		// std::cerr << "Bef getrf: M_0,0 " << *_IM << ", M_n-1,n-1 " << *(_IM+_n*_n-1) << std::endl;
-		int ierr = clapack_dgetrf (CblasRowMajor, (int)_n, (int)_n, _IM, lda, P);
-		// std::cerr << "Aft getrf: M_0,0 " << *_IM << ", M_n-1,n-1 " << *(_IM+_n*_n-1) << std::endl;
-		if (ierr != 0) {
-			// std::cerr << "In LPS::init Matrix is not full rank" << std::endl;
-			delete[] P ;
-			return -1;
-		}
-		clapack_dgetri (CblasRowMajor, (int)_n, _IM, lda, P);
-		delete[] P ;
-
-		return 0;
+		const double *thedata = &*(_Ap->Begin());
+		return _LU.init(thedata, _n);
 	}
 
 	template <class Matrix>
@@ -93,35 +349,19 @@ namespace LinBox {
 	int LPS<Matrix>::solve(Vector& x, const Vector& b)
 	{
 		linbox_check(typeid(typename Vector::value_type)==typeid(double));
-		// std::cout << "input :" << b << std::endl;
-		const double * bdata = &*(b.begin());
-		double * xdata = &*(x.begin());
-
-		cblas_dgemv(CblasRowMajor, CblasNoTrans, (int)_m, (int)_n, 1, _IM, (int)_n, bdata, 1, 0, xdata, 1);
-		// std::cout << "result to solve :" << x << std::endl;
-
-		return 0;
+		return _LU.solve(&*(x.begin()), &*(b.begin()), 1);
 	}
 
 	template <class Matrix>
 	template<class Vector>
 	Vector& LPS<Matrix>::apply(Vector& y, const Vector& x)
 	{
-		// std::cout << "input :" << x << std::endl;
-		const double * xdata = &*(x.begin());
-		double * ydata = &*(y.begin());
-		double *thedata = &*(_Ap->Begin());
-
-		cblas_dgemv(CblasRowMajor, CblasNoTrans, (int)_m, (int)_n, 1, thedata, (int)_n, xdata, 1, 0, ydata, 1);
-		// std::cout << "result to apply :" << y << std::endl;
-
+		_LU.apply(&*(y.begin()), &*(x.begin()), 1);
 		return y;
 	}
 
 } // namespace LinBox
 
-#endif // __FFLASFFPACK_HAVE_LAPACK
-
 #endif // __LINBOX_numeric_solver_lapack_H
 
 // Local Variables:
@@ -3,11 +3,139 @@
 /* by Alex Stachnik
 */
 
+#include <vector>
+#include <type_traits>
 #include <givaro/extension.h>
+#include <fflas-ffpack/ffpack/ffpack.h>
 #include <linbox/algorithms/poly-interpolation.h>
 #include <linbox/solutions/det.h>
+#include "linbox/matrix/polynomial-matrix.h"
+#include "linbox/algorithms/polynomial-matrix/fft.h"
 
 namespace LinBox {
+
+inline int roundUpPowerOfTwo(unsigned int n)
+{
+	if (n==0) {
+		return 0;
+	} else if (n==1) {
+		return 1;
+	}
+	
+	int bits=0;
+	int loopN=n;
+	while (loopN>0) {
+		loopN = loopN >> 1;
+		++bits;
+	}
+	
+	unsigned int mask=(1<<(bits-1))-1;
+	if ((mask&n)!=0) {
+		return 1<<bits;
+	} else {
+		return 1<<(bits-1);
+	}
+}
+
+namespace Protected {
+
+/*
+The evaluations of the matrix are stored point after point,
+evals[k*n*n+i*n+j] being the (i,j) entry at the k-th point, so that
+each evaluated matrix is a contiguous block given to FFPACK::Det.
+ */
+template <class Field>
+void batchedDets(std::vector<typename Field::Element>& dets,
+                 const Field& F,
+                 std::vector<typename Field::Element>& evals,
+                 size_t n)
+{
+	const int64_t numPts=dets.size();
+#pragma omp parallel for shared(dets,evals,F)
+	for (int64_t k=0;k<numPts;++k) {
+		FFPACK::Det(F,dets[k],n,evals.data()+k*n*n,n);
+	}
+}
+
+/*
+Word size prime fields with 2^l-th roots of unity, 2^l >= d: the points
+are the roots of unity and both the evaluation and the interpolation are
+the FFT of the polynomial matrix multiplication.  The entries of degree
+at least 2^l are reduced modulo x^(2^l)-1, which does not change their
+values at the points.
+ */
+template <class T1,class T2,class Matrix,class PolyElt>
+typename std::enable_if<std::is_arithmetic<T1>::value,bool>::type
+polyDetFFT(const Givaro::Modular<T1,T2>& F, PolyElt& result, Matrix& A, size_t d)
+{
+	typedef Givaro::Modular<T1,T2> Field;
+	typedef typename Field::Element FieldElt;
+	typedef PolynomialMatrix<Field,PMType::polfirst> MatrixP;
+
+	const uint64_t p=F.cardinality();
+	size_t lpts=1,pts=2;
+	while (pts<d) {
+		pts <<= 1;
+		++lpts;
+	}
+	if (p>=536870912ULL || ((p-1)%pts)!=0) {
+		return false;
+	}
+
+	const size_t n=A.coldim();
+	const int64_t nn=n*n;
+	FFT<Field> FFTer(F,lpts);
+	FFT<Field> FFTinv(F,lpts,FFTer.invroot());
+	MatrixP E(F,n,n,pts);
+
+#pragma omp parallel for shared(E,A,FFTer)
+	for (int64_t ij=0;ij<nn;++ij) {
+		PolyElt q;
+		A.getEntry(q,ij/n,ij%n);
+		for (size_t k=0;k<q.size();++k) {
+			F.addin(E.ref(ij,k%pts),q[k]);
+		}
+		FFTer.FFT_direct(&(E.ref(ij,0)));
+	}
+
+	commentator().report(Commentator::LEVEL_IMPORTANT,PROGRESS_REPORT)
+		<< "Finished evaluations" << std::endl;
+
+	std::vector<FieldElt> evals(pts*nn),dets(pts);
+#pragma omp parallel for shared(E,evals)
+	for (int64_t k=0;k<(int64_t)pts;++k) {
+		for (int64_t ij=0;ij<nn;++ij) {
+			F.assign(evals[k*nn+ij],E.get(ij,k));
+		}
+	}
+	batchedDets(dets,F,evals,n);
+
+	MatrixP D(F,1,1,pts);
+	for (size_t k=0;k<pts;++k) {
+		F.assign(D.ref(0,k),dets[k]);
+	}
+	FFTinv.FFT_inverse(&(D.ref(0,0)));
+
+	FieldElt invPts;
+	F.init(invPts,(uint64_t)pts);
+	F.invin(invPts);
+	result.resize(pts);
+	for (size_t k=0;k<pts;++k) {
+		F.mul(result[k],D.get(0,k),invPts);
+	}
+	Givaro::Poly1Dom<Field,Givaro::Dense> PD(F);
+	PD.setdegree(result);
+	return true;
+}
+
+template <class Field,class Matrix,class PolyElt>
+bool polyDetFFT(const Field&, PolyElt&, Matrix&, size_t)
+{
+	return false;
+}
+
+}
+
 /*  
 Matrix is a polynomial matrix.  
 result is set to its determinant and returned (a polynomial).
@@ -15,6 +143,12 @@ d is the number of evaluation points.
 
 The method is to compute dets at each evaluation point and interpolate.
  (note by bds)
+
+The determinants at all the points are computed in parallel, on the
+evaluated matrices stored in one block.  When the field has enough
+roots of unity the evaluation and the interpolation are done by FFT;
+otherwise at the points 0, 1, ..., 2^l-1 (2^l >= d, to be less than the
+characteristic) by the subproduct tree of PolyInterpolation.
  */
 template <class Field>
 typename Givaro::Poly1Dom<Field,Givaro::Dense>::Element&
@@ -25,77 +159,49 @@ computePolyDet(typename Givaro::Poly1Dom<Field,Givaro::Dense>::Element& result,
 	typedef Givaro::Poly1Dom<Field,Givaro::Dense> PolyDom;
 	typedef typename PolyDom::Element PolyElt;
 	typedef typename Field::Element FieldElt;
-	//typedef MatrixDomain<Field> FieldMatDom;
-	typedef DenseMatrix<Field> FieldMat;
 
-	int n=A.coldim(),m=A.rowdim();
+	linbox_check(A.rowdim()==A.coldim());
+	const int64_t n=A.coldim(),nn=n*n;
 
 	PolyDom BR=A.field();
 	Field F(BR.subDomain()); // coeff field
 
-	std::vector<FieldMat> mats;
-	std::vector<FieldElt> pts(d);
-	FieldElt fieldElt;
-	F.assign(fieldElt,F.zero);
-	for (int i=0;i<d;++i) {
-		mats.push_back(FieldMat(F,m,n));
-		F.init(pts[i],int64_t(i));
+	if (Protected::polyDetFFT(F,result,A,d)) {
+		return result;
 	}
 
-	commentator().report(Commentator::LEVEL_IMPORTANT,PROGRESS_REPORT)
-		<< "Initialized mats" << std::endl;
+	const int64_t numPts=roundUpPowerOfTwo(d);
+	std::vector<FieldElt> pts(numPts);
+	for (int64_t k=0;k<numPts;++k) {
+		F.init(pts[k],k);
+	}
 
+	commentator().report(Commentator::LEVEL_IMPORTANT,PROGRESS_REPORT)
+		<< "Initialized points" << std::endl;
 
 	PolyInterpolation<Field,PolyDom> PI(pts,F,BR);
-#pragma omp parallel for shared(mats,A,PI,BR,F)
-	for (int i=0;i<m;++i) {
-		for (int j=0;j<n;++j) {
-			PolyElt p;
-			A.getEntry(p,i,j);
-			std::vector<FieldElt> vals;
-			PI.evaluate(vals,p,BR,F);
-			for (int k=0;k<d;++k) {
-				mats[k].setEntry(i,j,vals[k]);
-			}
+	std::vector<FieldElt> evals(numPts*nn);
+#pragma omp parallel for shared(evals,A,PI,BR,F)
+	for (int64_t ij=0;ij<nn;++ij) {
+		PolyElt p;
+		A.getEntry(p,ij/n,ij%n);
+		std::vector<FieldElt> vals;
+		PI.evaluate(vals,p,BR,F);
+		for (int64_t k=0;k<numPts;++k) {
+			F.assign(evals[k*nn+ij],vals[k]);
 		}
 	}
 
 	commentator().report(Commentator::LEVEL_IMPORTANT,PROGRESS_REPORT)
 		<< "Finished evaluations" << std::endl;
 
-	std::vector<FieldElt> dets(d);
-#pragma omp parallel for shared(dets,mats)
-	for (int k=0;k<d;++k) {
-		det(dets[k],mats[k],Method::Elimination());
-	}
+	std::vector<FieldElt> dets(numPts);
+	Protected::batchedDets(dets,F,evals,n);
 
 	PI.interpolate(result,pts,dets,BR,F);
 	return result;
 }
 
-int roundUpPowerOfTwo(unsigned int n)
-{
-	if (n==0) {
-		return 0;
-	} else if (n==1) {
-		return 1;
-	}
-	
-	int bits=0;
-	int loopN=n;
-	while (loopN>0) {
-		loopN = loopN >> 1;
-		++bits;
-	}
-	
-	unsigned int mask=(1<<(bits-1))-1;
-	if ((mask&n)!=0) {
-		return 1<<bits;
-	} else {
-		return 1<<(bits-1);
-	}
-}
-
 template <class Field,class Matrix>
 typename Givaro::Poly1Dom<Field,Givaro::Dense>::Element&
 computePolyDetExtension(typename Givaro::Poly1Dom<Field,Givaro::Dense>::Element& result,
@@ -135,6 +241,20 @@ computePolyDetExtension(typename Givaro::Poly1Dom<Field,Givaro::Dense>::Element&
 		newCard *= a;
 		++e;
 	}
+
+	integer c;
+	F.characteristic(c);
+	if (e==1 && c>=d) {
+		// enough points in the base field
+		DenseMatrix<BasePolyDom> Ab(BR,m,n);
+		for (int i=0;i<m;++i) {
+			for (int j=0;j<n;++j) {
+				A.getEntry(p,i,j);
+				Ab.setEntry(i,j,p);
+			}
+		}
+		return computePolyDet<Field>(result,Ab,d);
+	}
 	
 	typedef Givaro::Extension<Field> ExtField;
 	typedef Givaro::Poly1Dom<ExtField,Givaro::Dense> ExtPolyDom;
@@ -0,0 +1,274 @@
+/* linbox/algorithms/polynomial-matrix/matpoly-det-adjoint.h
+ * Copyright (C) 2026 The LinBox group
+ *
+ * ========LICENCE========
+ * This file is part of the library LinBox.
+ *
+ * LinBox is free software: you can redistribute it and/or modify
+ * it under the terms of the  GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.	 See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ * ========LICENCE========
+ */
+
+/*! @file algorithms/polynomial-matrix/matpoly-det-adjoint.h
+ * @ingroup algorithms
+ * @brief Determinant and projected adjoint of a square polynomial matrix
+ * by evaluation and interpolation.
+ */
+
+#ifndef __LINBOX_matpoly_det_adjoint_H
+#define __LINBOX_matpoly_det_adjoint_H
+
+#include <vector>
+#include <type_traits>
+
+#include "linbox/integer.h"
+#include "linbox/util/debug.h"
+#include "linbox/matrix/dense-matrix.h"
+#include "linbox/matrix/polynomial-matrix.h"
+#include "linbox/matrix/matrixdomain/blas-matrix-domain.h"
+#include "linbox/algorithms/polynomial-matrix/fft.h"
+
+namespace LinBox
+{
+
+	/** \brief Determinant and projected adjoint of a square polynomial matrix.
+	 *
+	 * For \f$G \in K[x]^{b \times b}\f$ with \f$d\f$ coefficients and
+	 * \f$w \in K^b\f$, computes \f$\det G\f$ and
+	 * \f$\mathrm{adj}(G)\,w = \det(G)\,G^{-1} w\f$.  Both have degree at most
+	 * \f$N-1 = b(d-1)\f$; they are evaluated at \f$N\f$ points with one dense
+	 * determinant and one dense solve per point, then interpolated.
+	 *
+	 * Over a word size \c Givaro::Modular field with \f$2^k\f$-th roots of
+	 * unity for \f$2^k \geq N\f$ (the condition of the FFT multiplication of
+	 * polynomial matrices), the points are a random coset of the roots of
+	 * unity and both transforms are the \ref FFT of the multiplication:
+	 * \f$O(b^2 N \log N + b^3 N)\f$ operations.  Otherwise the evaluation is
+	 * by Horner and the interpolation by Newton on the points 0, 1, 2, ...
+	 */
+	template<class _Field>
+	class PolynomialMatrixDetAdjointDomain {
+	public:
+		typedef _Field                                     Field;
+		typedef typename Field::Element                  Element;
+		typedef PolynomialMatrix<Field, PMType::polfirst> MatrixP;
+		typedef std::vector<Element>                  Polynomial; //!< low degree first
+
+	private:
+		const Field            *_field;
+		BlasMatrixDomain<Field>  _BMD;
+
+	public:
+		PolynomialMatrixDetAdjointDomain (const Field &F) : _field(&F), _BMD(F) {}
+
+		inline const Field &field () const { return *_field; }
+
+		/** \f$\det G\f$ and \f$\mathrm{adj}(G)\,w\f$.
+		 * @param det  \f$\det G\f$, of length \f$b(d-1)+1\f$
+		 * @param adjw the b entries of \f$\mathrm{adj}(G)\,w\f$, same length
+		 * @param G    b x b polynomial matrix, polfirst or matfirst
+		 * @param w    vector of size b
+		 * @return false if \p G is singular, or if the field is too small to
+		 * interpolate; \p det and \p adjw are then meaningless.
+		 */
+		template<class PMatrix, class Vector>
+		bool solve (Polynomial &det, std::vector<Polynomial> &adjw, const PMatrix &G, const Vector &w) const
+		{
+			linbox_check (G.rowdim () == G.coldim ());
+			linbox_check (w.size () == G.rowdim ());
+			const size_t N = G.rowdim () * (G.size () - 1) + 1;
+			det.assign (N, field ().zero);
+			adjw.assign (G.rowdim (), det);
+			if (solveFFT (field (), det, adjw, G, w, N))
+				return true;
+			return solveNewton (det, adjw, G, w, N);
+		}
+
+	private:
+		// det(A) and det(A) A^{-1} w, false if A is singular
+		template<class Vector>
+		bool pointValue (Element &dt, BlasVector<Field> &y, const BlasMatrix<Field> &A, const Vector &w) const
+		{
+			dt = _BMD.det (A);
+			if (field ().isZero (dt))
+				return false;
+			_BMD.left_solve (y, A, w);
+			for (size_t i = 0; i < y.size (); ++i)
+				field ().mulin (y[i], dt);
+			return true;
+		}
+
+		// points c w^i, w a primitive 2^k-th root of unity, in bit reversed order
+		template<class T1, class T2, class PMatrix, class Vector>
+		typename std::enable_if<std::is_arithmetic<T1>::value, bool>::type
+		solveFFT (const Givaro::Modular<T1,T2> &, Polynomial &det, std::vector<Polynomial> &adjw,
+			  const PMatrix &G, const Vector &w, size_t N) const
+		{
+			const uint64_t p = field ().cardinality ();
+			size_t lpts = 1, pts = 2;
+			while (pts < N) { pts <<= 1; ++lpts; }
+			if (p >= 536870912ULL || ((p-1) % pts) != 0)
+				return false;
+
+			const size_t b = G.rowdim (), d = G.size ();
+			FFT<Field> FFTer (field (), lpts);
+			FFT<Field> FFTinv (field (), lpts, FFTer.invroot ());
+			typename Field::RandIter Gen (field ());
+			MatrixP E (field (), b, b, pts);
+			MatrixP V (field (), b+1, 1, pts);
+			BlasMatrix<Field> A (field (), b, b);
+			BlasVector<Field> y (field (), b);
+			Element c, ck, dt;
+
+			// a root of det G on the coset: try another one
+			for (size_t trial = 0; trial < 3; ++trial) {
+				do Gen.random (c); while (field ().isZero (c));
+
+				// G(c x) on the roots of unity
+				for (size_t i = 0; i < b * b; ++i) {
+					field ().assign (ck, field ().one);
+					for (size_t k = 0; k < d; ++k) {
+						field ().mul (E.ref (i, k), G.get (i, k), ck);
+						field ().mulin (ck, c);
+					}
+					for (size_t k = d; k < pts; ++k)
+						field ().assign (E.ref (i, k), field ().zero);
+					FFTer.FFT_direct (&(E.ref (i, 0)));
+				}
+
+				bool regular = true;
+				for (size_t t = 0; regular && t < pts; ++t) {
+					for (size_t i = 0; i < b; ++i)
+						for (size_t j = 0; j < b; ++j)
+							A.setEntry (i, j, E.get (i*b+j, t));
+					regular = pointValue (dt, y, A, w);
+					for (size_t i = 0; regular && i < b; ++i)
+						field ().assign (V.ref (i, t), y[i]);
+					field ().assign (V.ref (b, t), dt);
+				}
+				if (! regular)
+					continue;
+
+				// coefficients of det G(c x) and adj(G(c x)) w, then x -> x/c
+				Element s;
+				field ().init (s, (uint64_t)pts);
+				field ().invin (s);
+				field ().inv (c, c);
+				for (size_t i = 0; i <= b; ++i) {
+					FFTinv.FFT_inverse (&(V.ref (i, 0)));
+					Polynomial &r = (i < b) ? adjw[i] : det;
+					field ().assign (ck, s);
+					for (size_t k = 0; k < N; ++k) {
+						field ().mul (r[k], V.get (i, k), ck);
+						field ().mulin (ck, c);
+					}
+				}
+				return true;
+			}
+			return false;
+		}
+
+		template<class F, class PMatrix, class Vector>
+		bool solveFFT (const F &, Polynomial &, std::vector<Polynomial> &,
+			       const PMatrix &, const Vector &, size_t) const
+		{
+			return false;
+		}
+
+		// points 0, 1, 2, ... skipping the roots of det G
+		template<class PMatrix, class Vector>
+		bool solveNewton (Polynomial &det, std::vector<Polynomial> &adjw,
+				  const PMatrix &G, const Vector &w, size_t N) const
+		{
+			const size_t b = G.rowdim (), d = G.size ();
+
+			// at most N-1 of the candidates are roots of det G
+			uint64_t candidates = 2 * N - 1;
+			integer ch;
+			field ().characteristic (ch);
+			if (ch != 0 && ch < integer (candidates))
+				candidates = uint64_t (ch);
+
+			std::vector<Element> x;
+			std::vector<Polynomial> vals (b+1);
+			x.reserve (N);
+			for (auto &v : vals)
+				v.reserve (N);
+
+			BlasMatrix<Field> A (field (), b, b);
+			BlasVector<Field> y (field (), b);
+			Element a, e, dt;
+			for (uint64_t k = 0; k < candidates && x.size () < N; ++k) {
+				field ().init (a, k);
+				for (size_t i = 0; i < b; ++i)
+					for (size_t j = 0; j < b; ++j) {
+						field ().assign (e, G.get (i*b+j, d-1));
+						for (size_t l = d-1; l-- > 0; ) {
+							field ().mulin (e, a);
+							field ().addin (e, G.get (i*b+j, l));
+						}
+						A.setEntry (i, j, e);
+					}
+				if (! pointValue (dt, y, A, w))
+					continue;
+				x.push_back (a);
+				for (size_t i = 0; i < b; ++i)
+					vals[i].push_back (y[i]);
+				vals[b].push_back (dt);
+			}
+			if (x.size () < N)
+				return false;
+
+			// divided differences, one inversion per pair of points
+			for (size_t j = 1; j < N; ++j)
+				for (size_t i = N-1; i >= j; --i) {
+					field ().sub (e, x[i], x[i-j]);
+					field ().invin (e);
+					for (auto &v : vals) {
+						field ().subin (v[i], v[i-1]);
+						field ().mulin (v[i], e);
+					}
+				}
+
+			// Newton to monomial basis
+			for (size_t l = 0; l <= b; ++l) {
+				Polynomial &r = (l < b) ? adjw[l] : det;
+				const Polynomial &v = vals[l];
+				field ().assign (r[0], v[N-1]);
+				for (size_t i = N-1; i-- > 0; ) {
+					const size_t m = N-2-i; // degree of r
+					field ().assign (r[m+1], r[m]);
+					for (size_t k = m; k > 0; --k) {
+						field ().mul (e, x[i], r[k]);
+						field ().sub (r[k], r[k-1], e);
+					}
+					field ().mul (e, x[i], r[0]);
+					field ().sub (r[0], v[i], e);
+				}
+			}
+			return true;
+		}
+	};
+
+} // LinBox
+
+#endif // __LINBOX_matpoly_det_adjoint_H
+
+// Local Variables:
+// mode: C++
+// tab-width: 4
+// indent-tabs-mode: nil
+// c-basic-offset: 4
+// End:
+// vim:sts=4:sw=4:ts=4:et:sr:cino=>s,f0,{0,g0,(0,\:0,t0,+0,=s
@@ -29,6 +29,16 @@
 #define KARA_DEG_THRESHOLD  2 
 #define FFT_DEG_THRESHOLD   2
 
+// sum of the sizes of the operands above which PolynomialMatrixMulDomain::mul
+// uses the FFT (resp. Karatsuba) product, rather than Karatsuba (resp. naive);
+// benchmarks/benchmark-tune-thresholds measures the FFT one
+#ifndef LINBOX_MATPOLY_FFT_THRESHOLD
+#define LINBOX_MATPOLY_FFT_THRESHOLD   2
+#endif
+#ifndef LINBOX_MATPOLY_KARA_THRESHOLD
+#define LINBOX_MATPOLY_KARA_THRESHOLD  2
+#endif
+
 #include "linbox/algorithms/polynomial-matrix/matpoly-mult-naive.h"
 #include "linbox/algorithms/polynomial-matrix/matpoly-mult-kara.h"
 #include "linbox/algorithms/polynomial-matrix/matpoly-mult-fft.h"
@@ -56,12 +66,12 @@ namespace LinBox
 		void mul(PMatrix1 &c, const PMatrix2 &a, const PMatrix3 &b, size_t max_rowdeg=0) const
 		{
 			size_t d = a.size()+b.size();
-            if (d > FFT_DEG_THRESHOLD){
+            if (d > LINBOX_MATPOLY_FFT_THRESHOLD){
                     //std::cout<<"PolMul FFT"<<std::endl;
 				_fft.mul(c,a,b);
             }
 			else
-				if ( d > KARA_DEG_THRESHOLD){
+				if ( d > LINBOX_MATPOLY_KARA_THRESHOLD){
                         //std::cout<<"PolMul Kara"<<std::endl;
 					_kara.mul(c,a,b);
                 }
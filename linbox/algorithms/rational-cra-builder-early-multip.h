@@ -124,6 +124,18 @@ namespace LinBox
 			RationalCRABuilderFullMultip<Domain>::progress(D, e);
 		}
 
+		//! progress with residues already combined modulo a composite \p D (see ChineseRemainderDistributed)
+		void progress (const Integer& D, const BlasVector<Givaro::ZRing<Integer> >& e)
+		{
+			Integer z(0);
+			for (size_t i = 0; i < e.size(); ++i)
+				z += e[i] * randv[i];
+			Integer::modin(z, D);
+			if (z < 0) z += D;
+			RationalCRABuilderEarlySingle<Domain>::progress(D, z);
+			RationalCRABuilderFullMultip<Domain>::progress(D, e);
+		}
+
 		//!result
 		template<template<class, class> class Vect, template <class> class Alloc>
 		Vect<Integer, Alloc<Integer> >& result(Vect<Integer, Alloc<Integer> >& num, Integer& den)
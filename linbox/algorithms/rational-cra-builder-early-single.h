@@ -72,6 +72,7 @@ namespace LinBox
 			Integer	m0 = this->primeProd_ %D;
 
 			fieldreconstruct(this->residue_, D, e, u0, m0, Integer(this->residue_), this->primeProd_);
+			this->nextM_ = D;
 			this->primeProd_ *= this->nextM_;
 			Integer a, b;
 			_ZZ.RationalReconstruction(a, b, this->residue_, this->primeProd_);
@@ -0,0 +1,156 @@
+/* Copyright (C) LinBox
+ *
+ * ========LICENCE========
+ * This file is part of the library LinBox.
+ *
+ * LinBox is free software: you can redistribute it and/or modify
+ * it under the terms of the  GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.	 See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ * ========LICENCE========
+ */
+
+/*! @file algorithms/rational-cra-parallel.h
+ * @brief Shared-memory (PALADIN) version of the rational \ref CRA
+ * @brief Launch by blocks of NN iterations
+ * @brief in parallel, by default, NN is the number of available threads
+ * @brief Then synchronization and termination test.
+ * @ingroup CRA
+ */
+
+#pragma once
+
+#include <exception>
+#include <set>
+#include <vector>
+
+#include <fflas-ffpack/paladin/parallel.h>
+
+#include "linbox/algorithms/rational-cra.h"
+#include "linbox/integer.h"
+#include "linbox/util/commentator.h"
+#include "linbox/vector/blas-vector.h"
+
+namespace LinBox
+{
+
+	/** \brief Chinese remainder of rationals, with the iterations run on a thread pool.
+	 *
+	 * Each round samples NN distinct primes, runs the NN iterations concurrently,
+	 * then feeds the residues to the builder sequentially before testing termination.
+	 *
+	 * The iteration function object is shared by all threads:
+	 * any data it refers to (e.g. the integer matrix) exists only once in memory,
+	 * only the per-prime images are allocated by each task.
+	 */
+	template<class RatCRABase>
+	struct RationalChineseRemainderParallel : public RationalChineseRemainder<RatCRABase> {
+		typedef typename RatCRABase::Domain		Domain;
+		typedef typename RatCRABase::DomainElement	DomainElement;
+		typedef RationalChineseRemainder<RatCRABase>	Father_t;
+
+	protected:
+		size_t _numThreads;
+
+	public:
+		template<class Param>
+		RationalChineseRemainderParallel(const Param& b, size_t numThreads = NUM_THREADS) :
+			Father_t(b), _numThreads(numThreads)
+		{ }
+
+		/** \brief The parallel Rational CRA loop.
+		 *
+		 * \param Iteration  Function object of two arguments, \c Iteration(r, D),
+		 * given prime field \p D it outputs residue(s) \p r.
+		 * \p Iteration must be reentrant and thread safe.
+		 *
+		 * \param genprime  RandIter object for generating primes.
+		 * \param[out] num  the rational numerator
+		 * \param[out] den  the rational denominator
+		 */
+		template<class Function, class RandPrimeIterator>
+		BlasVector<Givaro::ZRing<Integer> > & operator() (BlasVector<Givaro::ZRing<Integer> >& num, Integer& den, Function& Iteration, RandPrimeIterator& genprime)
+		{
+			size_t NN = _numThreads;
+			if (NN <= 1) return Father_t::operator()(num, den, Iteration, genprime);
+
+			std::vector<Domain> ROUNDdomains; ROUNDdomains.reserve(NN);
+			std::vector<BlasVector<Domain> > ROUNDresidues; ROUNDresidues.reserve(NN);
+			std::vector<std::exception_ptr> ROUNDerrors(NN);
+			std::set<Integer> coprimeset;
+			bool initialized = this->template resume<BlasVector<Givaro::ZRing<Integer> > >();
+
+			while (! initialized || ! this->Builder_.terminated()) {
+				ROUNDdomains.clear();
+				ROUNDresidues.clear();
+				coprimeset.clear();
+
+				while (coprimeset.size() < NN) {
+					++genprime;
+					if (initialized && this->Builder_.noncoprime(*genprime)) continue;
+					coprimeset.emplace(*genprime);
+				}
+
+				// @note Domains are reserved beforehand so that residues
+				// keep a valid reference to their field.
+				for (const auto& p : coprimeset) {
+					ROUNDdomains.emplace_back(p);
+					ROUNDresidues.emplace_back(ROUNDdomains.back());
+				}
+
+				// The tasks report to their own commentator, the global one is not thread safe.
+				// An exception must not leave a task: it is kept and thrown again by the caller thread.
+				SYNCH_GROUP(
+				for (size_t i = 0; i < NN; ++i) {
+				{ TASK(MODE(CONSTREFERENCE(ROUNDdomains, ROUNDresidues, ROUNDerrors)
+				            WRITE(ROUNDresidues[i], ROUNDerrors[i]) ),
+				{
+					TaskCommentator taskCommentator;
+					try {
+						Iteration(ROUNDresidues[i], ROUNDdomains[i]);
+					}
+					catch (...) {
+						ROUNDerrors[i] = std::current_exception();
+					}
+				})}
+				}
+				)
+				for (auto& error : ROUNDerrors) {
+					if (error) std::rethrow_exception(error);
+				}
+
+				for (size_t i = 0; i < NN; ++i) {
+					if (! initialized) {
+						this->Builder_.initialize(ROUNDdomains[i], ROUNDresidues[i]);
+						initialized = true;
+					}
+					else {
+						this->Builder_.progress(ROUNDdomains[i], ROUNDresidues[i]);
+					}
+					this->Journal_.record(ROUNDdomains[i], ROUNDresidues[i]);
+				}
+				this->Journal_.commit(0u);
+				this->count(NN);
+			}
+
+			return this->Builder_.result(num, den);
+		}
+	};
+}
+
+// Local Variables:
+// mode: C++
+// tab-width: 4
+// indent-tabs-mode: nil
+// c-basic-offset: 4
+// End:
+// vim:sts=4:sw=4:ts=4:et:sr:cino=>s,f0,{0,g0,(0,\:0,t0,+0,=s
@@ -30,6 +30,9 @@
 
 #include "linbox/integer.h"
 #include "linbox/vector/blas-vector.h"
+#include "linbox/algorithms/cra-domain.h"
+#include "linbox/algorithms/cra-checkpoint.h"
+#include "linbox/util/statistics.h"
 
 namespace LinBox
 {
@@ -58,6 +61,35 @@ namespace LinBox
 		typedef typename RatCRABase::DomainElement	DomainElement;
 	protected:
 		RatCRABase Builder_;
+		CRAJournal Journal_;
+		Statistics* statistics_ = nullptr;
+
+		/** \brief Adds n primes to the statistics, if any.
+		 */
+		void count(size_t n = 1)
+		{
+			if (statistics_ != nullptr) statistics_->primes += n;
+		}
+
+		/** \brief Replays the checkpoint, if any, through the builder.
+		 * \return true if the builder has been initialized.
+		 */
+		template<class ResultType>
+		bool resume()
+		{
+			if (! Journal_.load()) return false;
+
+			bool initialized = false;
+			for (const auto& entry : Journal_.entries()) {
+				Domain D(entry.modulus);
+				auto r = CRAResidue<ResultType,void>::create(D);
+				CRAJournal::assign(D, r, entry);
+				if (! initialized) Builder_.initialize(D, r);
+				else Builder_.progress(D, r);
+				initialized = true;
+			}
+			return initialized;
+		}
 
 	public:
 		template<class Param>
@@ -65,6 +97,24 @@ namespace LinBox
 			Builder_(b)
 		{ }
 
+		/** \brief Enables periodic checkpointing of the loop.
+		 *
+		 * If checkpoint.resume is set and a checkpoint exists,
+		 * the next loop starts from it.
+		 */
+		void setCheckpoint(const Checkpoint& checkpoint)
+		{
+			Journal_.configure(checkpoint);
+		}
+
+		/** \brief Counts the primes of the next loops in statistics,
+		 * the ones of a checkpoint excluded.
+		 */
+		void setStatistics(Statistics* statistics)
+		{
+			statistics_ = statistics;
+		}
+
 		/** \brief The Rational CRA loop.
 
 		  Given a function to generate residues mod a single prime,
@@ -86,17 +136,22 @@ namespace LinBox
 		template<class Function, class RandPrimeIterator>
 		Integer & operator() (Integer& num, Integer& den, Function& Iteration, RandPrimeIterator& genprime)
 		{
-			++genprime;
-			{
+			if (! resume<Integer>()) {
+				++genprime;
 				Domain D(*genprime);
 				DomainElement r; D.init(r);
 				Builder_.initialize( D, Iteration(r, D) );
+				Journal_.record(D, r);
+				count();
 			}
 			while( ! Builder_.terminated() ) {
 				++genprime; while(Builder_.noncoprime(*genprime) ) ++genprime;
 				Domain D(*genprime);
 				DomainElement r; D.init(r);
 				Builder_.progress( D, Iteration(r, D) );
+				Journal_.record(D, r);
+				Journal_.commit(0u);
+				count();
 			}
 			return Builder_.result(num, den);
 		}
@@ -124,17 +179,22 @@ namespace LinBox
 		template<class Function, class RandPrimeIterator>
 		BlasVector<Givaro::ZRing<Integer> > & operator() ( BlasVector<Givaro::ZRing<Integer> >& num, Integer& den, Function& Iteration, RandPrimeIterator& genprime)
 		{
-			++genprime;
-			{
+			if (! resume<BlasVector<Givaro::ZRing<Integer> > >()) {
+				++genprime;
 				Domain D(*genprime);
 				BlasVector<Domain > r(D);
 				Builder_.initialize( D, Iteration(r, D) );
+				Journal_.record(D, r);
+				count();
 			}
 			while( ! Builder_.terminated() ) {
 				++genprime; while(Builder_.noncoprime(*genprime) ) ++genprime;
 				Domain D(*genprime);
 				BlasVector<Domain > r(D);
 				Builder_.progress( D, Iteration(r, D) );
+				Journal_.record(D, r);
+				Journal_.commit(0u);
+				count();
 			}
 			return Builder_.result(num, den);
 		}
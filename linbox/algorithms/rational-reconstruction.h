@@ -35,6 +35,7 @@
 
 #include "linbox/linbox-config.h"
 #include "linbox/util/debug.h"
+#include "linbox/util/instrumentation.h"
 
 
 #include "linbox/algorithms/rational-reconstruction-base.h"
@@ -82,7 +83,8 @@ namespace LinBox
 		typedef typename Field::Element                     Element;
 
 #ifdef RSTIMING
-		mutable Timer tRecon, ttRecon;
+		mutable Timer ttRecon;
+		mutable Instrumentation::TracedTimer tRecon{"reconstruction"};
 		mutable int _num_rec;
 #endif
 		// data
@@ -27,6 +27,7 @@
 #ifndef __LINBOX_rational_solver_sn_H
 #define __LINBOX_rational_solver_sn_H
 
+#include <algorithm>
 #include <iostream>
 
 #include "linbox/integer.h"
@@ -49,9 +50,10 @@ namespace LinBox {
 
 	/*
 	 * A NumericSolver has
-	 * init from a matrix A,
+	 * init from a matrix A,			// 0 on success
 	 * solve(double* x, double* b)		// x = A^{-1}b
 	 * apply(double* y, double * x);		// y = Ax
+	 * correctBits()				// number of correct bits of x, from the condition of A
 	 */
 
 	template<class Ring, class NumericSolver>
@@ -136,7 +138,8 @@ namespace LinBox {
 			}
 
 			// build a numeric solver from new double matrix
-			_numsolver.init(DM);
+			if (_numsolver.init(DM) != 0)
+				return SS_FAILED; // numerically singular
 
 			// r is b as vector of doubles.  (r is initial residual)
 			FVector r(field(),n);
@@ -160,7 +163,12 @@ namespace LinBox {
 			size_t mn2 = nextPower2((size_t)mnorm);
 			for(;mn2;mn2>>=1, bits++);
 
-			SHIFT_BOUND -= bits;
+			SHIFT_BOUND = (bits < SHIFT_BOUND) ? SHIFT_BOUND - bits : 0;
+			//  no more bits than the numeric solutions are accurate to
+			SHIFT_BOUND = std::min(SHIFT_BOUND, (size_t)_numsolver.correctBits());
+			//  the shift starts at 2: with less correct bits, no digit can be found
+			if (SHIFT_BOUND < 2)
+				return SS_FAILED; // ill-conditioned
 			//std::cerr << "BITS" << bits << "MAX" << SHIFT_BOUND << std::endl;
 
 			loopBound *= (2*mnorm + zw_dmax((int)n, &*(r.begin()), 1));
@@ -308,7 +308,7 @@ inline void update_r_exact(IVector& r_exact, FVector& r, FVector& xs_int, IMatri
 			_ring.init(y_i[i], y[i]);
 	}
 	else{
-		SHIFT_BOUND--; // to less this possibility
+		if (SHIFT_BOUND > 2) SHIFT_BOUND--; // to less this possibility
 		debugneol("Exact ");
 		for(size_t i = 0; i < n; ++i)
 			_ring.init(x_i[i], xs_int[i]);
@@ -252,9 +252,12 @@ namespace LinBox
 		Method::Wiedemann       _traits;
 
 #ifdef RSTIMING
-		mutable Timer  tNonsingularSetup,   ttNonsingularSetup,
-			tNonsingularMinPoly, ttNonsingularMinPoly,
+		mutable Timer  ttNonsingularSetup,
+			ttNonsingularMinPoly,
 			totalTimer;
+		// the phases are traced as well, see linbox/util/instrumentation.h
+		mutable Instrumentation::TracedTimer tNonsingularSetup{"wiedemann: nonsingular setup"},
+			tNonsingularMinPoly{"wiedemann: nonsingular minpoly"};
 
 		mutable WiedemannTimer   ttNonsingularSolve;
 #endif
@@ -297,6 +300,15 @@ namespace LinBox
 #endif
 		}
 
+		/** Counts in statistics the applies and sequence of the minimal
+		 * polynomial mod p and the lifted digits of solveNonsingular,
+		 * and times these two phases.
+		 */
+		void setStatistics (Statistics* statistics)
+		{
+			_traits.statistics = statistics;
+		}
+
 
 		template<class IMatrix, class Vector1, class Vector2>
 		SolverReturnStatus solve(Vector1& num, Integer& den,
@@ -147,7 +147,11 @@ namespace LinBox
 			tNonsingularMinPoly.clear();
 			tNonsingularMinPoly.start();
 #endif
-			MD.minpoly(MinPoly,deg);
+			{
+				Statistics::Phase phase(_traits.statistics, "wiedemann: minpoly mod p");
+				MD.minpoly(MinPoly,deg);
+				if (_traits.statistics) _traits.statistics->addMassey(Sequence, MD, applyBytes(*Ap));
+			}
 #ifdef RSTIMING
 			tNonsingularMinPoly.stop();
 			ttNonsingularMinPoly+=tNonsingularMinPoly;
@@ -171,10 +175,14 @@ namespace LinBox
 			typedef WiedemannLiftingContainer<Ring, Field, IMatrix, FMatrix, FPolynomial> LiftingContainer;
 
 			LiftingContainer lc(_ring, *F, A, *Ap, MinPoly, b,_prime);
+			lc.setStatistics(_traits.statistics);
 
 			RationalReconstruction<LiftingContainer> re(lc);
 
-			re.getRational(num, den, 0);
+			{
+				Statistics::Phase phase(_traits.statistics, "wiedemann: lifting and reconstruction");
+				re.getRational(num, den, 0);
+			}
 #ifdef RSTIMING
 			ttNonsingularSolve.update(re, lc);
 #endif
@@ -27,6 +27,9 @@
 #define __LINBOX_pp_gauss_H
 
 #include <map>
+#include <cstdint>
+#include <type_traits>
+#include <vector>
 #include <givaro/givconfig.h> // for Signed_Trait
 #include "linbox/solutions/smith-form.h"
 #include "linbox/algorithms/gauss.h"
@@ -52,6 +55,18 @@
 #  endif
 #endif
 
+// LINBOX_pp_gauss_PARALLEL_ROWS is the minimal number of rows
+// eliminated by a pivot for the row updates to be done in parallel
+#ifndef LINBOX_pp_gauss_PARALLEL_ROWS
+#  define LINBOX_pp_gauss_PARALLEL_ROWS 256
+#endif
+
+// LINBOX_pp_gauss_INVERSE_TABLE is the largest prime
+// whose inverses are all tabulated before the elimination
+#ifndef LINBOX_pp_gauss_INVERSE_TABLE
+#  define LINBOX_pp_gauss_INVERSE_TABLE 65536
+#endif
+
 
 namespace LinBox
 {
@@ -64,6 +79,80 @@ namespace LinBox
         typedef float BooleanType;// float does not matter, only that it differs from int
     };
 
+    namespace Protected {
+            /** \brief Arithmetic modulo a prime power \f$q < 2^{32}\f$.
+             *
+             * Products of residues fit a 64-bit word.
+             * The products by the eliminating coefficient of a row
+             * use its precomputed Barrett quotient (Shoup's trick):
+             * one multiplication, one high product and one correction,
+             * without any division.
+             */
+        struct LocalModulus32 {
+            uint64_t q;
+            explicit LocalModulus32(uint64_t m) : q(m) {}
+
+            uint64_t mul(uint64_t a, uint64_t b) const { return (a*b) % q; }
+            uint64_t add(uint64_t a, uint64_t b) const { const uint64_t r(a+b); return (r >= q) ? r-q : r; }
+                // floor(w 2^32 / q), for w < q
+            uint64_t precompute(uint64_t w) const { return (w << 32) / q; }
+                // w b mod q, for b < q, with wp = precompute(w)
+            uint64_t mulprecomp(uint64_t w, uint64_t wp, uint64_t b) const {
+                const uint64_t r( w*b - ((wp*b) >> 32)*q );
+                return (r >= q) ? r-q : r;
+            }
+        };
+
+#ifdef __SIZEOF_INT128__
+            /** \brief Arithmetic modulo a prime power \f$q < 2^{63}\f$.
+             *
+             * As \ref LocalModulus32, with 128-bit high products.
+             */
+        struct LocalModulus64 {
+            uint64_t q;
+            explicit LocalModulus64(uint64_t m) : q(m) {}
+
+            uint64_t mul(uint64_t a, uint64_t b) const { return (uint64_t)( ((unsigned __int128)a*b) % q ); }
+            uint64_t add(uint64_t a, uint64_t b) const { const uint64_t r(a+b); return (r >= q) ? r-q : r; }
+                // floor(w 2^64 / q), for w < q
+            uint64_t precompute(uint64_t w) const { return (uint64_t)( ((unsigned __int128)w << 64) / q ); }
+                // w b mod q, for b < q, with wp = precompute(w)
+            uint64_t mulprecomp(uint64_t w, uint64_t wp, uint64_t b) const {
+                const uint64_t r( w*b - (uint64_t)( ((unsigned __int128)wp*b) >> 64 )*q );
+                return (r >= q) ? r-q : r;
+            }
+        };
+#endif
+
+            /** \brief Inverses of all the units modulo a small prime.
+             *
+             * They are computed at once, in linear time, by
+             * \f$1/i = -\lfloor p/i \rfloor / (p \bmod i)\f$,
+             * so that inverting a pivot is a lookup and a few Newton steps.
+             * Empty for primes larger than \c LINBOX_pp_gauss_INVERSE_TABLE.
+             */
+        struct LocalInverses {
+            uint64_t p = 0;
+            std::vector<uint32_t> table;
+
+            void init(uint64_t prime) {
+                p = prime;
+                table.resize(0);
+                if ( (prime < 2) || (prime > LINBOX_pp_gauss_INVERSE_TABLE) ) return;
+                table.resize(prime);
+                table[1] = 1U;
+                for(uint64_t i=2; i<prime; ++i)
+                    table[i] = (uint32_t)( prime - ((prime/i) * table[prime%i]) % prime );
+            }
+        };
+
+            /// Whether the elimination can use the word-size arithmetic
+        template<class Modulo, class Element>
+        struct IsWordLocal : public std::integral_constant<bool,
+            std::is_integral<Modulo>::value && std::is_integral<Element>::value
+            && (sizeof(Modulo) <= 8) && (sizeof(Element) <= 8)> {};
+    }
+
     enum {
             // Combine these in binary for use in StaticParameters
         PRIVILEGIATE_NO_COLUMN_PIVOTING	= 1,
@@ -73,6 +162,13 @@ namespace LinBox
 
         /** \brief Repository of functions for rank modulo 
          * a prime power by elimination on sparse matrices.
+         *
+         * When the modulus and the elements are machine integers and
+         * \f$p^e < 2^{32}\f$ (resp. \f$2^{63}\f$), the row updates
+         * avoid divisions (see \ref Protected::LocalModulus32),
+         * the pivots are inverted with a table of the inverses modulo \f$p\f$
+         * and the rows below a pivot are updated in parallel
+         * when there are more than \c LINBOX_pp_gauss_PARALLEL_ROWS of them.
          */
 	template <class _Field>
 	class PowerGaussDomain : public GaussDomain<_Field> {
@@ -156,6 +252,22 @@ namespace LinBox
                 return v1;
             }
 
+            // Inverse modulo q=p^e of a unit a < q,
+            // from its inverse modulo p by Newton iteration
+        template<class Reduction>
+        uint64_t MY_Zpz_inv_word(const Reduction& R, uint64_t a, const Protected::LocalInverses& inverses, uint64_t exponent) const
+            {
+                uint64_t v;
+                if (inverses.table.size())
+                    v = inverses.table[a % inverses.p];
+                else
+                    MY_Zpz_inv_classic(v, a % inverses.p, inverses.p);
+                    // v <- v (2 - a v), doubles the p-adic precision
+                for(uint64_t precision=1; precision<exponent; precision<<=1)
+                    v = R.mul(v, R.add(R.q - R.mul(a, v), 2U % R.q));
+                return v;
+            }
+
 		template<class Ring1, class Ring2>
 		bool MY_divides(Ring1 a, Ring2 b) const
             {
@@ -411,6 +523,137 @@ namespace LinBox
 			}
 		}
 
+        template<class De>
+        static void decColumn(De& columns, size_t j, std::false_type) { --columns[j]; }
+        template<class De>
+        static void incColumn(De& columns, size_t j, std::false_type) { ++columns[j]; }
+
+            // Concurrent row updates share the column densities
+        template<class De>
+        static void decColumn(De& columns, size_t j, std::true_type) {
+#ifdef __LINBOX_USE_OPENMP
+#pragma omp atomic
+#endif
+            --columns[j];
+        }
+        template<class De>
+        static void incColumn(De& columns, size_t j, std::true_type) {
+#ifdef __LINBOX_USE_OPENMP
+#pragma omp atomic
+#endif
+            ++columns[j];
+        }
+
+            // FaireElimination with word-size arithmetic modulo R.q
+		template<class Reduction, class Vecteur, class De, class Concurrent>
+		void FaireEliminationWord( const Reduction& R,
+                                   Vecteur& lignecourante,
+                                   const Vecteur& lignepivot,
+                                   const uint64_t invpiv,
+                                   const size_t& k,
+                                   De& columns,
+                                   Concurrent concurrent) {
+			typedef typename Field::Element F;
+			typedef typename Vecteur::value_type E;
+
+			size_t nj = (size_t)  lignecourante.size() ;
+			if (nj && (lignecourante[0].first == k)) {
+                size_t npiv = (size_t) lignepivot.size();
+                Vecteur construit(nj + npiv);
+                typename Vecteur::iterator ci = construit.begin();
+                size_t m=1;
+                size_t l(0);
+
+                const uint64_t headcoeff( R.mul(R.q - (uint64_t)lignecourante[0].second, invpiv) );
+                const uint64_t headprecomp( R.precompute(headcoeff) );
+                lignecourante[0].second = (F)headcoeff;
+                decColumn(columns, lignecourante[0].first, concurrent);
+
+                for(;l<npiv;++l)
+                    if (lignepivot[(size_t)l].first > k) break;
+                for(;l<npiv;++l) {
+                    const size_t j_piv = (size_t) lignepivot[(size_t)l].first;
+                    for (;(m<nj) && (lignecourante[(size_t)m].first < j_piv);)
+                        *ci++ = lignecourante[(size_t)m++];
+                    const uint64_t tmp( R.mulprecomp(headcoeff, headprecomp, (uint64_t)lignepivot[(size_t)l].second) );
+                    if ((m<nj) && (lignecourante[(size_t)m].first == j_piv)) {
+                        const uint64_t sum( R.add((uint64_t)lignecourante[(size_t)m].second, tmp) );
+                        if (sum) {
+                            lignecourante[(size_t)m].second = (F)sum;
+                            *ci++ = lignecourante[(size_t)m++];
+                        }
+                        else
+                            decColumn(columns, lignecourante[(size_t)m++].first, concurrent);
+                    }
+                    else if (tmp) {
+                        incColumn(columns, j_piv, concurrent);
+                        *ci++ = E(j_piv, (F)tmp);
+                    }
+                }
+                for (;m<nj;)
+                    *ci++ = lignecourante[(size_t)m++];
+
+                construit.erase(ci,construit.end());
+                lignecourante = std::move(construit);
+			}
+		}
+
+		template<class Modulo>
+        void InitInverses(Protected::LocalInverses&, const Modulo&, std::false_type) {}
+
+		template<class Modulo>
+        void InitInverses(Protected::LocalInverses& inverses, const Modulo& PRIME, std::true_type) {
+            inverses.init((uint64_t)PRIME);
+        }
+
+            // Eliminates, below row k, the column currentrank
+		template<class Modulo, class BB, class D>
+        void EliminationStep(Modulo MOD, Modulo PRIME, uint64_t exponent, const Protected::LocalInverses&, BB& LigneA, const size_t k, const size_t Ni, const size_t currentrank, const long c, D& col_density, std::false_type) {
+            typedef typename Signed_Trait<Modulo>::unsigned_type UModulo;
+            UModulo invpiv;
+            MY_Zpz_inv(invpiv, LigneA[(size_t)k][0].second, PRIME, MOD, exponent);
+
+            for(size_t l=k + 1; (l < Ni) && (col_density[currentrank]); ++l)
+                FaireElimination(MOD, LigneA[(size_t)l], LigneA[(size_t)k], invpiv, currentrank, c, col_density);
+        }
+
+		template<class Modulo, class BB, class D>
+        void EliminationStep(Modulo MOD, Modulo PRIME, uint64_t exponent, const Protected::LocalInverses& inverses, BB& LigneA, const size_t k, const size_t Ni, const size_t currentrank, const long c, D& col_density, std::true_type) {
+            const uint64_t q( (uint64_t)MOD );
+            if (q < (uint64_t(1) << 32))
+                EliminationStepWord(Protected::LocalModulus32(q), exponent, inverses, LigneA, k, Ni, currentrank, col_density);
+#ifdef __SIZEOF_INT128__
+            else if (q < (uint64_t(1) << 63))
+                EliminationStepWord(Protected::LocalModulus64(q), exponent, inverses, LigneA, k, Ni, currentrank, col_density);
+#endif
+            else
+                EliminationStep(MOD, PRIME, exponent, inverses, LigneA, k, Ni, currentrank, c, col_density, std::false_type());
+        }
+
+		template<class Reduction, class BB, class D>
+        void EliminationStepWord(const Reduction& R, uint64_t exponent, const Protected::LocalInverses& inverses, BB& LigneA, const size_t k, const size_t Ni, const size_t currentrank, D& col_density) {
+            const typename BB::Row& lignepivot = LigneA[(size_t)k];
+            const uint64_t invpiv( MY_Zpz_inv_word(R, (uint64_t)lignepivot[0].second, inverses, exponent) );
+
+            if (col_density[currentrank] < LINBOX_pp_gauss_PARALLEL_ROWS) {
+                for(size_t l=k + 1; (l < Ni) && (col_density[currentrank]); ++l)
+                    FaireEliminationWord(R, LigneA[(size_t)l], lignepivot, invpiv, currentrank, col_density, std::false_type());
+            } else {
+                    // The rows to update are independent:
+                    // only the column densities are shared
+                std::vector<size_t> rows; rows.reserve(col_density[currentrank]);
+                for(size_t l=k + 1; (l < Ni) && (rows.size() < col_density[currentrank]); ++l)
+                    if (LigneA[(size_t)l].size() && (LigneA[(size_t)l][0].first == currentrank))
+                        rows.push_back(l);
+                const long nrows( (long)rows.size() );
+#ifdef __LINBOX_USE_OPENMP
+#pragma omp parallel for schedule(dynamic,16)
+#endif
+                for(long i=0; i<nrows; ++i)
+                    FaireEliminationWord(R, LigneA[rows[(size_t)i]], lignepivot, invpiv, currentrank, col_density, std::true_type());
+            }
+        }
+
             // ------------------------------------------------------
             // Rank calculators, defining row strategy
             // ------------------------------------------------------
@@ -427,7 +670,6 @@ namespace LinBox
                 ranks.resize(0);
 
                 typedef typename BB::Row Vecteur;
-                typedef typename Signed_Trait<Modulo>::unsigned_type UModulo;
 
                 Modulo MOD = FMOD;
                 uint64_t exponent(1);
@@ -442,6 +684,10 @@ namespace LinBox
 
                 D col_density(Nj);
 
+                typedef typename Protected::IsWordLocal<Modulo,Element>::type WordTag;
+                Protected::LocalInverses inverses;
+                InitInverses(inverses, PRIME, WordTag());
+
                     // assignment of LigneA with the domain object
                 size_t jj;
                 for(jj=0; jj<Ni; ++jj) {
@@ -538,11 +784,7 @@ namespace LinBox
 							PermuteSubMatrix(LigneA, k+1, Ni, currentrank, c);
                         }
 
-                        UModulo invpiv; 
-                        MY_Zpz_inv(invpiv, LigneA[(size_t)k][0].second, PRIME, MOD, exponent);
-
-                        for(size_t l=k + 1; (l < Ni) && (col_density[currentrank]); ++l)
-                            FaireElimination(MOD, LigneA[(size_t)l], LigneA[(size_t)k], invpiv, currentrank, c, col_density);
+                        EliminationStep(MOD, PRIME, exponent, inverses, LigneA, k, Ni, currentrank, c, col_density, WordTag());
                     }
                 
 
@@ -39,11 +39,15 @@
 #include <linbox/solutions/smith-form.h>
 #include <linbox/solutions/valence.h>
 #include <linbox/algorithms/smith-form-sparseelim-local.h>
+#include <linbox/algorithms/multi-prime-valence.h>
 #include <linbox/util/matrix-stream.h>
 #include <linbox/util/timer.h>
 #include <linbox/util/error.h>
 
+#include <memory>
 #include <string>
+#include <type_traits>
+#include <vector>
 
 #ifndef __VALENCE_FACTOR_LOOPS__
 #define __VALENCE_FACTOR_LOOPS__ 50000
@@ -64,13 +68,100 @@
 
 namespace LinBox {
 
-template<class Field>
-size_t& TempLRank(size_t& r, const char * filename, const Field& F)
+namespace Protected {
+    /**
+     * Restricts the rank steps taking a matrix source to class types,
+     * so that a file name, \c char* or <code>const char*</code>,
+     * goes to the file name overloads.
+     */
+    template<class Source>
+    using IfValenceSource = typename std::enable_if<std::is_class<Source>::value>::type;
+
+    /**
+     * Matrix source of the valence Smith form steps:
+     * the matrix is read again from its file for each modulus.
+     */
+    struct ValenceFileSource {
+        const char * filename;
+
+        ValenceFileSource(const char * f) : filename(f) {}
+
+        template<class Ring>
+        std::unique_ptr<SparseMatrix<Ring,SparseMatrixFormat::SparseSeq> > make(const Ring& R) const
+        {
+            std::ifstream input(filename);
+            MatrixStream< Ring > ms( R, input );
+            std::unique_ptr<SparseMatrix<Ring,SparseMatrixFormat::SparseSeq> > A(new SparseMatrix<Ring,SparseMatrixFormat::SparseSeq>(ms));
+            input.close();
+            return A;
+        }
+
+        std::unique_ptr<ZeroOne<GF2> > make(const GF2& F2) const
+        {
+            std::ifstream input(filename);
+            std::unique_ptr<ZeroOne<GF2> > A(new ZeroOne<GF2>);
+            A->read(input);
+            input.close();
+            return A;
+        }
+    };
+
+    /**
+     * Matrix source of the valence Smith form steps:
+     * the copy modulo each modulus is reduced from an already loaded
+     * integer sparse matrix, row by row, keeping its column indices.
+     *
+     * The integer matrix is only read,
+     * thus it is shared by all the parallel tasks.
+     */
+    template<class IMatrix>
+    struct ValenceMatrixSource {
+        const IMatrix& A;
+
+        ValenceMatrixSource(const IMatrix& M) : A(M) {}
+
+        template<class Ring>
+        std::unique_ptr<SparseMatrix<Ring,SparseMatrixFormat::SparseSeq> > make(const Ring& R) const
+        {
+            std::unique_ptr<SparseMatrix<Ring,SparseMatrixFormat::SparseSeq> > Ap(new SparseMatrix<Ring,SparseMatrixFormat::SparseSeq>(R, A.rowdim(), A.coldim()));
+            typename Ring::Element e; R.init(e);
+            auto ap = Ap->rowBegin();
+            for (auto row = A.rowBegin(); row != A.rowEnd(); ++row, ++ap) {
+                ap->reserve(row->size());
+                for (const auto& entry : *row) {
+                    R.init(e, entry.second);
+                    if (! R.isZero(e)) ap->emplace_back(entry.first, e);
+                }
+            }
+            return Ap;
+        }
+
+        std::unique_ptr<ZeroOne<GF2> > make(const GF2& F2) const
+        {
+            std::vector<size_t> rowP, colP;
+            GF2::Element e;
+            size_t i = 0;
+            for (auto row = A.rowBegin(); row != A.rowEnd(); ++row, ++i) {
+                for (const auto& entry : *row) {
+                    F2.init(e, entry.second);
+                    if (! F2.isZero(e)) {
+                        rowP.push_back(i);
+                        colP.push_back(entry.first);
+                    }
+                }
+            }
+            return std::unique_ptr<ZeroOne<GF2> >(
+                new ZeroOne<GF2>(F2, rowP.data(), colP.data(),
+                                 A.rowdim(), A.coldim(), rowP.size(), true, true));
+        }
+    };
+}
+
+template<class Field, class Source>
+size_t& TempLRank(size_t& r, const Source& source, const Field& F)
 {
-	std::ifstream input(filename);
-	MatrixStream< Field > msf( F, input );
-	SparseMatrix<Field,SparseMatrixFormat::SparseSeq> FA(msf);
-	input.close();
+	auto FAp = source.make(F);
+	auto& FA = *FAp;
 	Timer tim; tim.start();
 	rankInPlace(r, FA);
 	tim.stop();
@@ -84,12 +175,11 @@ size_t& TempLRank(size_t& r, const char * filename, const Field& F)
 	return r;
 }
 
-size_t& TempLRank(size_t& r, const char * filename, const GF2& F2)
+template<class Source>
+size_t& TempLRank(size_t& r, const Source& source, const GF2& F2)
 {
-	std::ifstream input(filename);
-	ZeroOne<GF2> A;
-	A.read(input);
-	input.close();
+	auto Ap = source.make(F2);
+	auto& A = *Ap;
 
 	Timer tim; tim.start();
 	rankInPlace(r, A, Method::SparseElimination() );
@@ -104,7 +194,8 @@ size_t& TempLRank(size_t& r, const char * filename, const GF2& F2)
 	return r;
 }
 
-size_t& LRank(size_t& r, const char * filename,Givaro::Integer p)
+template<class Source, class = Protected::IfValenceSource<Source> >
+size_t& LRank(size_t& r, const Source& source, Givaro::Integer p)
 {
 
 	Givaro::Integer maxmod16; FieldTraits<Givaro::Modular<int16_t> >::maxModulus(maxmod16);
@@ -113,37 +204,43 @@ size_t& LRank(size_t& r, const char * filename,Givaro::Integer p)
 	Givaro::Integer maxmod64; FieldTraits<Givaro::Modular<int64_t> >::maxModulus(maxmod64);
 	if (p == 2) {
 		GF2 F2;
-		return TempLRank(r, filename, F2);
+		return TempLRank(r, source, F2);
 	}
 	else if (p <= maxmod16) {
 		typedef Givaro::Modular<int16_t> Field;
 		Field F(p);
-		return TempLRank(r, filename, F);
+		return TempLRank(r, source, F);
 	}
 	else if (p <= maxmod32) {
 		typedef Givaro::Modular<int32_t> Field;
 		Field F(p);
-		return TempLRank(r, filename, F);
+		return TempLRank(r, source, F);
 	}
 	else if (p <= maxmod53) {
 		typedef Givaro::Modular<double> Field;
 		Field F(p);
-		return TempLRank(r, filename, F);
+		return TempLRank(r, source, F);
 	}
 	else if (p <= maxmod64) {
 		typedef Givaro::Modular<int64_t> Field;
 		Field F(p);
-		return TempLRank(r, filename, F);
+		return TempLRank(r, source, F);
 	}
 	else {
 		typedef Givaro::Modular<Givaro::Integer> Field;
 		Field F(p);
-		return TempLRank(r, filename, F);
+		return TempLRank(r, source, F);
 	}
 	return r;
 }
 
-std::vector<size_t>& PRank(std::vector<size_t>& ranks, size_t& effective_exponent, const char * filename,Givaro::Integer p, size_t e, size_t intr)
+inline size_t& LRank(size_t& r, const char * filename, Givaro::Integer p)
+{
+    return LRank(r, Protected::ValenceFileSource(filename), p);
+}
+
+template<class Source, class = Protected::IfValenceSource<Source> >
+std::vector<size_t>& PRank(std::vector<size_t>& ranks, size_t& effective_exponent, const Source& source, Givaro::Integer p, size_t e, size_t intr)
 {
 #if __LB_VALENCE_REPORTING__
     std::ostringstream logreport;
@@ -183,10 +280,8 @@ std::vector<size_t>& PRank(std::vector<size_t>& ranks, size_t& effective_exponen
 #endif
 		}
 		Ring F(lq);
-		std::ifstream input(filename);
-		MatrixStream<Ring> ms( F, input );
-		SparseMatrix<Ring,SparseMatrixFormat::SparseSeq > A (ms);
-		input.close();
+		auto Ap = source.make(F);
+		auto& A = *Ap;
 
 		PowerGaussDomain< Ring > PGD( F );
         Permutation<Ring> Q(F,A.coldim());
@@ -222,7 +317,8 @@ std::vector<size_t>& PRank(std::vector<size_t>& ranks, size_t& effective_exponen
 
 namespace LinBox {
 
-std::vector<size_t>& PRankPowerOfTwo(std::vector<size_t>& ranks, size_t& effective_exponent, const char * filename, size_t e, size_t intr)
+template<class Source, class = Protected::IfValenceSource<Source> >
+std::vector<size_t>& PRankPowerOfTwo(std::vector<size_t>& ranks, size_t& effective_exponent, const Source& source, size_t e, size_t intr)
 {
 #if __LB_VALENCE_REPORTING__
     std::ostringstream logreport;
@@ -241,10 +337,8 @@ std::vector<size_t>& PRankPowerOfTwo(std::vector<size_t>& ranks, size_t& effecti
 
 	typedef Givaro::ZRing<int64_t> Ring;
 	Ring F;
-	std::ifstream input(filename);
-	MatrixStream<Ring> ms( F, input );
-	SparseMatrix<Ring,SparseMatrixFormat::SparseSeq > A (ms);
-	input.close();
+	auto Ap = source.make(F);
+	auto& A = *Ap;
 	PowerGaussDomainPowerOfTwo< uint64_t > PGD;
     GF2 F2;
     Permutation<GF2> Q(F2,A.coldim());
@@ -263,15 +357,14 @@ std::vector<size_t>& PRankPowerOfTwo(std::vector<size_t>& ranks, size_t& effecti
 	return ranks;
 }
 
-std::vector<size_t>& PRankInteger(std::vector<size_t>& ranks, const char * filename,Givaro::Integer p, size_t e, size_t intr)
+template<class Source, class = Protected::IfValenceSource<Source> >
+std::vector<size_t>& PRankInteger(std::vector<size_t>& ranks, const Source& source, Givaro::Integer p, size_t e, size_t intr)
 {
 	typedef Givaro::Modular<Givaro::Integer> Ring;
 	Givaro::Integer q = pow(p,uint64_t(e));
 	Ring F(q);
-	std::ifstream input(filename);
-	MatrixStream<Ring> ms( F, input );
-	SparseMatrix<Ring,SparseMatrixFormat::SparseSeq > A (ms);
-	input.close();
+	auto Ap = source.make(F);
+	auto& A = *Ap;
 	PowerGaussDomain< Ring > PGD( F );
     Permutation<Ring> Q(F,A.coldim());
 
@@ -290,14 +383,13 @@ std::vector<size_t>& PRankInteger(std::vector<size_t>& ranks, const char * filen
 	return ranks;
 }
 
-std::vector<size_t>& PRankIntegerPowerOfTwo(std::vector<size_t>& ranks, const char * filename, size_t e, size_t intr)
+template<class Source, class = Protected::IfValenceSource<Source> >
+std::vector<size_t>& PRankIntegerPowerOfTwo(std::vector<size_t>& ranks, const Source& source, size_t e, size_t intr)
 {
 	typedef Givaro::ZRing<Givaro::Integer> Ring;
 	Ring ZZ;
-	std::ifstream input(filename);
-	MatrixStream<Ring> ms( ZZ, input );
-	SparseMatrix<Ring,SparseMatrixFormat::SparseSeq > A (ms);
-	input.close();
+	auto Ap = source.make(ZZ);
+	auto& A = *Ap;
 	PowerGaussDomainPowerOfTwo< Givaro::Integer > PGD;
     Permutation<Ring> Q(ZZ, A.coldim());
 
@@ -316,16 +408,38 @@ std::vector<size_t>& PRankIntegerPowerOfTwo(std::vector<size_t>& ranks, const ch
 }
 
 
+inline std::vector<size_t>& PRank(std::vector<size_t>& ranks, size_t& effective_exponent, const char * filename, Givaro::Integer p, size_t e, size_t intr)
+{
+    return PRank(ranks, effective_exponent, Protected::ValenceFileSource(filename), p, e, intr);
+}
+
+inline std::vector<size_t>& PRankPowerOfTwo(std::vector<size_t>& ranks, size_t& effective_exponent, const char * filename, size_t e, size_t intr)
+{
+    return PRankPowerOfTwo(ranks, effective_exponent, Protected::ValenceFileSource(filename), e, intr);
+}
+
+inline std::vector<size_t>& PRankInteger(std::vector<size_t>& ranks, const char * filename, Givaro::Integer p, size_t e, size_t intr)
+{
+    return PRankInteger(ranks, Protected::ValenceFileSource(filename), p, e, intr);
+}
+
+inline std::vector<size_t>& PRankIntegerPowerOfTwo(std::vector<size_t>& ranks, const char * filename, size_t e, size_t intr)
+{
+    return PRankIntegerPowerOfTwo(ranks, Protected::ValenceFileSource(filename), e, intr);
+}
+
+
 typedef std::pair<Givaro::Integer,size_t> PairIntRk;
 
 
+template<class Source, class = Protected::IfValenceSource<Source> >
 std::vector<size_t>& AllPowersRanks(
     std::vector<size_t>& ranks,
     const Givaro::Integer& squarefreePrime,// smith[j].first
     const size_t& squarefreeRank,// smith[j].second
     const size_t& exponentBound,	// exponents[j]
     const size_t& coprimeRank,		// coprimeR
-    const char * filename) {		// argv[1]
+    const Source& source) {		// file or loaded matrix
 
     if (squarefreeRank != coprimeRank) {
 
@@ -335,16 +449,16 @@ std::vector<size_t>& AllPowersRanks(
                 // See if a not too small, not too large exponent would work
                 // Usually, closest to word size
             if (squarefreePrime == 2)
-                PRankPowerOfTwo(ranks, effexp, filename, exponentBound, coprimeRank);
+                PRankPowerOfTwo(ranks, effexp, source, exponentBound, coprimeRank);
             else
-                PRank(ranks, effexp, filename, squarefreePrime, exponentBound, coprimeRank);
+                PRank(ranks, effexp, source, squarefreePrime, exponentBound, coprimeRank);
         } else {
                 // Square does not divide valence
                 // Try first with the smallest possible exponent: 2
             if (squarefreePrime == 2)
-                PRankPowerOfTwo(ranks, effexp, filename, 2, coprimeRank);
+                PRankPowerOfTwo(ranks, effexp, source, 2, coprimeRank);
             else
-                PRank(ranks, effexp, filename, squarefreePrime, 2, coprimeRank);
+                PRank(ranks, effexp, source, squarefreePrime, 2, coprimeRank);
         }
 
         if (effexp < exponentBound) {
@@ -352,18 +466,18 @@ std::vector<size_t>& AllPowersRanks(
                 // try successive doublings Over abitrary precision
             for(size_t expo = effexp<<1; ranks.back() < coprimeRank; expo<<=1) {
                 if (squarefreePrime == 2)
-                    PRankIntegerPowerOfTwo(ranks, filename, expo, coprimeRank);
+                    PRankIntegerPowerOfTwo(ranks, source, expo, coprimeRank);
                 else
-                    PRankInteger(ranks, filename, squarefreePrime, expo, coprimeRank);
+                    PRankInteger(ranks, source, squarefreePrime, expo, coprimeRank);
             }
         } else {
                 // Larger exponents are needed
                 // Try first small precision, then arbitrary
             for(size_t expo = (exponentBound)<<1; ranks.back() < coprimeRank; expo<<=1) {
                 if (squarefreePrime == 2)
-                    PRankPowerOfTwo(ranks, effexp, filename, expo, coprimeRank);
+                    PRankPowerOfTwo(ranks, effexp, source, expo, coprimeRank);
                 else
-                    PRank(ranks, effexp, filename, squarefreePrime, expo, coprimeRank);
+                    PRank(ranks, effexp, source, squarefreePrime, expo, coprimeRank);
                 if (ranks.size() < expo) {
 #if __LB_VALENCE_REPORTING__
                     {
@@ -372,9 +486,9 @@ std::vector<size_t>& AllPowersRanks(
 #endif
                         // break;
                     if (squarefreePrime == 2)
-                        PRankIntegerPowerOfTwo(ranks, filename, expo, coprimeRank);
+                        PRankIntegerPowerOfTwo(ranks, source, expo, coprimeRank);
                     else
-                        PRankInteger(ranks, filename, squarefreePrime, expo, coprimeRank);
+                        PRankInteger(ranks, source, squarefreePrime, expo, coprimeRank);
                 }
             }
         }
@@ -383,6 +497,16 @@ std::vector<size_t>& AllPowersRanks(
     return ranks;
 }
 
+inline std::vector<size_t>& AllPowersRanks(
+    std::vector<size_t>& ranks,
+    const Givaro::Integer& squarefreePrime,
+    const size_t& squarefreeRank,
+    const size_t& exponentBound,
+    const size_t& coprimeRank,
+    const char * filename) {
+    return AllPowersRanks(ranks, squarefreePrime, squarefreeRank, exponentBound, coprimeRank, Protected::ValenceFileSource(filename));
+}
+
 std::vector<Givaro::Integer>& populateSmithForm(
     std::vector<Givaro::Integer>& SmithDiagonal,
     const std::vector<size_t>& ranks,
@@ -403,16 +527,37 @@ std::vector<Givaro::Integer>& populateSmithForm(
     return SmithDiagonal;
 }
 
+namespace Protected {
+    // Integer valence of a blackbox: one prime at a time
 template<class Blackbox>
+Givaro::Integer& integerValence(Givaro::Integer& valence, const Blackbox& A, size_t method)
+{
+    return squarizeValence(valence, A, method);
+}
+
+    // Integer valence of a sparse matrix: __LB_VALENCE_LANES__ primes per pass
+template<class Ring>
+Givaro::Integer& integerValence(Givaro::Integer& valence,
+                                const SparseMatrix<Ring,SparseMatrixFormat::SparseSeq>& A,
+                                size_t method)
+{
+#if __LB_VALENCE_LANES__ > 1
+    return multiPrimeValence(valence, A, method, __LB_VALENCE_LANES__);
+#else
+    return squarizeValence(valence, A, method);
+#endif
+}
+
+template<class Blackbox, class Source>
 std::vector<Givaro::Integer>& smithValence(std::vector<Givaro::Integer>& SmithDiagonal,
                                            Givaro::Integer& valence,
                                            const Blackbox& A,
-                                           const std::string& filename,
+                                           const Source& source,
                                            Givaro::Integer& coprimeV,
-                                           size_t method=0) {
+                                           size_t method) {
         // method for valence squarization:
 		//	0 for automatic, 1 for aat, 2 for ata
-        // Blackbox provides the Integer matrix rereadable from filename
+        // source provides the matrix modulo each prime power
         // if valence != 0:
 		//	then the valence is not computed and the parameter is used
         // if coprimeV != 1:
@@ -423,7 +568,7 @@ std::vector<Givaro::Integer>& smithValence(std::vector<Givaro::Integer>& SmithDi
 #endif
 
     if (valence == 0) {
-        squarizeValence(valence, A, method);
+        integerValence(valence, A, method);
     }
 
 #if __LB_VALENCE_REPORTING__
@@ -461,26 +606,26 @@ std::vector<Givaro::Integer>& smithValence(std::vector<Givaro::Integer>& SmithDi
     std::vector<std::vector<size_t> > AllRanks(Moduli.size());
 
     for(size_t j=0; j<Moduli.size(); ++j) {
-        { TASK(MODE(CONSTREFERENCE(Moduli,smith,filename) WRITE(smith[j]) ),
+        { TASK(MODE(CONSTREFERENCE(Moduli,smith,source) WRITE(smith[j]) ),
         {
-            LRank(smith[j], filename.c_str(), Moduli[j]);
+            LRank(smith[j], source, Moduli[j]);
         })}
     }
 
-//     { TASK(MODE(CONSTREFERENCE(coprimeV,filename) WRITE(coprimeR) ),
+//     { TASK(MODE(CONSTREFERENCE(coprimeV,source) WRITE(coprimeR) ),
 //     {
-        LRank(coprimeR, filename.c_str(), coprimeV);
+        LRank(coprimeR, source, coprimeV);
 //     })}
 
     WAIT;
 
     SYNCH_GROUP(
         for(size_t j=0; j<Moduli.size(); ++j) {
-            { TASK(MODE(CONSTREFERENCE(smith,Moduli,AllRanks,filename,coprimeR,exponents)
+            { TASK(MODE(CONSTREFERENCE(smith,Moduli,AllRanks,source,coprimeR,exponents)
                         WRITE(AllRanks[j])),
             {
                 AllPowersRanks(AllRanks[j], Moduli[j], smith[j], exponents[j],
-                               coprimeR, filename.c_str());
+                               coprimeR, source);
             })}
         }
     )
@@ -496,6 +641,25 @@ std::vector<Givaro::Integer>& smithValence(std::vector<Givaro::Integer>& SmithDi
     return SmithDiagonal;
 }
 
+}
+
+/**
+ * Smith form by the valence method, the matrix being read again from
+ * \p filename for each prime power.
+ */
+template<class Blackbox>
+std::vector<Givaro::Integer>& smithValence(std::vector<Givaro::Integer>& SmithDiagonal,
+                                           Givaro::Integer& valence,
+                                           const Blackbox& A,
+                                           const std::string& filename,
+                                           Givaro::Integer& coprimeV,
+                                           size_t method=0) {
+        // Blackbox provides the Integer matrix rereadable from filename
+    return Protected::smithValence(SmithDiagonal, valence, A,
+                                   Protected::ValenceFileSource(filename.c_str()),
+                                   coprimeV, method);
+}
+
 template<class Blackbox>
 std::vector<Givaro::Integer>& smithValence(
     std::vector<Givaro::Integer>& SmithDiagonal,
@@ -509,6 +673,38 @@ std::vector<Givaro::Integer>& smithValence(
 }
 
 
+/**
+ * Smith form by the valence method of an already loaded integer matrix.
+ *
+ * The matrix is parsed once by the caller: the copy modulo each prime power
+ * is reduced from \p A, which is shared read-only by the parallel tasks.
+ * @see smithValence(SmithDiagonal, valence, A, filename, coprimeV, method)
+ * for the meaning of \p valence, \p coprimeV and \p method.
+ */
+template<class Ring>
+std::vector<Givaro::Integer>& smithValence(std::vector<Givaro::Integer>& SmithDiagonal,
+                                           Givaro::Integer& valence,
+                                           const SparseMatrix<Ring,SparseMatrixFormat::SparseSeq>& A,
+                                           Givaro::Integer& coprimeV,
+                                           size_t method=0) {
+    typedef SparseMatrix<Ring,SparseMatrixFormat::SparseSeq> IMatrix;
+    return Protected::smithValence(SmithDiagonal, valence, A,
+                                   Protected::ValenceMatrixSource<IMatrix>(A),
+                                   coprimeV, method);
+}
+
+template<class Ring>
+std::vector<Givaro::Integer>& smithValence(
+    std::vector<Givaro::Integer>& SmithDiagonal,
+    const SparseMatrix<Ring,SparseMatrixFormat::SparseSeq>& A,
+    size_t method=0)
+{
+    Givaro::Integer valence(0);
+    Givaro::Integer coprimeV(1);
+    return smithValence(SmithDiagonal, valence, A, coprimeV, method);
+}
+
+
 template<class PIR>
 std::ostream& writeCompressedSmith(
     std::ostream& out,
@@ -76,6 +76,7 @@
 
 #include "linbox/algorithms/blackbox-container.h"
 #include "linbox/algorithms/blackbox-container-symmetric.h"
+#include "linbox/algorithms/blackbox-container-multi.h"
 
 // massey recurring sequence solver
 #include "linbox/algorithms/massey-domain.h"
@@ -95,8 +96,31 @@ namespace LinBox
 		size_t            seqrank;
 
 		commentator().start ("Wiedemann Minimal polynomial", "minpoly");
+		Statistics::Phase phase (M.statistics, "wiedemann: minpoly");
 
-		if (A.coldim() != A.rowdim()) {
+		if (M.numberOfProjections > 1) {
+			// k projections per apply, the lcm of their generators
+			if (A.coldim() != A.rowdim()) {
+				commentator().report(Commentator::LEVEL_IMPORTANT, INTERNAL_DESCRIPTION) << "Virtually squarize matrix" << std::endl;
+
+				Squarize<Blackbox> B(&A);
+				typedef BlackboxMultiContainer<Field, Squarize<Blackbox> > BBContainerMulti;
+				BBContainerMulti TF (&B, A.field(), M.numberOfProjections, i);
+				MultiMasseyDomain< Field, BBContainerMulti > WD (&TF, M.earlyTerminationThreshold);
+
+				WD.minpoly (P, seqrank);
+				if (M.statistics) M.statistics->addMassey (TF, WD, applyBytes (A));
+			}
+			else {
+				typedef BlackboxMultiContainer<Field, Blackbox> BBContainerMulti;
+				BBContainerMulti TF (&A, A.field(), M.numberOfProjections, i);
+				MultiMasseyDomain< Field, BBContainerMulti > WD (&TF, M.earlyTerminationThreshold);
+
+				WD.minpoly (P, seqrank);
+				if (M.statistics) M.statistics->addMassey (TF, WD, applyBytes (A));
+			}
+		}
+		else if (A.coldim() != A.rowdim()) {
 			commentator().report(Commentator::LEVEL_IMPORTANT, INTERNAL_DESCRIPTION) << "Virtually squarize matrix" << std::endl;
 
 			Squarize<Blackbox> B(&A);
@@ -104,6 +128,7 @@ namespace LinBox
 			MasseyDomain< Field, BlackboxContainer<Field, Squarize<Blackbox> > > WD (&TF, M.earlyTerminationThreshold);
 
 			WD.minpoly (P, seqrank);
+			if (M.statistics) M.statistics->addMassey (TF, WD, applyBytes (A));
 		}
 		else if (M.shapeFlags == Shape::Symmetric) {
 			typedef BlackboxContainerSymmetric<Field, Blackbox> BBContainerSym;
@@ -111,6 +136,7 @@ namespace LinBox
 			MasseyDomain< Field, BBContainerSym > WD (&TF, M.earlyTerminationThreshold);
 
 			WD.minpoly (P, seqrank);
+			if (M.statistics) M.statistics->addMassey (TF, WD, applyBytes (A));
 		}
 		else {
 			typedef BlackboxContainer<Field, Blackbox> BBContainer;
@@ -118,6 +144,7 @@ namespace LinBox
 			MasseyDomain< Field, BBContainer > WD (&TF, M.earlyTerminationThreshold);
 
 			WD.minpoly (P, seqrank);
+			if (M.statistics) M.statistics->addMassey (TF, WD, applyBytes (A));
 #ifdef INCLUDE_TIMING
 			commentator().report (Commentator::LEVEL_IMPORTANT, TIMING_MEASURE)
 			<< "Time required for applies:      " << TF.applyTime () << std::endl;
@@ -60,6 +60,7 @@
 #include "linbox/algorithms/wiedemann.h"
 #include "linbox/blackbox/submatrix.h"
 #include "linbox/blackbox/butterfly.h"
+#include "linbox/blackbox/preconditioned.h"
 #include "linbox/blackbox/transpose.h"
 #include "linbox/algorithms/blackbox-container.h"
 #include "linbox/algorithms/blackbox-container-symmetric.h"
@@ -301,8 +302,7 @@ namespace LinBox
 				typedef Butterfly<Field> ButterflyP;
 				ButterflyP P(field(), A.rowdim ());
 				ButterflyP Q(field(), A.coldim ());
-				Compose< Blackbox, ButterflyP > AQ(&A, &Q);
-				Compose< ButterflyP, Compose< Blackbox, ButterflyP > > PAQ(&P, &AQ);
+				Preconditioned< Blackbox, ButterflyP > PAQ(&P, &A, &Q);
 				commentator().stop ("done");
 
 				sfrs = findRandomSolution (PAQ, x, b, r, &P, &Q);
@@ -320,8 +320,7 @@ namespace LinBox
 
 				Transpose< SparseMatrix<Field> > Q(QT);
 
-				Compose< Blackbox, Transpose< SparseMatrix<Field> > > AQ(&A, &Q);
-				Compose< SparseMatrix<Field>, Compose< Blackbox, Transpose< SparseMatrix<Field> > > > PAQ(P, &AQ);
+				Preconditioned< Blackbox, SparseMatrix<Field>, Transpose< SparseMatrix<Field> > > PAQ(P, &A, &Q);
 				commentator().stop ("done");
 
 				sfrs = findRandomSolution (PAQ, x, b, r, P, &Q);
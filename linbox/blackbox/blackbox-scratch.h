@@ -0,0 +1,159 @@
+/* linbox/blackbox/blackbox-scratch.h
+ * Copyright (C) 2026 The LinBox group
+ *
+ * ========LICENCE========
+ * This file is part of the library LinBox.
+ *
+  * LinBox is free software: you can redistribute it and/or modify
+ * it under the terms of the  GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.	 See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ * ========LICENCE========
+ */
+
+/*! @file blackbox/blackbox-scratch.h
+ * @ingroup blackbox
+ * @brief Scratch storage and fused factors of the blackbox compositions.
+ *
+ * The composition blackboxes (\ref Compose, \ref Sum, \ref BlockCompose, ...)
+ * keep their intermediate vectors and blocks from one apply to the next.
+ * Cheap factors, i.e. diagonals, scalars, butterflies and permutations,
+ * are applied in place on the output of their neighbour instead of
+ * going through an intermediate vector.
+ *
+ * Every composition reports its intermediate storage, recursively,
+ * through \c scratchSize(), in number of field elements,
+ * see \ref blackboxScratchSize.
+ */
+
+#ifndef __LINBOX_blackbox_scratch_H
+#define __LINBOX_blackbox_scratch_H
+
+#include <cstddef>
+#include <type_traits>
+
+namespace LinBox
+{
+	template <class Field, class Switch>
+	class Butterfly;
+
+	template <class Field, class Trait>
+	class Diagonal;
+
+	template <typename Field>
+	class ScalarMatrix;
+
+	template <class Field, class Matrix>
+	class Permutation;
+
+	namespace VectorCategories {
+		struct DenseVectorTag;
+	}
+
+	namespace Protected {
+		/** Whether a blackbox can be applied in place,
+		 * through its \c applyIn and \c applyTransposeIn members.
+		 */
+		template <class Blackbox>
+		struct AppliesInPlace : public std::false_type {};
+
+		template <class Field, class Switch>
+		struct AppliesInPlace<Butterfly<Field, Switch> > : public std::true_type {};
+
+		template <class Field>
+		struct AppliesInPlace<Diagonal<Field, VectorCategories::DenseVectorTag> > : public std::true_type {};
+
+		template <class Field>
+		struct AppliesInPlace<ScalarMatrix<Field> > : public std::true_type {};
+
+		template <class Field, class Matrix>
+		struct AppliesInPlace<Permutation<Field, Matrix> > : public std::true_type {};
+
+		/** Whether a blackbox can accumulate its apply,
+		 * <code>y += A x</code>, without an intermediate vector,
+		 * through its \c applyAddIn and \c applyTransposeAddIn members.
+		 */
+		template <class Blackbox>
+		struct AppliesAddIn : public std::false_type {};
+
+		template <class Field>
+		struct AppliesAddIn<Diagonal<Field, VectorCategories::DenseVectorTag> > : public std::true_type {};
+
+		template <class Field>
+		struct AppliesAddIn<ScalarMatrix<Field> > : public std::true_type {};
+
+		template <class Blackbox>
+		struct HasScratchSize {
+			template <class T>
+			static auto test (const T* t) -> decltype (t->scratchSize (), std::true_type ());
+			static std::false_type test (...);
+
+			static const bool value = decltype (test ((const Blackbox*) nullptr))::value;
+		};
+
+		template <class Blackbox>
+		size_t scratchSize (const Blackbox& A, std::true_type) { return A.scratchSize (); }
+
+		template <class Blackbox>
+		size_t scratchSize (const Blackbox&, std::false_type) { return 0; }
+	}
+
+	/** Intermediate storage used by a blackbox, in number of field elements.
+	 * Blackboxes without a \c scratchSize() member use none.
+	 */
+	template <class Blackbox>
+	size_t blackboxScratchSize (const Blackbox& A)
+	{
+		return Protected::scratchSize (A, std::integral_constant<bool, Protected::HasScratchSize<Blackbox>::value>());
+	}
+
+	/** Intermediate block of a composition,
+	 * kept from one block apply to the next.
+	 *
+	 * The block is reallocated only when the requested shape changes,
+	 * so that iterating block applies with k columns allocates once.
+	 */
+	template <class Block>
+	class BlockScratch {
+	public:
+		template <class Field>
+		Block& get (const Field& F, size_t rows, size_t cols) const
+		{
+			if (_block == nullptr || _block->rowdim () != rows || _block->coldim () != cols) {
+				delete _block;
+				_block = new Block (F, rows, cols);
+			}
+			return *_block;
+		}
+
+		size_t size () const { return (_block == nullptr) ? 0 : _block->rowdim () * _block->coldim (); }
+
+		BlockScratch () {}
+		BlockScratch (const BlockScratch&) {}
+		BlockScratch& operator= (const BlockScratch&) { return *this; }
+		~BlockScratch () { delete _block; }
+
+	protected:
+		mutable Block* _block = nullptr;
+	};
+
+} // namespace LinBox
+
+#endif // __LINBOX_blackbox_scratch_H
+
+// Local Variables:
+// mode: C++
+// tab-width: 4
+// indent-tabs-mode: nil
+// c-basic-offset: 4
+// End:
+// vim:sts=4:sw=4:ts=4:et:sr:cino=>s,f0,{0,g0,(0,\:0,t0,+0,=s
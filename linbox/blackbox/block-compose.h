@@ -28,6 +28,7 @@
 #include "linbox/util/debug.h"
 #include "linbox/linbox-config.h"
 #include "linbox/blackbox/blackbox-interface.h"
+#include "linbox/blackbox/blackbox-scratch.h"
 #include "linbox/vector/blas-vector.h"
 
 #include "linbox/blackbox/blockbb.h"
@@ -93,7 +94,8 @@ public:
 	// Y = A*X
 	template<class Matrix>
 	Matrix& applyLeft(Matrix& Y, const Matrix& X) const {
-		BlasMatrix<Field> Z(_A.field(), _A.rowdim(), X.coldim());
+		// Z = B*X, kept from one call to the next
+		BlasMatrix<Field>& Z = _Z.get(_A.field(), _B.rowdim(), X.coldim());
 		
 		_B.applyLeft(Z, X);
 		_A.applyLeft(Y, Z);
@@ -104,13 +106,22 @@ public:
 	// Y = X*A
 	template<class Matrix>
 	Matrix& applyRight(Matrix& Y, const Matrix& X) const {
-		BlasMatrix<Field> Z(_A.field(), X.rowdim(), _B.coldim());
+		// Z = X*A, kept from one call to the next
+		BlasMatrix<Field>& Z = _Z.get(_A.field(), X.rowdim(), _A.coldim());
 		
 		_A.applyRight(Z, X);
 		_B.applyRight(Y, Z);
 		
 		return Y;
 	}
+
+	/// Intermediate storage, in field elements, including the one of A and B.
+	size_t scratchSize() const {
+		return _Z.size() + blackboxScratchSize(_A) + blackboxScratchSize(_B);
+	}
+
+protected:
+	BlockScratch<BlasMatrix<Field>> _Z;
 };
 
 template<class A, class B>
@@ -159,6 +159,17 @@ namespace LinBox
 		template<class OutVector, class InVector>
 		OutVector& applyTranspose (OutVector& y, const InVector& x) const;
 
+		/** In-place application, <code>y = A*y</code>.
+		 * Applies the switches directly on y, without copying.
+		 */
+		template<class Vector>
+		Vector& applyIn (Vector& y) const;
+
+		/** In-place application of the transpose, <code>y = transpose (A)*y</code>.
+		 */
+		template<class Vector>
+		Vector& applyTransposeIn (Vector& y) const;
+
 		template<typename _Tp1, typename _Sw1 = typename Switch::template rebind<_Tp1>::other>
 		struct rebind {
 			typedef Butterfly<_Tp1, _Sw1> other;
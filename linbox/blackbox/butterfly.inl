@@ -75,12 +75,19 @@ namespace LinBox
 	template <class Field, class Switch>
 	template<class OutVector, class InVector>
 	inline OutVector& Butterfly<Field, Switch>::apply (OutVector& y, const InVector& x) const
+	{
+		_VD.copy (y, x);
+
+		return applyIn (y);
+	}
+
+	template <class Field, class Switch>
+	template<class Vector>
+	inline Vector& Butterfly<Field, Switch>::applyIn (Vector& y) const
 	{
 		std::vector< std::pair<size_t, size_t> >::const_iterator idx_iter = _indices.begin ();
 		typename std::vector<Switch>::const_iterator switch_iter = _switches.begin ();
 
-		_VD.copy (y, x);
-
 		for (; idx_iter != _indices.end (); ++idx_iter, ++switch_iter)
 			switch_iter->apply (field(), y[idx_iter->first], y[idx_iter->second]);
 
@@ -90,12 +97,19 @@ namespace LinBox
 	template <class Field, class Switch>
 	template <class OutVector, class InVector>
 	inline OutVector& Butterfly<Field, Switch>::applyTranspose (OutVector& y, const InVector& x) const
+	{
+		_VD.copy (y, x);
+
+		return applyTransposeIn (y);
+	}
+
+	template <class Field, class Switch>
+	template <class Vector>
+	inline Vector& Butterfly<Field, Switch>::applyTransposeIn (Vector& y) const
 	{
 		std::vector< std::pair<size_t, size_t> >::const_reverse_iterator idx_iter = _indices.rbegin ();
 		typename std::vector<Switch>::const_reverse_iterator switch_iter = _switches.rbegin ();
 
-		_VD.copy (y, x);
-
 		for (; idx_iter != _indices.rend (); ++idx_iter, ++switch_iter)
 			switch_iter->applyTranspose (field(), y[idx_iter->first], y[idx_iter->second]);
 
@@ -31,6 +31,7 @@
 #include "linbox/util/debug.h"
 #include "linbox/linbox-config.h"
 #include "linbox/blackbox/blackbox-interface.h"
+#include "linbox/blackbox/blackbox-scratch.h"
 #include "linbox/vector/blas-vector.h"
 
 namespace LinBox
@@ -87,7 +88,7 @@ namespace LinBox
 			// became depricated.  Makes the assumption that
 			// this vector type supports resize"
 			// VectorWrapper::ensureDim (_z, _A_ptr->coldim ());
-			_z.resize(_A_ptr->coldim());
+			_z.resize(scratchDim());
 		}
 
 		/** Constructor of C := (*A_ptr)*(*B_ptr).
@@ -104,7 +105,7 @@ namespace LinBox
 			linbox_check (A_ptr->coldim () == B_ptr->rowdim ());
 
 			//			VectorWrapper::ensureDim (_z, _A_ptr->coldim ());
-			_z.resize(_A_ptr->coldim());
+			_z.resize(scratchDim());
 		}
 
 		/** Copy constructor.
@@ -115,7 +116,7 @@ namespace LinBox
 		Compose (const Compose<Blackbox1, Blackbox2>& Mat) :
 			_A_ptr ( Mat._A_ptr), _B_ptr ( Mat._B_ptr),_z(Mat.field())
 		{
-			_z.resize(_A_ptr->coldim());
+			_z.resize(scratchDim());
 		}
 
 		/// Destructor
@@ -142,10 +143,8 @@ namespace LinBox
 		template <class OutVector, class InVector>
 		inline OutVector& apply (OutVector& y, const InVector& x) const
 		{
-			if ((_A_ptr != 0) && (_B_ptr != 0)) {
-				_B_ptr->apply (_z, x);
-				_A_ptr->apply (y, _z);
-			}
+			if ((_A_ptr != 0) && (_B_ptr != 0))
+				applyComposed (y, x, Protected::AppliesInPlace<Blackbox1>());
 
 			return y;
 		}
@@ -160,10 +159,8 @@ namespace LinBox
 		template <class OutVector, class InVector>
 		inline OutVector& applyTranspose (OutVector& y, const InVector& x) const
 		{
-			if ((_A_ptr != 0) && (_B_ptr != 0)) {
-				_A_ptr->applyTranspose (_z, x);
-				_B_ptr->applyTranspose (y, _z);
-			}
+			if ((_A_ptr != 0) && (_B_ptr != 0))
+				applyTransposeComposed (y, x, Protected::AppliesInPlace<Blackbox2>());
 
 			return y;
 		}
@@ -229,8 +226,50 @@ namespace LinBox
 			return  _B_ptr;
 		}
 
+		/// Intermediate storage, in field elements, including the one of A and B.
+		size_t scratchSize() const
+		{
+			return _z.size() + blackboxScratchSize(*_A_ptr) + blackboxScratchSize(*_B_ptr);
+		}
+
 	protected:
 
+		// A diagonal, scalar, butterfly or permutation A is applied in place
+		// on the output of B, without the intermediate vector.
+		template <class OutVector, class InVector>
+		void applyComposed (OutVector& y, const InVector& x, std::true_type) const
+		{
+			_B_ptr->apply (y, x);
+			_A_ptr->applyIn (y);
+		}
+
+		template <class OutVector, class InVector>
+		void applyComposed (OutVector& y, const InVector& x, std::false_type) const
+		{
+			_B_ptr->apply (_z, x);
+			_A_ptr->apply (y, _z);
+		}
+
+		template <class OutVector, class InVector>
+		void applyTransposeComposed (OutVector& y, const InVector& x, std::true_type) const
+		{
+			_A_ptr->applyTranspose (y, x);
+			_B_ptr->applyTransposeIn (y);
+		}
+
+		template <class OutVector, class InVector>
+		void applyTransposeComposed (OutVector& y, const InVector& x, std::false_type) const
+		{
+			_A_ptr->applyTranspose (_z, x);
+			_B_ptr->applyTranspose (y, _z);
+		}
+
+		// The intermediate vector is not needed when both sides apply in place.
+		size_t scratchDim() const
+		{
+			return (Protected::AppliesInPlace<Blackbox1>::value && Protected::AppliesInPlace<Blackbox2>::value) ? 0 : _A_ptr->coldim();
+		}
+
 		// Pointers to A and B matrices
 		const Blackbox1 *_A_ptr;
 		const Blackbox2 *_B_ptr;
@@ -279,11 +318,11 @@ namespace LinBox
 			_BlackboxL(v.begin(), v.end())
 		{
 
-			linbox_check(v.size() > 0);
+			linbox_check(v.size() > 1);
 			_zl.clear();
-			// it would be good to use just 2 vectors and flip/flop.
-			for (const auto& b_p : _BlackboxL)
-                _zl.emplace_back( b_p.field(), b_p.coldim());
+			// one intermediate vector between two consecutive factors
+			for (size_t i = 0; i + 1 < _BlackboxL.size(); ++i)
+                _zl.emplace_back( _BlackboxL[i]->field(), _BlackboxL[i]->coldim());
 		}
 
 		~Compose () {}
@@ -297,16 +336,20 @@ namespace LinBox
 			b_p = _BlackboxL.rbegin();
 			pz_p = z_p = _zl.rbegin();
 			typedef DenseSubvector<Field> BSub;
-			BSub pz_p_vec(*pz_p);
 
-			(*b_p) -> apply(pz_p_vec, x);
+			{
+				BSub z_p_vec(*z_p);
+				(*b_p) -> apply(z_p_vec, x);
+			}
 			++ b_p;  ++ z_p;
 
+			// the output of each factor is the input of the next one
 			for (; z_p != _zl.rend(); ++ b_p, ++ z_p, ++ pz_p) {
-				 BSub z_p_vec(*z_p);
+				BSub z_p_vec(*z_p), pz_p_vec(*pz_p);
 				(*b_p) -> apply (z_p_vec,pz_p_vec);
 			}
 
+			BSub pz_p_vec(*pz_p);
 			(*b_p) -> apply(y, pz_p_vec);
 
 			return y;
@@ -324,17 +367,18 @@ namespace LinBox
 		template <class OutVector, class InVector>
 		inline OutVector& applyTranspose (OutVector& y, const InVector& x) const
 		{
-			typename std::vector<const Blackbox*>::reverse_iterator b_p;
-			typename std::vector<std::vector<Element> >::reverse_iterator z_p, nz_p;
+			// (A_1 ... A_k)^T x = A_k^T ... A_1^T x, starting from the front
+			typename std::vector<const Blackbox*>::const_iterator b_p;
+			typename std::vector<DenseVector<Field> >::iterator z_p, nz_p;
 
-			b_p = _BlackboxL.rbegin();
-			z_p = nz_p = _zl.rbegin();
+			b_p = _BlackboxL.begin();
+			z_p = nz_p = _zl.begin();
 
 			(*b_p) -> applyTranspose (*z_p, x);
 
 			++ b_p; ++ nz_p;
 
-			for (; nz_p != _zl.rend(); ++ z_p, ++ nz_p, ++ b_p)
+			for (; nz_p != _zl.end(); ++ z_p, ++ nz_p, ++ b_p)
 				(*b_p) -> applyTranspose (*nz_p, *z_p);
 
 			(*b_p) -> applyTranspose (y, *z_p);
@@ -388,6 +432,15 @@ namespace LinBox
 		const Blackbox* getRightPtr() const
 		{return  _BlackboxL.back();}
 
+		/// Intermediate storage, in field elements, including the one of the factors.
+		size_t scratchSize() const
+		{
+			size_t s = 0;
+			for (const auto& z : _zl) s += z.size();
+			for (const auto& b_p : _BlackboxL) s += blackboxScratchSize(*b_p);
+			return s;
+		}
+
 
 	protected:
 
@@ -134,6 +134,35 @@ namespace LinBox
 		template <class OutVector, class InVector>
 		OutVector &applyTranspose (OutVector &y, const InVector &x) const { return apply (y, x); }
 
+		/// In-place application, <code>y = D*y</code>.
+		template <class Vector>
+		Vector &applyIn (Vector &y) const
+		{
+			linbox_check (_n == y.size ());
+			typename Vector_t::const_iterator v_iter = _v.begin ();
+			for (typename Vector::iterator y_iter = y.begin (); y_iter != y.end (); ++y_iter, ++v_iter)
+				field().mulin (*y_iter, *v_iter);
+			return y;
+		}
+
+		template <class Vector>
+		Vector &applyTransposeIn (Vector &y) const { return applyIn (y); }
+
+		/// Accumulated application, <code>y += D*x</code>.
+		template <class OutVector, class InVector>
+		OutVector &applyAddIn (OutVector &y, const InVector &x) const
+		{
+			linbox_check (_n == x.size ());
+			typename Vector_t::const_iterator v_iter = _v.begin ();
+			typename InVector::const_iterator x_iter = x.begin ();
+			for (typename OutVector::iterator y_iter = y.begin (); y_iter != y.end (); ++y_iter, ++v_iter, ++x_iter)
+				field().axpyin (*y_iter, *v_iter, *x_iter);
+			return y;
+		}
+
+		template <class OutVector, class InVector>
+		OutVector &applyTransposeAddIn (OutVector &y, const InVector &x) const { return applyAddIn (y, x); }
+
 		virtual Matrix& applyRight(Matrix& Y, const Matrix& X) const // Y = AX
 		{   MatrixDomain<Field> MD(field());
 		    return MD.mul(Y, *this, X);
@@ -28,6 +28,7 @@
 
 #include <utility>
 #include <algorithm>
+#include <vector>
 
 #include "linbox/linbox-config.h"
 #include "linbox/linbox-tags.h"
@@ -185,6 +186,57 @@ namespace LinBox
 			return y;
 		}
 
+		/** In-place application, <code>y= P*y</code>.
+		 * Follows the cycles of the permutation.
+		 * The cycles are marked at each call and not kept:
+		 * the indices can change through permute(), next() or getStorage(),
+		 * and a shared const permutation may be applied from several threads.
+		 */
+		template<class Vector>
+		inline Vector &applyIn (Vector &y) const
+		{
+			linbox_check (y.size () == _indices.size ());
+
+			std::vector<bool> marks(_indices.size(), false);
+			Element t; field().init(t);
+			for (size_t s = 0; s < _indices.size (); ++s) {
+				if (marks[s] || (size_t)_indices[s] == s) continue;
+				size_t i = s, j;
+				marks[s] = true;
+				field().assign(t, y[s]);
+				while ((j = (size_t)_indices[i]) != s) {
+					field().assign(y[i], y[j]);
+					marks[j] = true;
+					i = j;
+				}
+				field().assign(y[i], t);
+			}
+
+			return y;
+		}
+
+		/// In-place application of the transpose, <code>y= P^-1*y</code>.
+		template<class Vector>
+		inline Vector &applyTransposeIn (Vector &y) const
+		{
+			linbox_check (y.size () == _indices.size ());
+
+			std::vector<bool> marks(_indices.size(), false);
+			Element t; field().init(t);
+			for (size_t s = 0; s < _indices.size (); ++s) {
+				if (marks[s] || (size_t)_indices[s] == s) continue;
+				size_t i = s;
+				field().assign(t, y[s]);
+				do {
+					i = (size_t)_indices[i];
+					marks[i] = true;
+					std::swap(t, y[i]);
+				} while (i != s);
+			}
+
+			return y;
+		}
+
             // Permutes the rows of X
 		Matrix& applyRight(Matrix& Y, const Matrix& X) const
 		{
@@ -294,7 +346,7 @@ namespace LinBox
 		struct rebind {
 			typedef Permutation<_Tp1> other;
 			void operator() (other & Ap, const Self_t& A, const _Tp1& F) {
-				Ap->setStorage( A.getStorage() );
+				Ap.setStorage( A.getStorage() );
 			}
 		};
 
@@ -0,0 +1,259 @@
+/* linbox/blackbox/preconditioned.h
+ * Copyright (C) 2026 The LinBox group
+ *
+ * ========LICENCE========
+ * This file is part of the library LinBox.
+ *
+  * LinBox is free software: you can redistribute it and/or modify
+ * it under the terms of the  GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.	 See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ * ========LICENCE========
+ */
+
+/*! @file blackbox/preconditioned.h
+ * @ingroup blackbox
+ * @brief Fused preconditioned blackboxes \f$P A Q\f$ and \f$D_1 A^T D_2 A D_1\f$.
+ */
+
+#ifndef __LINBOX_preconditioned_H
+#define __LINBOX_preconditioned_H
+
+#include <type_traits>
+
+#include "linbox/util/debug.h"
+#include "linbox/linbox-config.h"
+#include "linbox/blackbox/blackbox-interface.h"
+#include "linbox/blackbox/blackbox-scratch.h"
+#include "linbox/blackbox/butterfly.h"
+#include "linbox/blackbox/diagonal.h"
+#include "linbox/vector/blas-vector.h"
+
+namespace LinBox
+{
+	/**
+	 * Blackbox of a two-sided preconditioned matrix: \f$B = P A Q\f$.
+	 *
+	 * Unlike nested \ref Compose, the whole product is applied in one pass
+	 * with scratch vectors that are allocated once, at construction.
+	 * When \p P is a diagonal, a scalar, a butterfly or a permutation,
+	 * it is applied in place on the output,
+	 * so that only one intermediate vector of size \c A.coldim() is needed.
+	 * Otherwise a second one of size \c A.rowdim() is used.
+	 *
+	 * A null pointer for \p P or \p Q stands for the identity,
+	 * e.g. <code>Preconditioned<Blackbox, Diag, Diag> B (nullptr, &A, &D)</code> is \f$A D\f$.
+	 *
+	 * The matrices are not copied, they must outlive the preconditioned blackbox.
+	 \ingroup blackbox
+	 */
+	template <class _Blackbox, class _LeftPreconditioner, class _RightPreconditioner = _LeftPreconditioner>
+	class Preconditioned : public BlackboxInterface {
+	public:
+		typedef _Blackbox Blackbox;
+		typedef _LeftPreconditioner LeftPreconditioner;
+		typedef _RightPreconditioner RightPreconditioner;
+
+		typedef typename Blackbox::Field Field;
+		typedef typename Field::Element Element;
+
+		/** Constructor of \f$B = P A Q\f$.
+		 * @param P_ptr left preconditioner, \c A.rowdim() square, or null
+		 * @param A_ptr blackbox
+		 * @param Q_ptr right preconditioner, \c A.coldim() square, or null
+		 */
+		Preconditioned (const LeftPreconditioner *P_ptr, const Blackbox *A_ptr, const RightPreconditioner *Q_ptr) :
+			_P_ptr (P_ptr), _A_ptr (A_ptr), _Q_ptr (Q_ptr),
+			_z (A_ptr->field(), (Q_ptr != nullptr) ? A_ptr->coldim () : 0),
+			_w (A_ptr->field(), (P_ptr != nullptr) ? A_ptr->rowdim () : 0)
+		{
+			linbox_check (P_ptr == nullptr || P_ptr->coldim () == A_ptr->rowdim ());
+			linbox_check (Q_ptr == nullptr || Q_ptr->rowdim () == A_ptr->coldim ());
+		}
+
+		/// Copy constructor, the matrices are shared, the scratch vectors are not.
+		Preconditioned (const Preconditioned &B) :
+			_P_ptr (B._P_ptr), _A_ptr (B._A_ptr), _Q_ptr (B._Q_ptr),
+			_z (B.field(), B._z.size ()), _w (B.field(), B._w.size ())
+		{}
+
+		/// \f$ y \gets P A Q x\f$.
+		template <class OutVector, class InVector>
+		OutVector& apply (OutVector& y, const InVector& x) const
+		{
+			if (_Q_ptr != nullptr) {
+				_Q_ptr->apply (_z, x);
+				applyLeft (y, _z, Protected::AppliesInPlace<LeftPreconditioner>());
+			}
+			else
+				applyLeft (y, x, Protected::AppliesInPlace<LeftPreconditioner>());
+
+			return y;
+		}
+
+		/// \f$ y \gets Q^T A^T P^T x\f$.
+		template <class OutVector, class InVector>
+		OutVector& applyTranspose (OutVector& y, const InVector& x) const
+		{
+			if (_P_ptr != nullptr) {
+				_P_ptr->applyTranspose (_w, x);
+				applyTransposeRight (y, _w, Protected::AppliesInPlace<RightPreconditioner>());
+			}
+			else
+				applyTransposeRight (y, x, Protected::AppliesInPlace<RightPreconditioner>());
+
+			return y;
+		}
+
+		size_t rowdim () const { return _A_ptr->rowdim (); }
+		size_t coldim () const { return _A_ptr->coldim (); }
+		const Field& field () const { return _A_ptr->field (); }
+
+		/// Number of field elements of the scratch vectors, including those of \p A.
+		size_t scratchSize () const { return _z.size () + _w.size () + blackboxScratchSize (*_A_ptr); }
+
+	protected:
+		// y <- P (A x), P in place on y
+		template <class OutVector, class InVector>
+		void applyLeft (OutVector& y, const InVector& x, std::true_type) const
+		{
+			_A_ptr->apply (y, x);
+			if (_P_ptr != nullptr) _P_ptr->applyIn (y);
+		}
+
+		template <class OutVector, class InVector>
+		void applyLeft (OutVector& y, const InVector& x, std::false_type) const
+		{
+			if (_P_ptr != nullptr) {
+				_A_ptr->apply (_w, x);
+				_P_ptr->apply (y, _w);
+			}
+			else
+				_A_ptr->apply (y, x);
+		}
+
+		// y <- Q^T (A^T x), Q^T in place on y
+		template <class OutVector, class InVector>
+		void applyTransposeRight (OutVector& y, const InVector& x, std::true_type) const
+		{
+			_A_ptr->applyTranspose (y, x);
+			if (_Q_ptr != nullptr) _Q_ptr->applyTransposeIn (y);
+		}
+
+		template <class OutVector, class InVector>
+		void applyTransposeRight (OutVector& y, const InVector& x, std::false_type) const
+		{
+			if (_Q_ptr != nullptr) {
+				_A_ptr->applyTranspose (_z, x);
+				_Q_ptr->applyTranspose (y, _z);
+			}
+			else
+				_A_ptr->applyTranspose (y, x);
+		}
+
+		const LeftPreconditioner *_P_ptr;
+		const Blackbox *_A_ptr;
+		const RightPreconditioner *_Q_ptr;
+
+		// scratch of size A.coldim(), used when Q is present
+		mutable BlasVector<Field> _z;
+		// scratch of size A.rowdim(), used when P is present
+		mutable BlasVector<Field> _w;
+	};
+
+	/**
+	 * Blackbox of a symmetrized matrix: \f$B = D_1 A^T D_2 A D_1\f$.
+	 *
+	 * \f$D_1\f$ and \f$D_2\f$ are dense diagonals, or null for the identity:
+	 * this gives \f$A^T A\f$, \f$A^T D A\f$ or the full diagonal symmetrization
+	 * used by the Lanczos solvers.
+	 * The diagonal scalings are fused in place with the applies of \f$A\f$ and \f$A^T\f$,
+	 * the only scratch vectors are the two allocated at construction.
+	 *
+	 * \f$B\f$ is symmetric, so \c applyTranspose is \c apply.
+	 \ingroup blackbox
+	 */
+	template <class _Blackbox>
+	class DiagonalSymmetrized : public BlackboxInterface {
+	public:
+		typedef _Blackbox Blackbox;
+		typedef typename Blackbox::Field Field;
+		typedef typename Field::Element Element;
+		typedef Diagonal<Field, VectorCategories::DenseVectorTag> DiagonalMatrix;
+
+		/** Constructor of \f$B = D_1 A^T D_2 A D_1\f$.
+		 * @param D1_ptr \c A.coldim() diagonal or null
+		 * @param A_ptr blackbox
+		 * @param D2_ptr \c A.rowdim() diagonal or null
+		 */
+		DiagonalSymmetrized (const DiagonalMatrix *D1_ptr, const Blackbox *A_ptr, const DiagonalMatrix *D2_ptr) :
+			_D1_ptr (D1_ptr), _A_ptr (A_ptr), _D2_ptr (D2_ptr),
+			_z (A_ptr->field(), (D1_ptr != nullptr) ? A_ptr->coldim () : 0),
+			_w (A_ptr->field(), A_ptr->rowdim ())
+		{
+			linbox_check (D1_ptr == nullptr || D1_ptr->rowdim () == A_ptr->coldim ());
+			linbox_check (D2_ptr == nullptr || D2_ptr->rowdim () == A_ptr->rowdim ());
+		}
+
+		DiagonalSymmetrized (const DiagonalSymmetrized &B) :
+			_D1_ptr (B._D1_ptr), _A_ptr (B._A_ptr), _D2_ptr (B._D2_ptr),
+			_z (B.field(), B._z.size ()), _w (B.field(), B._w.size ())
+		{}
+
+		/// \f$ y \gets D_1 A^T D_2 A D_1 x\f$.
+		template <class OutVector, class InVector>
+		OutVector& apply (OutVector& y, const InVector& x) const
+		{
+			if (_D1_ptr != nullptr) {
+				_D1_ptr->apply (_z, x);
+				_A_ptr->apply (_w, _z);
+			}
+			else
+				_A_ptr->apply (_w, x);
+
+			if (_D2_ptr != nullptr) _D2_ptr->applyIn (_w);
+			_A_ptr->applyTranspose (y, _w);
+			if (_D1_ptr != nullptr) _D1_ptr->applyIn (y);
+
+			return y;
+		}
+
+		template <class OutVector, class InVector>
+		OutVector& applyTranspose (OutVector& y, const InVector& x) const { return apply (y, x); }
+
+		size_t rowdim () const { return _A_ptr->coldim (); }
+		size_t coldim () const { return _A_ptr->coldim (); }
+		const Field& field () const { return _A_ptr->field (); }
+
+		/// Number of field elements of the scratch vectors, including those of \p A.
+		size_t scratchSize () const { return _z.size () + _w.size () + blackboxScratchSize (*_A_ptr); }
+
+	protected:
+		const DiagonalMatrix *_D1_ptr;
+		const Blackbox *_A_ptr;
+		const DiagonalMatrix *_D2_ptr;
+
+		mutable BlasVector<Field> _z;
+		mutable BlasVector<Field> _w;
+	};
+
+} // namespace LinBox
+
+#endif // __LINBOX_preconditioned_H
+
+// Local Variables:
+// mode: C++
+// tab-width: 4
+// indent-tabs-mode: nil
+// c-basic-offset: 4
+// End:
+// vim:sts=4:sw=4:ts=4:et:sr:cino=>s,f0,{0,g0,(0,\:0,t0,+0,=s
@@ -169,6 +169,37 @@ namespace LinBox
 		OutVector& applyTranspose(OutVector &y, InVector &x) const
 		{ return apply(y, x); }  // symmetric matrix.
 
+		/** In-place application, y= A*y.
+		 */
+		template<class Vector>
+		Vector& applyIn(Vector &y) const
+		{
+			if (field().isOne(v_)) return y;
+			for (typename Vector::iterator y_iter = y.begin (); y_iter != y.end (); ++y_iter)
+				field().mulin (*y_iter, v_);
+			return y;
+		}
+
+		template<class Vector>
+		Vector& applyTransposeIn(Vector &y) const
+		{ return applyIn(y); }
+
+		/** Accumulated application, y+= A*x.
+		 */
+		template<class OutVector, class InVector>
+		OutVector& applyAddIn(OutVector &y, const InVector &x) const
+		{
+			if (field().isZero(v_)) return y;
+			typename InVector::const_iterator x_iter = x.begin ();
+			for (typename OutVector::iterator y_iter = y.begin (); y_iter != y.end (); ++y_iter, ++x_iter)
+				field().axpyin (*y_iter, v_, *x_iter);
+			return y;
+		}
+
+		template<class OutVector, class InVector>
+		OutVector& applyTransposeAddIn(OutVector &y, const InVector &x) const
+		{ return applyAddIn(y, x); }
+
 
 		template<typename _Tp1>
 		struct rebind {
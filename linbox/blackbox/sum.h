@@ -32,6 +32,7 @@
 #include "linbox/vector/vector-domain.h"
 #include "linbox/util/debug.h"
 #include "linbox/blackbox/blackbox-interface.h"
+#include "linbox/blackbox/blackbox-scratch.h"
 
 namespace LinBox
 {
@@ -77,8 +78,10 @@ namespace LinBox
 			linbox_check (A.coldim () == B.coldim ());
 			linbox_check (A.rowdim () == B.rowdim ());
 
-			VectorWrapper::ensureDim (_z1, A.rowdim ());
-			VectorWrapper::ensureDim (_z2, A.coldim ());
+			if (! Protected::AppliesAddIn<Blackbox2>::value) {
+				VectorWrapper::ensureDim (_z1, A.rowdim ());
+				VectorWrapper::ensureDim (_z2, A.coldim ());
+			}
 		}
 
 		/** Constructor from black box pointers.
@@ -95,8 +98,10 @@ namespace LinBox
 			linbox_check (A_ptr->coldim () == B_ptr->coldim ());
 			linbox_check (A_ptr->rowdim () == B_ptr->rowdim ());
 
-			VectorWrapper::ensureDim (_z1, A_ptr->rowdim ());
-			VectorWrapper::ensureDim (_z2, A_ptr->coldim ());
+			if (! Protected::AppliesAddIn<Blackbox2>::value) {
+				VectorWrapper::ensureDim (_z1, A_ptr->rowdim ());
+				VectorWrapper::ensureDim (_z2, A_ptr->coldim ());
+			}
 		}
 
 		/** Copy constructor.
@@ -106,8 +111,10 @@ namespace LinBox
 		Sum (const Sum<Blackbox1, Blackbox2> &M) :
 			_A_ptr (M._A_ptr), _B_ptr (M._B_ptr), VD(M.VD)
 		{
-			VectorWrapper::ensureDim (_z1, _A_ptr->rowdim ());
-			VectorWrapper::ensureDim (_z2, _A_ptr->coldim ());
+			if (! Protected::AppliesAddIn<Blackbox2>::value) {
+				VectorWrapper::ensureDim (_z1, _A_ptr->rowdim ());
+				VectorWrapper::ensureDim (_z2, _A_ptr->coldim ());
+			}
 		}
 
 		/// Destructor
@@ -128,8 +135,7 @@ namespace LinBox
 		inline OutVector &apply (OutVector &y, const InVector &x) const
 		{
 			_A_ptr->apply (y, x);
-			_B_ptr->apply (_z1, x);
-			VD.addin (y, _z1);
+			applyAddIn (y, x, Protected::AppliesAddIn<Blackbox2>());
 
 			return y;
 		}
@@ -147,8 +153,7 @@ namespace LinBox
 		inline OutVector &applyTranspose (OutVector &y, const InVector &x) const
 		{
 			_A_ptr->applyTranspose (y, x);
-			_B_ptr->applyTranspose (_z2, x);
-			VD.addin (y, _z2);
+			applyTransposeAddIn (y, x, Protected::AppliesAddIn<Blackbox2>());
 
 			return y;
 		}
@@ -194,8 +199,38 @@ namespace LinBox
 		        _A_ptr->write(os); _B_ptr->write(os << '+') ;
 			return os ;
 		}
+		/// Intermediate storage, in field elements, including the one of A and B.
+		size_t scratchSize () const
+		{
+			return _z1.size () + _z2.size () + blackboxScratchSize (*_A_ptr) + blackboxScratchSize (*_B_ptr);
+		}
+
 	protected:
 
+		// A diagonal or scalar B accumulates into y directly,
+		// e.g. A - lambda I costs no intermediate vector.
+		template<class OutVector, class InVector>
+		void applyAddIn (OutVector &y, const InVector &x, std::true_type) const
+		{ _B_ptr->applyAddIn (y, x); }
+
+		template<class OutVector, class InVector>
+		void applyAddIn (OutVector &y, const InVector &x, std::false_type) const
+		{
+			_B_ptr->apply (_z1, x);
+			VD.addin (y, _z1);
+		}
+
+		template<class OutVector, class InVector>
+		void applyTransposeAddIn (OutVector &y, const InVector &x, std::true_type) const
+		{ _B_ptr->applyTransposeAddIn (y, x); }
+
+		template<class OutVector, class InVector>
+		void applyTransposeAddIn (OutVector &y, const InVector &x, std::false_type) const
+		{
+			_B_ptr->applyTranspose (_z2, x);
+			VD.addin (y, _z2);
+		}
+
 		// use a copy of the input field for faster performance (no pointer dereference).
 
 		const Blackbox1       *_A_ptr;
@@ -27,6 +27,7 @@
 
 #include "linbox/util/error.h"
 #include "linbox/blackbox/blackbox-interface.h"
+#include "linbox/blackbox/blackbox-scratch.h"
 
 namespace LinBox
 {
@@ -169,6 +170,9 @@ namespace LinBox
 		// accessors to the blackboxes
 		const Blackbox* getPtr() const {return  _A_ptr;}
 
+		/// Intermediate storage of the transposed blackbox, none is added.
+		size_t scratchSize() const {return (_A_ptr != 0) ? blackboxScratchSize(*_A_ptr) : 0;}
+
 		std::ostream &write(std::ostream & os) const {
 			return _A_ptr->write(os << "transpose of:");
 		}
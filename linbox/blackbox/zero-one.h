@@ -34,27 +34,46 @@
 #include "linbox/integer.h"
 #include "linbox/vector/vector-traits.h"
 #include "linbox/util/debug.h"
+#include "linbox/util/field-axpy.h"
 #include "linbox/ring/modular.h"
 #include "linbox/blackbox/blackbox-interface.h"
 
 // For STL pair in IndexIterator
 #include <utility>
-#include <vector> // For vectors in _col2row and _row2col
-#include <cstdlib> // For randomness in randomized quicksort
-#include <ctime>
+#include <vector> // For the compressed indices
+#include <cstdint>
+#include <limits>
+#include <sstream>
 #include <iostream>
 
 namespace LinBox
 {
+	namespace Protected {
+		/*! @internal One compressed index of a ZeroOne: the ones of line i
+		 * (a row or a column) are at positions start[i] to start[i+1] of
+		 * index, which holds their indices along the other dimension.
+		 */
+		template<class I>
+		struct ZeroOneIndex {
+			std::vector<I> start;
+			std::vector<I> index;
+		};
+	}
 
 	/** \brief Time and space efficient representation of sparse {0,1}-matrices.
 	 *
 	 * A 0-1 matrix is a matrix with all 0's and 1's as entries.
-	 * We're using a NAG-sparse format.
-	 * Applies can be performed fast, using only additions.
+	 * The positions of the ones are kept twice, compressed by rows (CSR)
+	 * and compressed by columns (CSC), with 32-bit indices whenever the
+	 * dimensions and the number of ones fit.  Both are built once, so that
+	 * apply and applyTranspose never reorder anything: each entry of the
+	 * result is a sum of entries of x, the rows being summed in parallel.
+	 * The sums use FieldAXPY, so that they are reduced only when the
+	 * field's accumulator bound requires it.
+	 *
 	 * When initalizing this class, you only need to build 2 arrays of equal length:
 	 * an array of the row indices for the non-zero (1's) entries, and an array of the column
-	 * indices for the non-zero (1's) entries.
+	 * indices for the non-zero (1's) entries, in any order.
 
 	 A {0, 1,-1} matrix can be effecively represented as the \ref Dif of two ZeroOne's.
 	 \ingroup blackbox
@@ -68,38 +87,35 @@ namespace LinBox
 		typedef _Field Field;
 		typedef typename _Field::Element Element;
 
-		// Default constructor, do nothing.
+		// Empty matrix, can be used with subsequent read.
 		ZeroOne(const Field& F);
-		// The real constructor /todo give docs here
+		/** Constructor from the coordinates of the ones.
+		 * The arrays are only read, the entries may come in any order.
+		 * @param rowSort,colSort unused, kept for compatibility
+		 */
 		ZeroOne(Field &F, Index* rowP, Index* colP, Index rows, Index cols, Index NNz, bool rowSort = false, bool colSort = false);
-		// Destructor, once again do nothing
-		~ZeroOne();
 
 		/** apply.
 		 *
-		 * Uses one of the three
-		 * private utility functions. It calls the generalized utility function
-		 * _apply if there is no special ordering, _fyapply if there is C_ordering
-		 * or _fxapply if there is fortran_ordering
+		 * y_i is the sum of the x_j for the ones (i,j) of row i, the rows being
+		 * read from the row compressed index.
 		 */
 		template<class OutVector, class InVector>
 		OutVector& apply(OutVector& y, const InVector& x) const // y = Ax;
 		{
-			return applySpecialization(y,x,getType(field()));
+			linbox_check((y.size()==rowdim())&&(x.size()==coldim()));
+			return _narrow ? addLines(y, x, _rows32) : addLines(y, x, _rows64);
 		}
 
 		/** applyTranspose.
 		 *
-		 * Uses one of the three
-		 * private utility functions, in the manner described above.  Worthy of
-		 * note is the fact that applyTranspose works by passing the column
-		 * positions to the _apply functions as if they were rows, and row positions
-		 * as if they were columns, as if the matrix had been transposed.
+		 * Same as apply, on the column compressed index.
 		 */
 		template<class OutVector, class InVector>
 		OutVector& applyTranspose(OutVector& y, const InVector& x) const // y = ATx
 		{
-			return applyTransposeSpecialization(y,x,getType(field()));
+			linbox_check((y.size()==coldim())&&(x.size()==rowdim()));
+			return _narrow ? addLines(y, x, _cols32) : addLines(y, x, _cols64);
 		}
 
 		size_t rowdim() const
@@ -125,21 +141,10 @@ namespace LinBox
 		template<typename _Tp1>
 		ZeroOne(const ZeroOne<_Tp1>& Z, const Field& F) :
 			_field(&F),
-			_rows(Z.rowdim()), _cols(Z.coldim()), _nnz(Z.nnz()),
-			_rowP(new Index[Z.nnz()]), _colP(new Index[Z.nnz()]),
-			_rowSort(Z.isRowSorted()), _colSort(Z.isColSorted()),
-			dynamic(true)
-		{
-
-			Index * rowit = _rowP;
-			Index * colit = _colP;
-
-			for(typename ZeroOne<_Tp1>::IndexIterator it = Z.indexBegin();
-			    it != Z.indexEnd(); ++it,++rowit,++colit) {
-				*rowit = (*it).first;
-				*colit = (*it).second;
-			}
-		}
+			_rows(Z._rows), _cols(Z._cols), _nnz(Z._nnz), _narrow(Z._narrow),
+			_rows32(Z._rows32), _cols32(Z._cols32),
+			_rows64(Z._rows64), _cols64(Z._cols64)
+		{}
 
 		/** Iterator class.
 		 * Iterates straight through the values of the matrix
@@ -152,7 +157,7 @@ namespace LinBox
 		const Iterator End() const;
 
 		/** IndexIterator.
-		 * Iterates through the i and j of the current element
+		 * Iterates through the i and j of the current element, in row order,
 		 * and when accessed returns an STL pair containing the coordinates
 		 */
 		class IndexIterator;
@@ -178,7 +183,7 @@ namespace LinBox
 			str >> m >> n;
 			_rows = m;
 			_cols = n;
-			
+
 			std::vector<size_t> rowP, colP;
 			size_t x=0;
 			while (is >> i >> j >> x) {
@@ -189,25 +194,18 @@ namespace LinBox
 				}
 			}
 			_nnz = rowP.size();
-			_rowP = new size_t[_nnz];
-			_colP = new size_t[_nnz];
-			std::copy(rowP.begin(), rowP.end(), _rowP);
-			std::copy(colP.begin(), colP.end(), _colP);
+			init(rowP.data(), colP.data());
 			return is;
 		}
 
-		std::ostream& write(std::ostream& out = std::cout)
+		std::ostream& write(std::ostream& out = std::cout) const
 		{
-			size_t* i=_rowP;
-			size_t* j=_colP;
-
 			out << "Row dim: " << rowdim()
 			    << " Col dim: " << coldim()
 			    << " Total nnz: " << nnz() << std::endl;
 
-            auto lastIndex = _rowP + nnz();
-			for(; i < lastIndex; ++i, ++j)
-				out << *i << " " << *j << std::endl;
+			for(IndexIterator it = indexBegin(); it != indexEnd(); ++it)
+				out << (*it).first << " " << (*it).second << std::endl;
 
 			return out;
 		}
@@ -217,23 +215,20 @@ namespace LinBox
 			return *_field;
 		}
 
-		bool isRowSorted() const
-		{
-			return _rowSort;
-		}
-		bool isColSorted() const
-		{
-			return _colSort;
-		}
-
 		size_t nnz() const
 		{
 			return _nnz;
 		};
 
+		//! Applies on fewer ones than this are not threaded.
+		static const size_t parallelThreshold = 1 << 15;
 
 	protected:
 
+		template<class> friend class ZeroOne;
+
+		template<class I>
+		using CompressedIndex = Protected::ZeroOneIndex<I>;
 
 		const Field *_field; //!< @internal The field used by this class
 
@@ -245,48 +240,31 @@ namespace LinBox
 
 		Index _rows ;          //!<@internal number of rows of the Matrix
 		Index _cols ;          //!<@internal number of columns
-		Index _nnz;            //!<@internal Number of  Non-Zero elements in the Matrix.  It also happens to be the length of  the three NAGSparse arrays.
-		mutable Index* _rowP ; //!<@internal pointer to an array of row indexes.
-		mutable Index* _colP;  //!<@internal pointer to an array of column indexes. (\c _rowP and \c _colP are the other arrays of a  NAGSparse format Matrix.)
-		mutable bool _rowSort ;
-		mutable bool _colSort; //!<@internal status flags for sorting state
-		bool dynamic;          // NO DOC
-
-		/*! Tells the number of nonzero entries.
-		 * Non blackbox function.
-		 */
-		void rowSort() const;
-		void colSort() const;
+		Index _nnz;            //!<@internal Number of ones in the Matrix.
+		bool _narrow;          //!<@internal whether the 32-bit indices are used
+		CompressedIndex<uint32_t> _rows32, _cols32; //!<@internal CSR and CSC, when everything fits in 32 bits
+		CompressedIndex<Index> _rows64, _cols64;    //!<@internal CSR and CSC otherwise
 
-		void _qsort(size_t start, size_t endp1, int &mode) const;   //!< @internal QuickSort function for when there is no sorting
-		size_t _part( size_t start, size_t endp1, int &mode) const; //!< @internal Partition for quicksort
+		//! @internal Builds both compressed indices from the coordinates of the ones.
+		void init(const Index* rowP, const Index* colP);
 
-	private:
+		template<class I>
+		void compress(CompressedIndex<I>& C, const Index* lineP, const Index* otherP, Index lines);
 
-		class FieldType {};
-		class NormField : public FieldType {};
-		class Mod32Field : public FieldType {};
+		//! @internal y_i = sum of the x_j over line i of C.
+		template<class OutVector, class InVector, class I>
+		OutVector& addLines(OutVector& y, const InVector& x, const CompressedIndex<I>& C) const;
 
-		template<class F>
-		NormField getType(const F &  f) const
+		Index rowStart(Index i) const
 		{
-			return NormField();
+			return _narrow ? (Index) _rows32.start[i] : _rows64.start[i];
 		}
 
-		Mod32Field getType(const Givaro::Modular<uint32_t> &) const
+		Index colIndex(Index k) const
 		{
-			return Mod32Field();
+			return _narrow ? (Index) _rows32.index[k] : _rows64.index[k];
 		}
 
-		template<class OutVector, class InVector>
-		OutVector& applySpecialization(OutVector &, const InVector &,const NormField& ) const;
-		template<class OutVector, class InVector>
-		OutVector& applySpecialization(OutVector &, const InVector &, const Mod32Field& )const;
-		template<class OutVector, class InVector>
-		OutVector& applyTransposeSpecialization(OutVector &, const InVector &,const NormField& ) const;
-		template<class OutVector, class InVector>
-		OutVector& applyTransposeSpecialization(OutVector &, const InVector &, const Mod32Field& )const;
-
 	}; //ZeroOne
 
 } //LinBox
@@ -120,7 +120,7 @@ namespace LinBox
 
 	/*! IndexIterator.
 	 * @ingroup iterators
-	 * Iterates through the i and j of the current element
+	 * Iterates through the i and j of the current element, in row order,
 	 * and when accessed returns an STL pair containing the coordinates
 	 */
     template<class Field>
@@ -130,378 +130,167 @@ namespace LinBox
 
         IndexIterator() {}
 
-        IndexIterator(size_t* row, size_t* col):
-                _row(row), _col(col) {}
+        IndexIterator(const ZeroOne<Field>* A, size_t pos):
+                _A(A), _row(0), _pos(pos)
+            {
+                skipEmptyRows();
+            }
 
         IndexIterator(const IndexIterator &In):
-                _row(In._row), _col(In._col)
+                _A(In._A), _row(In._row), _pos(In._pos)
             {}
 
         const IndexIterator &operator=(const IndexIterator &rhs)
             {
+                _A = rhs._A;
                 _row = rhs._row;
-                _col = rhs._col;
+                _pos = rhs._pos;
                 return *this;
             }
 
         bool operator==(const IndexIterator &rhs)
             {
-                return _row == rhs._row && _col == rhs._col;
+                return _A == rhs._A && _pos == rhs._pos;
             }
 
         bool operator!=(const IndexIterator &rhs)
             {
-                return _row != rhs._row || _col != rhs._col;
+                return _A != rhs._A || _pos != rhs._pos;
             }
 
         const IndexIterator& operator++()
             {
-                ++_row; ++_col;
+                ++_pos;
+                skipEmptyRows();
                 return *this;
             }
 
         const IndexIterator operator++(int)
             {
                 IndexIterator tmp = *this;
-                ++_row; ++_col;
+                ++*this;
                 return tmp;
             }
 
         value_type operator*()
             {
-                return std::pair<size_t,size_t>(*_row, *_col);
+                return std::pair<size_t,size_t>(_row, _A->colIndex(_pos));
             }
 
         const value_type operator*() const
             {
-                return std::pair<size_t,size_t>(*_row, *_col);
+                return std::pair<size_t,size_t>(_row, _A->colIndex(_pos));
             }
     private:
-        size_t* _row, *_col;
+        // moves _row to the row of the one at _pos
+        void skipEmptyRows()
+            {
+                while (_row < _A->rowdim() && _A->rowStart(_row + 1) <= _pos)
+                    ++_row;
+            }
+
+        const ZeroOne<Field>* _A;
+        size_t _row, _pos;
     };
 
     template<class Field> typename
     ZeroOne<Field>::IndexIterator ZeroOne<Field>::indexBegin()
     {
-        return IndexIterator(_rowP, _colP);
+        return IndexIterator(this, 0);
     }
 
     template<class Field>
     const typename ZeroOne<Field>::IndexIterator ZeroOne<Field>::indexBegin() const
     {
-        return IndexIterator(_rowP, _colP);
+        return IndexIterator(this, 0);
     }
 
     template<class Field> typename
     ZeroOne<Field>::IndexIterator ZeroOne<Field>::indexEnd()
     {
-        return IndexIterator(_rowP + _nnz, _colP + _nnz);
+        return IndexIterator(this, _nnz);
     }
 
     template<class Field>
     const typename ZeroOne<Field>::IndexIterator ZeroOne<Field>::indexEnd() const
     {
-        return IndexIterator(_rowP + _nnz, _colP + _nnz);
+        return IndexIterator(this, _nnz);
     }
 
     template<class Field>
     ZeroOne<Field>::ZeroOne(const Field& F) :
-            _field(&F)
+            _field(&F), _rows(0), _cols(0), _nnz(0)
     {
-        srand(static_cast<unsigned int>(std::time(nullptr)));
-        dynamic = false;
+        init(nullptr, nullptr);
     }
 
     template<class Field>
     ZeroOne<Field>::ZeroOne(Field& F, Index* rowP, Index* colP,
-                            Index rows, Index cols, Index NNz, bool RowSort, bool ColSort):
-            _field(&F), _rows(rows), _cols(cols), _nnz(NNz), _rowP(rowP), _colP(colP), _rowSort(RowSort), _colSort(ColSort) , dynamic(false)
-    {
-        srand(static_cast<unsigned>(std::time(nullptr)));
-    }
-
-    template<class Field>
-    ZeroOne<Field>::~ZeroOne()
+                            Index rows, Index cols, Index NNz, bool, bool):
+            _field(&F), _rows(rows), _cols(cols), _nnz(NNz)
     {
-        if(dynamic) {
-            delete [] _rowP;
-            delete [] _colP;
-        }
+        init(rowP, colP);
     }
 
     template<class Field>
-    void ZeroOne<Field>::rowSort() const
+    void ZeroOne<Field>::init(const Index* rowP, const Index* colP)
     {
-        if( _rowSort) return;  // Already sorted, we're done
-        else {
-            int mode = 0;
-            _qsort( (size_t) 0, _nnz, mode);
+        const Index limit = std::numeric_limits<uint32_t>::max();
+        _narrow = (_rows < limit && _cols < limit && _nnz < limit);
+
+        _rows32 = _cols32 = CompressedIndex<uint32_t>();
+        _rows64 = _cols64 = CompressedIndex<Index>();
+        if (_narrow) {
+            compress(_rows32, rowP, colP, _rows);
+            compress(_cols32, colP, rowP, _cols);
         }
-        _rowSort = true;
-        return;
-    }
-
-    template<class Field>
-    void ZeroOne<Field>::colSort() const
-    {
-        if( _colSort) return; // Already sorted, good to go
         else {
-            int mode = 1;
-            _qsort( (size_t) 0, _nnz, mode);
-        }
-        _colSort = true; _rowSort = false;
-        return;
-    }
-
-    template<class Field>
-    void ZeroOne<Field>::_qsort(size_t p, size_t e, int &mode) const
-    {
-        if( (e - p) <= 1) ;
-        else
-        {
-            int i;
-            i = 1 + (int)_part(p, e, mode);
-            _qsort(p, (size_t)i, mode);
-            _qsort((size_t)i, e, mode);
-        }
-    }
-
-    template<class Field>
-    size_t ZeroOne<Field>::_part(size_t p, size_t e, int &mode) const
-    {
-        size_t rtemp, ctemp, rowval, colval;
-        int i = int(p +(size_t) rand() % (e - p)), j =(int) e;
-        rtemp = _rowP[p];
-        ctemp = _colP[p];
-        _rowP[p] = _rowP[i];
-        _colP[p] = _colP[i];
-        _rowP[i] = rtemp;
-        _colP[i] = ctemp;
-        rowval = _rowP[p];
-        colval = _colP[p];
-        i = (int)p - 1;
-
-        if(mode == 0)
-        { // Row mode, go by row order, then column
-            while(true)
-            {
-                do j--; while( _rowP[j] > rowval || ( _rowP[j] == rowval && _colP[j] > colval ));
-                do i++; while( _rowP[i] < rowval || ( _rowP[i] == rowval && _colP[i] < colval ));
-                if( i < j)
-                {
-                    rtemp = _rowP[j];
-                    ctemp = _colP[j];
-                    _rowP[j] = _rowP[i];
-                    _colP[j] = _colP[i];
-                    _rowP[i] = rtemp;
-                    _colP[i] = ctemp;
-                }
-                else return (size_t)j;
-            }
-        }
-        else
-        { // Col mode, go by col order, then row
-            while(true)
-            {
-                do j--; while( _colP[j] > colval || ( _colP[j] == colval && _rowP[j] > rowval ));
-                do i++; while( _colP[i] < colval || ( _colP[i] == colval && _rowP[i] < rowval ));
-                if( i < j) {
-                    rtemp = _rowP[j];
-                    ctemp = _colP[j];
-                    _rowP[j] = _rowP[i];
-                    _colP[j] = _colP[i];
-                    _rowP[i] = rtemp;
-                    _colP[i] = ctemp;
-                }
-                else return (size_t)j;
-            }
-        }
-    }
-
-    template<class Field>
-    template<class OutVector, class InVector>
-    OutVector & ZeroOne<Field>::applySpecialization(OutVector & y, const InVector & x, const NormField& n) const
-    {
-            //std::cout<<"Call general case\n";
-        linbox_check((y.size()==rowdim())&&(x.size()==coldim()));
-        typename OutVector::iterator yp;
-        typename InVector::const_iterator xp;
-        Index* ip, *jp;
-
-            // 0 out y.  Note, this implementation assumes a dense vector.
-        for(yp = y.begin(); yp != y.end(); ++yp)
-            field().assign(*yp , field().zero);
-
-        rowSort();
-
-        yp=y.begin();
-        xp=x.begin();
-        ip=_rowP;
-        jp=_colP;
-        size_t rowI =0;
-
-        auto ipEnd = _rowP + nnz();
-        for(; ip < ipEnd; ++ip,++jp)
-        {
-            if( *ip == rowI)
-                field().addin(*yp,*(xp +(ptrdiff_t) *jp));
-            else
-            {
-                if((*ip-rowI)==1)
-                    ++yp;
-                else
-                    yp=y.begin()+(ptrdiff_t)*ip;
-
-                rowI=*ip;
-                field().addin(*yp,*(xp +(ptrdiff_t) *jp));
-            }
-        }
-        return y;
-    }
-
-    template<class Field>
-    template<class OutVector, class InVector>
-    OutVector & ZeroOne<Field>::applySpecialization(OutVector & y, const InVector & x, const Mod32Field& m) const
-    {
-            //std::cout<<"Called specialization\n";
-        linbox_check((y.size()==rowdim())&&(x.size()==coldim()));
-
-        typename OutVector::iterator yp;
-        typename InVector::const_iterator xp;
-        typedef typename OutVector::value_type val_t ;
-        Index* ip, *jp;
-
-        for(yp = y.begin(); yp != y.end(); ++yp)
-            field().assign(*yp , field().zero);
-
-        rowSort();
-
-        yp=y.begin();
-        xp=x.begin();
-        ip=_rowP;
-        jp=_colP;
-        size_t rowI =0;
-        integer _prime;
-
-        field().characteristic(_prime);
-
-        uint32_t prime = static_cast<uint32_t>(_prime);
-
-        uint64_t accum =0;
-
-        for(; ip <_rowP+nnz(); ++ip,++jp)
-        {
-            if( *ip == rowI)
-                accum=accum+*(xp +(ptrdiff_t) *jp);
-            else
-            {
-                *yp= (val_t)(accum % prime);
-                if((*ip-rowI)==1)
-                    ++yp;
-                else
-                    yp=y.begin()+(ptrdiff_t)*ip;
-
-                rowI=*ip;
-                accum=*(xp+(ptrdiff_t)*jp);
-            }
+            compress(_rows64, rowP, colP, _rows);
+            compress(_cols64, colP, rowP, _cols);
         }
-        if(rowI)
-            *yp= val_t(accum % prime);
-
-        return y;
     }
 
-
+    // Counting sort of the ones by line, keeping their order within a line.
     template<class Field>
-    template<class OutVector, class InVector>
-    OutVector & ZeroOne<Field>::applyTransposeSpecialization(OutVector & y, const InVector & x, const NormField& n) const
+    template<class I>
+    void ZeroOne<Field>::compress(CompressedIndex<I>& C, const Index* lineP, const Index* otherP, Index lines)
     {
-            //std::cout<<"Call general case\n";
-        linbox_check((y.size()==coldim())&&(x.size()==rowdim()));
-        typename OutVector::iterator yp;
-        typename InVector::const_iterator xp;
-        Index* ip, *jp;
-
-            // 0 out y.  Note, this implementation assumes a dense vector.
-        for(yp = y.begin(); yp != y.end(); ++yp)
-            field().assign(*yp , field().zero);
-
-        rowSort();
-
-        yp=y.begin();
-        xp=x.begin();
-        ip=_rowP;
-        jp=_colP;
-        size_t rowI =0;
-
-        for(; ip <_rowP+nnz(); ++ip,++jp)
-        {
-            if( *ip == rowI)
-                field().addin(*(yp+(ptrdiff_t)*jp),*xp);
-            else
-            {
-                if((*ip-rowI)==1)
-                    ++xp;
-                else
-                    xp=x.begin()+(ptrdiff_t)*ip;
-
-                rowI=*ip;
-                field().addin(*(yp+(ptrdiff_t)*jp),*xp);
-            }
+        C.start.assign(lines + 1, 0);
+        for (Index k = 0; k < _nnz; ++k) {
+            linbox_check(lineP[k] < lines);
+            ++C.start[lineP[k] + 1];
         }
+        for (Index i = 0; i < lines; ++i)
+            C.start[i + 1] += C.start[i];
 
-        return y;
+        C.index.resize(_nnz);
+        std::vector<I> next(C.start.begin(), C.start.end() - 1);
+        for (Index k = 0; k < _nnz; ++k)
+            C.index[next[lineP[k]]++] = (I) otherP[k];
     }
 
-
     template<class Field>
-    template<class OutVector, class InVector>
-    OutVector & ZeroOne<Field>::applyTransposeSpecialization(OutVector & y, const InVector & x, const Mod32Field& m) const
+    template<class OutVector, class InVector, class I>
+    OutVector & ZeroOne<Field>::addLines(OutVector & y, const InVector & x, const CompressedIndex<I>& C) const
     {
-            //std::cout<<"Called specialization\n";
-        linbox_check((y.size()==coldim())&&(x.size()==rowdim()));
-
-        std::vector<uint64_t> y_c (y.size(),0);
-
-        typename OutVector::iterator         yp;
-        typename InVector::const_iterator    xp;
-        typedef typename OutVector::value_type   val_t ;
-        Index* ip, *jp;
-
-        rowSort();
+        typename OutVector::iterator yp = y.begin();
+        typename InVector::const_iterator xp = x.begin();
+        const I* start = C.start.data();
+        const I* index = C.index.data();
+        const long lines = (long) C.start.size() - 1;
 
-        xp=x.begin();
-        ip=_rowP;
-        jp=_colP;
-        size_t rowI =0;
-        std::vector<uint64_t>::iterator y_cp;
-        y_cp=y_c.begin();
-
-        for(; ip <_rowP+nnz(); ++ip,++jp)
+#pragma omp parallel if (_nnz >= parallelThreshold)
         {
-            if( *ip == rowI) {
-                *(y_cp+(ptrdiff_t)*jp) += *xp;
-            }
-            else {
-                if((*ip-rowI)==1)
-                    ++xp;
-                else
-                    xp=x.begin()+(ptrdiff_t)*ip;
-
-                rowI=*ip;
-                *(y_cp+(ptrdiff_t)*jp) += *xp;
+                // additions only, reduced when the accumulator bound of the field is reached
+            FieldAXPY<Field> accum (field());
+#pragma omp for schedule(static)
+            for (long i = 0; i < lines; ++i) {
+                accum.reset();
+                for (I k = start[i]; k < start[i + 1]; ++k)
+                    accum.accumulate(*(xp + (ptrdiff_t) index[k]));
+                accum.get(*(yp + i));
             }
         }
-
-        integer _prime;
-        field().characteristic(_prime);
-        uint32_t prime = static_cast<uint32_t>(_prime);
-
-        yp=y.begin();
-        y_cp=y_c.begin();
-        for(;yp!=y.end();++yp,++y_cp)
-            *yp =(val_t)( (*y_cp) % prime );
-
         return y;
     }
 
@@ -0,0 +1,534 @@
+/* linbox/field/multimod-lanes.h
+ * Copyright (C) 2026 The LinBox group
+ *
+ * ========LICENCE========
+ * This file is part of the library LinBox.
+ *
+  * LinBox is free software: you can redistribute it and/or modify
+ * it under the terms of the  GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.	 See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ * ========LICENCE========
+ */
+
+/*! @file field/multimod-lanes.h
+ * @ingroup field
+ * @brief Residue number system ring over K word-size primes, one prime per lane.
+ *
+ * An element is a fixed-width array of K residues, e.g. 4 or 8 doubles,
+ * i.e. one AVX2 or AVX-512 register.
+ * All the arithmetic is lane-wise, in loops of constant length K
+ * that the compiler vectorizes.
+ *
+ * A blackbox rebound to \ref MultiModLanes is applied once for K primes:
+ * the sparse index structure is read once, each nonzero carrying K residues.
+ * The ring is \f$\mathbb{Z}/(p_1\cdots p_K)\mathbb{Z}\f$: its characteristic is the
+ * product of the primes and \c convert reconstructs by chinese remaindering,
+ * so that the \ref CRA builders incorporate K primes per iteration,
+ * with \ref MultiPrimeIterator as the prime iterator.
+ *
+ * Only division-free computations (matrix-vector products, dot products,
+ * polynomial evaluations, ...) are meaningful for all lanes:
+ * the inverse of an element having a zero lane is zero in that lane.
+ */
+
+#ifndef __LINBOX_field_multimod_lanes_H
+#define __LINBOX_field_multimod_lanes_H
+
+#include <array>
+#include <cmath>
+#include <iostream>
+#include <vector>
+
+#include <givaro/modular.h>
+#include <givaro/givintfactor.h>
+#include <givaro/givrandom.h>
+
+#include "linbox/linbox-config.h"
+#include "linbox/integer.h"
+#include "linbox/util/debug.h"
+#include "linbox/util/error.h"
+#include "linbox/field/field-documentation.h"
+#include "linbox/field/field-traits.h"
+#include "linbox/randiter/multimod-randomprime.h"
+#include "linbox/util/field-axpy.h"
+#include "linbox/vector/vector-domain.h"
+
+namespace LinBox
+{
+	template <size_t K>
+	class MultiModLanes;
+
+	template <class Ring>
+	struct ClassifyRing;
+
+	template <size_t K>
+	struct ClassifyRing<MultiModLanes<K> > {
+		typedef RingCategories::ModularTag categoryTag;
+	};
+
+	/// Random elements of \ref MultiModLanes, uniform in each lane.
+	template <size_t K>
+	class MultiModLanesRandIter {
+	public:
+		typedef typename MultiModLanes<K>::Element Element;
+
+		MultiModLanesRandIter (const MultiModLanes<K>& F, const integer& size = 0, uint64_t seed = 0) :
+			_field (F), _gen (seed)
+		{}
+
+		MultiModLanesRandIter (const MultiModLanes<K>& F, uint64_t seed) :
+			_field (F), _gen (seed)
+		{}
+
+		Element& random (Element& x) const
+		{
+			for (size_t l = 0; l < K; ++l)
+				x[l] = (double) (_gen () % (uint64_t) _field.modulus (l));
+			return x;
+		}
+
+		const MultiModLanes<K>& ring () const { return _field; }
+
+	protected:
+		const MultiModLanes<K>& _field;
+		mutable Givaro::GivRandom _gen;
+	};
+
+	/** \brief Product of K word-size prime fields, with lane-wise arithmetic.
+	 *
+	 * The primes must be distinct and below \f$2^{26}\f$, so that a product of
+	 * residues is exact in a double; \ref FieldAXPY accumulates
+	 * \f$\lfloor 2^{53}/\max(p_l-1)^2\rfloor\f$ products before reducing,
+	 * thus primes of 22 or 23 bits give long delayed accumulations.
+	 \ingroup field
+	 */
+	template <size_t K>
+	class MultiModLanes : public FieldDocumentation {
+	public:
+		typedef std::array<double, K> Element;
+		typedef MultiModLanesRandIter<K> RandIter;
+		typedef Givaro::Modular<double> Lane;
+		typedef MultiModLanes<K> Self_t;
+
+		static const size_t lanes = K;
+
+		const Element zero, one, mOne;
+
+		/// Ring of the K primes of \p primes.
+		MultiModLanes (const MultiPrime<K>& primes) :
+			MultiModLanes (primes.primes)
+		{}
+
+		/// Ring of the K primes of \p primes.
+		MultiModLanes (const std::array<integer, K>& primes) :
+			zero (filled (0.0)), one (filled (1.0)), mOne (minusOne (primes))
+		{
+			setPrimes (primes);
+		}
+
+		/** Ring modulo the product \p modulus of K distinct primes.
+		 * The primes are recovered by factoring \p modulus,
+		 * e.g. when a \ref CRA loop resumes from its checkpoint.
+		 */
+		MultiModLanes (const integer& modulus) :
+			MultiModLanes (factorPrimes (modulus))
+		{}
+
+		MultiModLanes (const MultiModLanes& F) :
+			zero (F.zero), one (F.one), mOne (F.mOne),
+			_lanes (F._lanes), _p (F._p), _invp (F._invp), _nmax (F._nmax),
+			_modulus (F._modulus), _crtConstant (F._crtConstant), _crtInverse (F._crtInverse)
+		{}
+
+		/// Field of the l-th lane.
+		const Lane& lane (size_t l) const { return _lanes[l]; }
+
+		/// l-th prime.
+		double modulus (size_t l) const { return _p[l]; }
+
+		/// Number of products that can be accumulated in a double before a reduction.
+		size_t maxDelayedProducts () const { return _nmax; }
+
+		integer& cardinality (integer& c) const { return c = _modulus; }
+		integer& characteristic (integer& c) const { return c = _modulus; }
+		integer characteristic () const { return _modulus; }
+
+		Element& init (Element& x) const { return x = zero; }
+
+		Element& init (Element& x, const integer& y) const
+		{
+			for (size_t l = 0; l < K; ++l)
+				_lanes[l].init (x[l], y);
+			return x;
+		}
+
+		template <class Scalar>
+		Element& init (Element& x, const Scalar& y) const
+		{
+			return init (x, integer (y));
+		}
+
+		/// Chinese remaindering of the lanes, in \f$[0, p_1\cdots p_K)\f$.
+		integer& convert (integer& x, const Element& y) const
+		{
+			x = 0;
+			double t;
+			for (size_t l = 0; l < K; ++l) {
+				_lanes[l].mul (t, y[l], _crtInverse[l]);
+				x += integer (t) * _crtConstant[l];
+			}
+			Integer::modin (x, _modulus);
+			return x;
+		}
+
+		Element& assign (Element& x, const Element& y) const { return x = y; }
+
+		bool areEqual (const Element& x, const Element& y) const { return x == y; }
+		bool isZero (const Element& x) const { return x == zero; }
+		bool isOne (const Element& x) const { return x == one; }
+		bool isMOne (const Element& x) const { return x == mOne; }
+
+		Element& add (Element& x, const Element& y, const Element& z) const
+		{
+			for (size_t l = 0; l < K; ++l) {
+				double t = y[l] + z[l];
+				x[l] = t - ((t >= _p[l]) ? _p[l] : 0.0);
+			}
+			return x;
+		}
+
+		Element& sub (Element& x, const Element& y, const Element& z) const
+		{
+			for (size_t l = 0; l < K; ++l) {
+				double t = y[l] - z[l];
+				x[l] = t + ((t < 0.0) ? _p[l] : 0.0);
+			}
+			return x;
+		}
+
+		Element& neg (Element& x, const Element& y) const
+		{
+			for (size_t l = 0; l < K; ++l)
+				x[l] = (y[l] == 0.0) ? 0.0 : _p[l] - y[l];
+			return x;
+		}
+
+		Element& mul (Element& x, const Element& y, const Element& z) const
+		{
+			for (size_t l = 0; l < K; ++l)
+				x[l] = y[l] * z[l];
+			return reduce (x);
+		}
+
+		/// r = a x + y
+		Element& axpy (Element& r, const Element& a, const Element& x, const Element& y) const
+		{
+			for (size_t l = 0; l < K; ++l)
+				r[l] = a[l] * x[l] + y[l];
+			return reduce (r);
+		}
+
+		/// r = a x - y
+		Element& axmy (Element& r, const Element& a, const Element& x, const Element& y) const
+		{
+			for (size_t l = 0; l < K; ++l)
+				r[l] = a[l] * x[l] - y[l];
+			return reduce (r);
+		}
+
+		/// r = y - a x
+		Element& maxpy (Element& r, const Element& a, const Element& x, const Element& y) const
+		{
+			for (size_t l = 0; l < K; ++l)
+				r[l] = y[l] - a[l] * x[l];
+			return reduce (r);
+		}
+
+		/// Lane-wise inverse, a zero lane stays zero.
+		Element& inv (Element& x, const Element& y) const
+		{
+			for (size_t l = 0; l < K; ++l) {
+				if (y[l] == 0.0) x[l] = 0.0;
+				else _lanes[l].inv (x[l], y[l]);
+			}
+			return x;
+		}
+
+		Element& div (Element& x, const Element& y, const Element& z) const
+		{
+			Element t;
+			return mul (x, y, inv (t, z));
+		}
+
+		Element& addin (Element& x, const Element& y) const { return add (x, x, y); }
+		Element& subin (Element& x, const Element& y) const { return sub (x, x, y); }
+		Element& negin (Element& x) const { return neg (x, x); }
+		Element& mulin (Element& x, const Element& y) const { return mul (x, x, y); }
+		Element& invin (Element& x) const { return inv (x, x); }
+		Element& divin (Element& x, const Element& y) const { return div (x, x, y); }
+		Element& axpyin (Element& r, const Element& a, const Element& x) const { return axpy (r, a, x, r); }
+		Element& axmyin (Element& r, const Element& a, const Element& x) const { return axmy (r, a, x, r); }
+		Element& maxpyin (Element& r, const Element& a, const Element& x) const { return maxpy (r, a, x, r); }
+
+		/** Lane-wise reduction of \p x, whose entries are in \f$(-2^{53}, 2^{53})\f$,
+		 * to \f$[0,p_l)\f$.
+		 */
+		Element& reduce (Element& x) const
+		{
+			for (size_t l = 0; l < K; ++l) {
+				double t = x[l] - std::floor (x[l] * _invp[l]) * _p[l];
+				// the floor may be off by one
+				t += (t < 0.0) ? _p[l] : 0.0;
+				x[l] = t - ((t >= _p[l]) ? _p[l] : 0.0);
+			}
+			return x;
+		}
+
+		std::ostream& write (std::ostream& os) const
+		{
+			os << "multimod lanes (";
+			for (size_t l = 0; l < K; ++l)
+				os << integer (_p[l]) << ((l + 1 < K) ? "," : ")");
+			return os;
+		}
+
+		std::ostream& write (std::ostream& os, const Element& x) const
+		{
+			os << '(';
+			for (size_t l = 0; l < K; ++l)
+				os << x[l] << ((l + 1 < K) ? "," : ")");
+			return os;
+		}
+
+		std::istream& read (std::istream& is, Element& x) const
+		{
+			integer tmp;
+			is >> tmp;
+			init (x, tmp);
+			return is;
+		}
+
+		static inline double maxCardinality () { return 67108864.0; } // 2^26
+
+	protected:
+		static Element filled (double v)
+		{
+			Element x;
+			x.fill (v);
+			return x;
+		}
+
+		static Element minusOne (const std::array<integer, K>& primes)
+		{
+			Element x;
+			for (size_t l = 0; l < K; ++l)
+				x[l] = (double) primes[l] - 1.0;
+			return x;
+		}
+
+		static std::array<integer, K> factorPrimes (const integer& modulus)
+		{
+			std::vector<integer> factors;
+			std::vector<size_t> exponents;
+			Givaro::IntFactorDom<> FD;
+			FD.set (factors, exponents, modulus);
+			if (factors.size () != K)
+				throw LinboxError ("LinBox ERROR: MultiModLanes modulus is not a product of K primes\n");
+			std::array<integer, K> primes;
+			for (size_t l = 0; l < K; ++l) {
+				if (exponents[l] != 1)
+					throw LinboxError ("LinBox ERROR: MultiModLanes modulus is not squarefree\n");
+				primes[l] = factors[l];
+			}
+			return primes;
+		}
+
+		void setPrimes (const std::array<integer, K>& primes)
+		{
+			_lanes.clear ();
+			_lanes.reserve (K);
+			_modulus = 1;
+			double pmax = 0.0;
+			for (size_t l = 0; l < K; ++l) {
+				linbox_check (primes[l] < integer (maxCardinality ()));
+				_lanes.emplace_back (primes[l]);
+				_p[l] = (double) primes[l];
+				_invp[l] = 1.0 / _p[l];
+				_modulus *= primes[l];
+				pmax = std::max (pmax, _p[l]);
+			}
+			for (size_t l = 0; l < K; ++l) {
+				double t;
+				_crtConstant[l] = _modulus / primes[l];
+				_lanes[l].init (t, _crtConstant[l]);
+				_lanes[l].inv (_crtInverse[l], t);
+			}
+			// nmax products and a residue stay below 2^53
+			_nmax = (size_t) std::floor ((9007199254740992.0 - pmax) / ((pmax - 1.0) * (pmax - 1.0)));
+			_nmax = (_nmax > 0) ? _nmax : 1;
+		}
+
+		std::vector<Lane> _lanes;
+		Element _p, _invp;
+		size_t _nmax;
+
+		integer _modulus;
+		std::array<integer, K> _crtConstant;
+		Element _crtInverse;
+	};
+
+	/** Delayed accumulation over \ref MultiModLanes:
+	 * the lanes are reduced every \c maxDelayedProducts() products.
+	 */
+	template <size_t K>
+	class FieldAXPY<MultiModLanes<K> > {
+	public:
+		typedef MultiModLanes<K> Field;
+		typedef typename Field::Element Element;
+		typedef Element Abnormal;
+
+		FieldAXPY (const Field& F) :
+			_field (&F), _y (F.zero), _count (0)
+		{}
+
+		FieldAXPY (const FieldAXPY& faxpy) :
+			_field (faxpy._field), _y (faxpy._y), _count (faxpy._count)
+		{}
+
+		Element& mulacc (const Element& a, const Element& x)
+		{
+			for (size_t l = 0; l < K; ++l)
+				_y[l] += a[l] * x[l];
+			return normalize ();
+		}
+
+		Element& accumulate (const Element& t)
+		{
+			for (size_t l = 0; l < K; ++l)
+				_y[l] += t[l];
+			return normalize ();
+		}
+
+		Element& subumulate (const Element& t)
+		{
+			for (size_t l = 0; l < K; ++l)
+				_y[l] -= t[l];
+			return normalize ();
+		}
+
+		Element& get (Element& y)
+		{
+			field ().reduce (_y);
+			_count = 0;
+			return y = _y;
+		}
+
+		FieldAXPY& assign (const Element& y)
+		{
+			_y = y;
+			_count = 0;
+			return *this;
+		}
+
+		void reset ()
+		{
+			_y = field ().zero;
+			_count = 0;
+		}
+
+		Element& set (const Element& t)
+		{
+			_y = t;
+			_count = 0;
+			return _y;
+		}
+
+		inline const Field& field () const { return *_field; }
+
+	protected:
+		Element& normalize ()
+		{
+			if (++_count >= field ().maxDelayedProducts ()) {
+				field ().reduce (_y);
+				_count = 0;
+			}
+			return _y;
+		}
+
+		const Field* _field;
+		Element _y;
+		size_t _count;
+	};
+
+	/// Dot products over \ref MultiModLanes, by blocks of delayed products.
+	template <size_t K>
+	class DotProductDomain<MultiModLanes<K> > : public VectorDomainBase<MultiModLanes<K> > {
+	public:
+		typedef MultiModLanes<K> Field;
+		typedef typename Field::Element Element;
+
+		DotProductDomain (const Field& F) :
+			VectorDomainBase<Field> (F)
+		{}
+
+		using VectorDomainBase<Field>::field;
+
+	protected:
+		template <class Vector1, class Vector2>
+		inline Element& dotSpecializedDD (Element& res, const Vector1& v1, const Vector2& v2) const
+		{
+			const size_t nmax = field ().maxDelayedProducts ();
+			Element y = field ().zero;
+			for (size_t i = 0; i < v1.size (); i += nmax) {
+				const size_t iend = std::min (v1.size (), i + nmax);
+				for (size_t j = i; j < iend; ++j) {
+					const Element& a = v1[j];
+					const Element& x = v2[j];
+					for (size_t l = 0; l < K; ++l)
+						y[l] += a[l] * x[l];
+				}
+				field ().reduce (y);
+			}
+			return res = y;
+		}
+
+		template <class Vector1, class Vector2>
+		inline Element& dotSpecializedDSP (Element& res, const Vector1& v1, const Vector2& v2) const
+		{
+			const size_t nmax = field ().maxDelayedProducts ();
+			Element y = field ().zero;
+			for (size_t i = 0; i < v1.first.size (); i += nmax) {
+				const size_t iend = std::min (v1.first.size (), i + nmax);
+				for (size_t j = i; j < iend; ++j) {
+					const Element& a = v1.second[j];
+					const Element& x = v2[v1.first[j]];
+					for (size_t l = 0; l < K; ++l)
+						y[l] += a[l] * x[l];
+				}
+				field ().reduce (y);
+			}
+			return res = y;
+		}
+	};
+
+} // namespace LinBox
+
+#endif // __LINBOX_field_multimod_lanes_H
+
+// Local Variables:
+// mode: C++
+// tab-width: 4
+// indent-tabs-mode: nil
+// c-basic-offset: 4
+// End:
+// vim:sts=4:sw=4:ts=4:et:sr:cino=>s,f0,{0,g0,(0,\:0,t0,+0,=s
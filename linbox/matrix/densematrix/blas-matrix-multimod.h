@@ -26,175 +26,216 @@
 
 /*! @file matrix/blas-matrix-multimod.h
  * @ingroup matrix
- * A \c BlasMatrix<\c _Field > represents a matrix as an array of
- * <code>_Field::Element</code>s. It also has the BlasBlackbox interface.
+ * @brief Integer matrix kept in a residue number system.
  *
- */
-
-/*! @file matrix/blas-matrix-multimod.h
- * @brief specialisation for mutlimod field.
+ * A \c BlasMatrix<\c MultiModDouble> stores an integer matrix by its
+ * residues modulo the primes of the \c MultiModDouble, as one dense
+ * \c Givaro::Modular<double> matrix per prime.  The reduction of an
+ * integer matrix and the reconstruction are the multi-modular ones of
+ * \c FFPACK::rns_double (a single matrix product each way), so that a
+ * chain of products (\c BLAS3::mul with \c mulMethod::RNS) only pays for
+ * them once.
  */
 
 #ifndef __LINBOX_blas_matrix_multimod_H
 #define __LINBOX_blas_matrix_multimod_H
 
-#include "linbox/util/debug.h"
+#include <vector>
 
-// #include "linbox/vector/subiterator.h"
-// #include "linbox/vector/subvector.h"
+#include <fflas-ffpack/field/rns-double.h>
 
+#include "linbox/util/debug.h"
+#include "linbox/util/error.h"
+#include "linbox/integer.h"
+#include "linbox/field/multimod-field.h"
 #include "linbox/matrix/matrix-category.h"
 #include "linbox/linbox-tags.h"
 #include "linbox/matrix/dense-matrix.h"
 
-THIS_CODE_MAY_NOT_COMPILE_AND_IS_NOT_TESTED
-
 namespace LinBox
 { /*  Specialisation of BlasMatrix for MultiModDouble field */
 
-	/*! No Doc.
-	*/
+	/** \brief Integer matrix in residue number system.
+	 *
+	 * The residues modulo the prime \f$p_l\f$ form the row major
+	 * \c rowdim() x \c coldim() matrix at \c getPointer(l), over
+	 * \c residueField(l).  The matrix also carries a bound on the absolute
+	 * value of its integer entries: the reconstruction is exact as long as
+	 * twice this magnitude is below the product of the primes.
+	 */
 	template<>
 	class BlasMatrix<MultiModDouble> {
 
 	public:
 
-		typedef MultiModDouble         Field;
-		typedef std::vector<double>  Element;
-		typedef BlasMatrix<MultiModDouble> Self_t;
+		typedef MultiModDouble                       Field;
+		typedef std::vector<double>                  Element;
+		typedef BlasMatrix<MultiModDouble>           Self_t;
+		typedef Givaro::Modular<double>              ResidueField;
+		typedef BlasMatrix<Givaro::ZRing<Integer> >  IntegerMatrix;
 
 	protected:
 
-		MultiModDouble                 _field;
-		const std::vector<MatrixDomain<Givaro::Modular<double> > >   _MD;
+		MultiModDouble          _field;
 		size_t                  _row,_col;
-		Element                _One,_Zero; //! @warning used ?
-		std::vector<BlasMatrix<Givaro::Modular<double> >* > _rep;
-		mutable std::vector<double>       _entry;
-	public:
+		std::vector<double>     _rep;   //!< residues, prime after prime
+		integer                 _mag;   //!< bound on the absolute value of the entries
+		mutable Element         _entry;
 
+	public:
 
-		//BlasMatrix () {}
-
-		BlasMatrix (const MultiModDouble& F) :
-			_field(F) , _rep(F.size()), _entry(F.size())
+		BlasMatrix (const Field& F, size_t m = 0, size_t n = 0) :
+			_field(F), _row(m), _col(n), _rep(F.size()*m*n, 0.), _mag(0), _entry(F.size())
 		{}
 
-		BlasMatrix (const Field& F, size_t m, size_t n, bool alloc=true) :
-			_field(F), _row(m) , _col(n) , _rep(F.size()),  _entry(F.size())
+		/** Residues of an integer matrix, by one multi-modular reduction.
+		 * @param F the primes, their product must be more than twice the
+		 * magnitude of the results computed from this matrix.
+		 * @param A integer matrix
+		 */
+		BlasMatrix (const Field& F, const IntegerMatrix& A) :
+			_field(F), _row(A.rowdim()), _col(A.coldim()), _rep(F.size()*A.rowdim()*A.coldim()),
+			_mag(0), _entry(F.size())
 		{
-			for (size_t i=0;i<_rep.size();++i)
-				_rep[i] =  new BlasMatrix<Givaro::Modular<double> > (F.getBase(i), m, n);
+			for (size_t i = 0; i < _row; ++i)
+				for (size_t j = 0; j < _col; ++j)
+					if (_mag < Givaro::abs(A.getEntry(i,j)))
+						_mag = Givaro::abs(A.getEntry(i,j));
+			checkMagnitude();
+			const size_t mn = _row*_col;
+			if (mn == 0) return;
+			FFPACK::rns_double RNS(basis());
+			RNS.init(1, mn, _rep.data(), mn, A.getPointer(), mn, _mag);
 		}
 
-		BlasMatrix (const BlasMatrix<MultiModDouble> & A):
-			_field(A._field),_row(A._row), _col(A._col),
-			_rep(A._rep.size()), _entry(A._entry)
-		{
+		size_t rowdim() const {return _row;}
 
-			for (size_t i=0;i<_rep.size();++i)
-				_rep[i]= new  BlasMatrix<Givaro::Modular<double> > (const_cast<BlasMatrix<Givaro::Modular<double> >& >( *A._rep[i]));
-		}
+		size_t coldim() const {return _col;}
 
+		const Field &field() const  {return _field;}
 
-		const BlasMatrix<MultiModDouble>& operator=(const BlasMatrix<MultiModDouble> & A)
-		{
-			_field   = A._field;
-			_row = A._row;
-			_col = A._col;
-			_rep = std::vector<BlasMatrix<Givaro::Modular<double> >* >(A._rep.size());
-			_entry = A._entry;
-			for (size_t i=0;i<_rep.size();++i)
-				_rep[i]= new  BlasMatrix<Givaro::Modular<double> > (const_cast<BlasMatrix<Givaro::Modular<double> >& >( *A._rep[i]));
-			return *this;
-		}
+		//! number of primes
+		size_t size() const {return _field.size();}
 
+		const ResidueField& residueField(size_t l) const {return _field.getBase(l);}
 
-		~BlasMatrix() {for (size_t i=0; i< _rep.size();++i) {delete _rep[i];} }
+		double* getPointer(size_t l) {return _rep.data() + l*_row*_col;}
+		const double* getPointer(size_t l) const {return _rep.data() + l*_row*_col;}
+		size_t getStride() const {return _col;}
 
-		template <class Vector1, class Vector2>
-		Vector1&  apply (Vector1& y, const Vector2& x) const
+		//! whether \p B has the same primes, in the same order
+		bool sameBasis(const Self_t& B) const
 		{
-			for (size_t i=0;i<_rep.size();++i) {
-				std::vector<double> x_tmp(x.size()), y_tmp(y.size());
-				for (size_t j=0;j<x.size();++j)
-					x_tmp[j]= x[j][i];
-
-				_rep[i]->apply(y_tmp, x_tmp);
-
-				for (size_t j=0;j<y.size();++j){
-					y[j][i]=y_tmp[j];
+			if (size() != B.size()) return false;
+			for (size_t l = 0; l < size(); ++l)
+				if (_field.getModulo(l) != B._field.getModulo(l))
+					return false;
+			return true;
+		}
 
-				}
-			}
+		//! bound on the absolute value of the integer entries
+		const integer& magnitude() const {return _mag;}
 
-			return y;
+		/** Sets the bound on the integer entries, for a matrix whose residues
+		 * were written directly.
+		 */
+		void setMagnitude(const integer& mag)
+		{
+			_mag = mag;
+			checkMagnitude();
 		}
 
-		template <class Vector1, class Vector2>
-		Vector1&  applyTranspose (Vector1& y, const Vector2& x) const
+		void resize(size_t m, size_t n)
 		{
-			for (size_t i=0;i<_rep.size();++i) {
-				std::vector<double> x_tmp(x.size()), y_tmp(y.size());
-				for (size_t j=0;j<x.size();++j)
-					x_tmp[i]= x[j][i];
-
-				_rep[i]->applyTranspose(y_tmp, x_tmp);
-
-				for (size_t j=0;j<y.size();++j)
-					y[j][i]=y_tmp[i];
-			}
-
-			return y;
+			_row = m; _col = n;
+			_rep.assign(size()*m*n, 0.);
+			_mag = 0;
 		}
 
-#if 0
-		template<typename _Tp1>
-		struct rebind
+		/** The integer matrix, by one multi-modular reconstruction.
+		 * Entries are in the symmetric range.
+		 */
+		IntegerMatrix& convert(IntegerMatrix& A) const
 		{
-			typedef BlasMatrix<_Tp1> other;
-
-			void operator() (other *& Ap, const Self_t& A, const _Tp1& F) {
-				Ap = new other(F, A.rowdim(), A.coldim());
-				Hom<Field, _Tp1> hom(A. field(), F);
-
-				hom.image (*Ap_p, *A_p);
-			}
-		};
-#endif
-
-		size_t rowdim() const {return _row;}
+			linbox_check(A.rowdim() == _row && A.coldim() == _col);
+			const size_t mn = _row*_col;
+			if (mn == 0) return A;
+			FFPACK::rns_double RNS(basis());
+			RNS.convert(1, mn, integer(0), A.getPointer(), mn, _rep.data(), mn);
+			const integer &M = _field.getCRTmodulo();
+			const integer hM = (M-1)/2;
+			integer *x = A.getPointer();
+			for (size_t i = 0; i < mn; ++i)
+				if (x[i] > hM) x[i] -= M;
+			return A;
+		}
 
-		size_t coldim() const {return _col;}
+		const Element& setEntry (size_t i, size_t j, const Element &a_ij)
+		{
+			for (size_t l=0; l< size(); ++l)
+				getPointer(l)[i*_col+j] = a_ij[l];
+			return a_ij;
+		}
 
+		const Element& getEntry (size_t i, size_t j) const
+		{
+			for (size_t l=0; l< size(); ++l)
+				_entry[l] = getPointer(l)[i*_col+j];
+			return _entry;
+		}
 
-		const Field &field() const  {return _field;}
+		template <class Vector1, class Vector2>
+		Vector1&  apply (Vector1& y, const Vector2& x) const
+		{
+			return applyResidues(FFLAS::FflasNoTrans, y, x);
+		}
 
+		template <class Vector1, class Vector2>
+		Vector1&  applyTranspose (Vector1& y, const Vector2& x) const
+		{
+			return applyResidues(FFLAS::FflasTrans, y, x);
+		}
 
 		std::ostream& write(std::ostream& os) const
 		{
-			for (size_t i=0;i<_rep.size();++i)
-				_rep[i]->write(os);
+			for (size_t l=0;l<size();++l) {
+				BlasMatrix<ResidueField> R(residueField(l), _row, _col);
+				std::copy(getPointer(l), getPointer(l) + _row*_col, R.getPointer());
+				R.write(os);
+			}
 			return os;
 		}
 
+	protected:
 
-		const Element& setEntry (size_t , size_t j, const Element &a_ij)
+		template <class Vector1, class Vector2>
+		Vector1& applyResidues (FFLAS::FFLAS_TRANSPOSE t, Vector1& y, const Vector2& x) const
 		{
-			for (size_t i=0; i< _rep.size();++i)
-				_rep[i]->setEntry(i,j,a_ij[i]);
-            return a_ij;
+			std::vector<double> x_tmp(x.size()), y_tmp(y.size());
+			for (size_t l=0;l<size();++l) {
+				for (size_t j=0;j<x.size();++j)
+					x_tmp[j]= x[j][l];
+				FFLAS::fgemv(residueField(l), t, _row, _col, 1., getPointer(l), _col,
+					     x_tmp.data(), 1, 0., y_tmp.data(), 1);
+				for (size_t j=0;j<y.size();++j)
+					y[j][l]= y_tmp[j];
+			}
+			return y;
 		}
 
-
-		const Element& getEntry (size_t , size_t j) const
+		std::vector<double> basis() const
 		{
-			for (size_t i=0; i< _rep.size();++i)
-				_entry[i]=_rep[i]->getEntry(i,j);
-			return _entry;
+			std::vector<double> b(size());
+			for (size_t l = 0; l < size(); ++l)
+				b[l] = (double) _field.getModulo(l);
+			return b;
 		}
 
-		BlasMatrix<Givaro::Modular<double> >*& getMatrix(size_t i) {return _rep[i];}
+		void checkMagnitude() const
+		{
+			if (2*_mag >= _field.getCRTmodulo())
+				throw LinboxError("BlasMatrix<MultiModDouble>: the RNS basis is too small for the magnitude of the matrix");
+		}
 
 	};
 
@@ -206,7 +247,7 @@ namespace LinBox
 	};
 } // LinBox
 
-#endif // __LINBOX_blas_matrix_H
+#endif // __LINBOX_blas_matrix_multimod_H
 
 // Local Variables:
 // mode: C++
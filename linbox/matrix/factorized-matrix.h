@@ -36,6 +36,7 @@
 #include "linbox/matrix/densematrix/blas-matrix.h"
 
 #include "linbox/matrix/permutation-matrix.h"
+#include "linbox/matrix/matrixdomain/blas-parallel-policy.h"
 
 namespace LinBox
 {
@@ -85,13 +86,13 @@ namespace LinBox
 
 	public:
 
-		//! Contruction of PLUQ factorization of A (making a copy of A)
+		//! Contruction of PLUQ factorization of A (making a copy of A), parallel according to \p Par
 		template<class _Rep>
-		PLUQMatrix (const BlasMatrix<Field,_Rep>& A) ;
+		PLUQMatrix (const BlasMatrix<Field,_Rep>& A, const BlasParallelPolicy& Par = BlasParallelPolicy()) ;
 
-		//! Contruction of PLUQ factorization of A (in-place in A) 
+		//! Contruction of PLUQ factorization of A (in-place in A), parallel according to \p Par
 		template<class _Rep>
-		PLUQMatrix (BlasMatrix<Field,_Rep>& A) ;
+		PLUQMatrix (BlasMatrix<Field,_Rep>& A, const BlasParallelPolicy& Par = BlasParallelPolicy()) ;
 
 
 		/*! Contruction of PLUQ factorization of A (making a copy of A).
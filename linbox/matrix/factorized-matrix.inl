@@ -1045,7 +1045,7 @@ namespace LinBox
 {
 	template <class Field>
 	template <class _Rep>
-	PLUQMatrix<Field>::PLUQMatrix (const BlasMatrix<Field,_Rep>& A) :
+	PLUQMatrix<Field>::PLUQMatrix (const BlasMatrix<Field,_Rep>& A, const BlasParallelPolicy& Par) :
 		_field(A.field()), _factLU(*(new BlasMatrix<Field,_Rep> (A))) ,
 		_permP(*(new BlasPermutation<size_t>(A.rowdim()))),
 		_permQ(*(new BlasPermutation<size_t>(A.coldim()))),
@@ -1057,7 +1057,7 @@ namespace LinBox
 			_rank = 0 ;
 		}
 		else {
-			_rank= FFPACK::PLUQ (_field, FFLAS::FflasNonUnit, _m, _n,
+			_rank= BlasParallel::PLUQ (Par, _field, FFLAS::FflasNonUnit, _m, _n,
 						 _factLU.getPointer(),_factLU.getStride(),
 						 _permP.getPointer(), _permQ.getPointer());
 		}
@@ -1065,7 +1065,7 @@ namespace LinBox
 
 	template <class Field>
 	template <class _Rep>
-	PLUQMatrix<Field>::PLUQMatrix (BlasMatrix<Field,_Rep>& A) :
+	PLUQMatrix<Field>::PLUQMatrix (BlasMatrix<Field,_Rep>& A, const BlasParallelPolicy& Par) :
 		_field(A.field()), _factLU(static_cast<BlasMatrix<Field,_Rep>&> (A)) ,
 		_permP(*(new BlasPermutation<size_t>(A.rowdim()))),
 		_permQ(*(new BlasPermutation<size_t>(A.coldim()))),
@@ -1077,7 +1077,7 @@ namespace LinBox
 			_rank = 0 ;
 		}
 		else {
-			_rank= FFPACK::PLUQ( _field,FFLAS::FflasNonUnit, _m, _n,
+			_rank= BlasParallel::PLUQ( Par, _field,FFLAS::FflasNonUnit, _m, _n,
 						 _factLU.getPointer(),_factLU.getStride(),
 						 _permP.getPointer(), _permQ.getPointer());
 		}
@@ -59,24 +59,26 @@ namespace LinBox {
         
         static Matrix1&  muladdspe( Matrix1 &D,
                                     const Element &beta,   const Matrix2 &C,
-                                    const Element & alpha, const Matrix3 &A, const Matrix4 &B) 
+                                    const Element & alpha, const Matrix3 &A, const Matrix4 &B,
+                                    const BlasParallelPolicy &P = BlasParallelPolicy())
 		{
 			linbox_check( D.rowdim() == C.rowdim());
 			linbox_check( D.coldim() == C.coldim());            
             D.copy(C);
-            return muladdspe(beta, D, alpha, A, B);
+            return muladdspe(beta, D, alpha, A, B, P);
 		}
         
         static Matrix1&  muladdspe(const Element &beta,   Matrix1 &C,
-                                   const Element & alpha, const Matrix3 &A, const Matrix4 &B) 
+                                   const Element & alpha, const Matrix3 &A, const Matrix4 &B,
+                                   const BlasParallelPolicy &P = BlasParallelPolicy())
         {
             linbox_check( A.coldim() == B.rowdim()); linbox_check( C.rowdim() == A.rowdim());
 			linbox_check( C.coldim() == B.coldim());            
 
-            FFLAS::fgemm( C.field(), isTransposed<Matrix3>::value, isTransposed<Matrix4>::value,
-                          C.rowdim(), C.coldim(), A.coldim(),
-                          alpha, A.getPointer(), A.getStride() , B.getPointer(), B.getStride(),
-                          beta,  C.getPointer(), C.getStride());
+            BlasParallel::fgemm( P, C.field(), isTransposed<Matrix3>::value, isTransposed<Matrix4>::value,
+                                 C.rowdim(), C.coldim(), A.coldim(),
+                                 alpha, A.getPointer(), A.getStride() , B.getPointer(), B.getStride(),
+                                 beta,  C.getPointer(), C.getStride());
 			return C;
         }
     };
@@ -88,14 +90,16 @@ namespace LinBox {
         typedef typename Matrix::Field::Element Element;        
         static Vector1&  muladdspe( Vector1 &d,
                                    const Element &beta,   const Vector2 &c,
-                                   const Element & alpha, const Vector3 &a, const Matrix &B) 
+                                   const Element & alpha, const Vector3 &a, const Matrix &B,
+                                   const BlasParallelPolicy & = BlasParallelPolicy())
 		{
 			linbox_check( d.size()   == c.size());
 			d.copy(c);            
 			return muladdspe(beta,d,alpha,a,B);
 		}
         static Vector1& muladdspe(const Element &beta,   Vector1 &c,
-                                  const Element & alpha, const Vector3 &a, const Matrix &B) 
+                                  const Element & alpha, const Vector3 &a, const Matrix &B,
+                                  const BlasParallelPolicy & = BlasParallelPolicy())
         {
            	linbox_check( B.rowdim() == a.size());
 			linbox_check( B.coldim() == c.size());
@@ -112,7 +116,8 @@ namespace LinBox {
         typedef typename Matrix::Field::Element Element;        
         static Vector1&  muladdspe( Vector1 &d,
                                    const Element &beta,   const Vector2 &c,
-                                   const Element & alpha, const Matrix &A, const Vector2 &b) 
+                                   const Element & alpha, const Matrix &A, const Vector2 &b,
+                                   const BlasParallelPolicy & = BlasParallelPolicy())
 		{
 			linbox_check( d.size()   == c.size());
 			d.copy(c);            
@@ -120,7 +125,8 @@ namespace LinBox {
 		}
         
         static Vector1&  muladdspe (const Element &beta,   Vector1 &c,
-                                    const Element & alpha, const Matrix &A, const Vector3 &b) 
+                                    const Element & alpha, const Matrix &A, const Vector3 &b,
+                                    const BlasParallelPolicy & = BlasParallelPolicy())
         {
           	linbox_check( A.coldim() == b.size());
 			linbox_check( A.rowdim() == c.size()); 
@@ -147,6 +153,7 @@ namespace LinBox {
 	template<class Matrix1, class Matrix2>
 	class BlasMatrixDomainMul<Matrix1, Matrix2, BlasPermutation<size_t> > {
 	public:
+		BlasMatrixDomainMul (const BlasParallelPolicy & = BlasParallelPolicy ()) {}
 		Matrix1 & operator()(Matrix1& C, const Matrix2& A, const BlasPermutation<size_t>& B) const
 		{
 			C.copy(A);
@@ -156,6 +163,7 @@ namespace LinBox {
     template<class Matrix1, class Matrix2>
 	class BlasMatrixDomainMul<Matrix1, BlasPermutation<size_t>, Matrix2> {
 	public:
+		BlasMatrixDomainMul (const BlasParallelPolicy & = BlasParallelPolicy ()) {}
         Matrix1 & operator()(Matrix1& C, const BlasPermutation<size_t>& A, const Matrix2& B) const
 		{
 			C.copy(B);
@@ -165,6 +173,7 @@ namespace LinBox {
     template<class Matrix1, class Matrix2>
 	class BlasMatrixDomainMul<Matrix1, Matrix2, TransposedBlasMatrix<BlasPermutation<size_t>> > {
 	public:
+		BlasMatrixDomainMul (const BlasParallelPolicy & = BlasParallelPolicy ()) {}
 		Matrix1 & operator()(Matrix1& C, const Matrix2& A, const TransposedBlasMatrix<BlasPermutation<size_t>>& B) const
 		{
 			C.copy(A);
@@ -174,6 +183,7 @@ namespace LinBox {
     template<class Matrix1, class Matrix2>
 	class BlasMatrixDomainMul<Matrix1, TransposedBlasMatrix<BlasPermutation<size_t>>, Matrix2> {
 	public:
+		BlasMatrixDomainMul (const BlasParallelPolicy & = BlasParallelPolicy ()) {}
         Matrix1 & operator()(Matrix1& C, const TransposedBlasMatrix<BlasPermutation<size_t>>& A, const Matrix2& B) const
 		{
 			C.copy(B);
@@ -187,6 +197,7 @@ namespace LinBox {
 	template<class Matrix1,class Matrix2, class Matrix3>
 	class BlasMatrixDomainMul<Matrix1, Matrix2, TriangularBlasMatrix<Matrix3> > {
 	public:
+		BlasMatrixDomainMul (const BlasParallelPolicy & = BlasParallelPolicy ()) {}
 		Matrix1& operator()(Matrix1& C, const Matrix2 & A, const TriangularBlasMatrix<Matrix3>& B) const
 		{
 			C.copy(A);
@@ -196,6 +207,7 @@ namespace LinBox {
     template<class Matrix1,class Matrix2, class Matrix3>
 	class BlasMatrixDomainMul<Matrix1, TriangularBlasMatrix<Matrix3>, Matrix2 > {
 	public:
+		BlasMatrixDomainMul (const BlasParallelPolicy & = BlasParallelPolicy ()) {}
 		Matrix1& operator()(Matrix1& C, const TriangularBlasMatrix<Matrix3>& B, const Matrix2& A) const
 		{
           
@@ -208,6 +220,7 @@ namespace LinBox {
 	template<class Matrix1,class Matrix2>
 	class BlasMatrixDomainMul<Matrix1, TriangularBlasMatrix<Matrix2>, BlasPermutation<size_t> > {
 	public:
+		BlasMatrixDomainMul (const BlasParallelPolicy & = BlasParallelPolicy ()) {}
         Matrix1& operator()(Matrix1& C, const TriangularBlasMatrix<Matrix2>& A, const BlasPermutation<size_t>& B) const
 		{
 			C.copy(A);
@@ -217,6 +230,7 @@ namespace LinBox {
 	template<class Matrix1,class Matrix2>
 	class BlasMatrixDomainMul<Matrix1, BlasPermutation<size_t>, TriangularBlasMatrix<Matrix2> > {
 	public:
+		BlasMatrixDomainMul (const BlasParallelPolicy & = BlasParallelPolicy ()) {}
 		Matrix1& operator()(Matrix1& C, const BlasPermutation<size_t>& B, const TriangularBlasMatrix<Matrix2>& A) const
 		{
 			C.copy(A);
@@ -228,6 +242,7 @@ namespace LinBox {
     template<class Matrix1, class Matrix2, class Matrix3>
 	class BlasMatrixDomainMul<Matrix1,  TriangularBlasMatrix<Matrix2> , TriangularBlasMatrix<Matrix3> > {
 	public:
+		BlasMatrixDomainMul (const BlasParallelPolicy & = BlasParallelPolicy ()) {}
         Matrix1 & operator()(Matrix1& C, const  TriangularBlasMatrix<Matrix2> & A, const TriangularBlasMatrix<Matrix3>& B) const
         {
             typename TriangularBlasMatrix<Matrix3>::constSubMatrixType Bplain(B);                        
@@ -247,6 +262,7 @@ namespace LinBox {
 	template<class Matrix>
 	class BlasMatrixDomainMulin<Matrix, BlasPermutation<size_t> > {
 	public:
+		BlasMatrixDomainMulin (const BlasParallelPolicy & = BlasParallelPolicy ()) {}
 		Matrix& operator()(Matrix& A, const BlasPermutation<size_t>& B) const
 		{
 			if (B.isIdentity()) return A ;
@@ -285,6 +301,7 @@ namespace LinBox {
 	template<class Matrix>
 	class BlasMatrixDomainMulin<Matrix, TransposedBlasMatrix<BlasPermutation<size_t>>> {
 	public:
+		BlasMatrixDomainMulin (const BlasParallelPolicy & = BlasParallelPolicy ()) {}
 		Matrix& operator()(Matrix& A, const TransposedBlasMatrix<BlasPermutation<size_t> >& B) const
 		{
             BlasPermutation<size_t>& BB=B.getMatrix();
@@ -328,6 +345,7 @@ namespace LinBox {
 	template<class Field>
 	class BlasMatrixDomainMulin<BlasVector<Field>, BlasPermutation<size_t> > {
 	public:
+		BlasMatrixDomainMulin (const BlasParallelPolicy & = BlasParallelPolicy ()) {}
 		BlasVector<Field>& operator()(BlasVector<Field>& A, const BlasPermutation<size_t>& B) const
 		{           
 			if (B.isIdentity()) return A ;
@@ -349,6 +367,7 @@ namespace LinBox {
     template<class Field>
 	class BlasMatrixDomainMulin<BlasVector<Field>, TransposedBlasMatrix<BlasPermutation<size_t>>> {
 	public:
+		BlasMatrixDomainMulin (const BlasParallelPolicy & = BlasParallelPolicy ()) {}
 		BlasVector<Field>& operator()(BlasVector<Field>& A, const TransposedBlasMatrix<BlasPermutation<size_t>>& B) const
 		{
              BlasPermutation<size_t>& BB=B.getMatrix();
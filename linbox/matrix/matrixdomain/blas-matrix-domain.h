@@ -53,6 +53,7 @@
 #include "linbox/matrix/dense-matrix.h"
 #include "linbox/matrix/permutation-matrix.h"
 #include "linbox/matrix/factorized-matrix.h"
+#include "linbox/matrix/matrixdomain/blas-parallel-policy.h"
 
 
 
@@ -73,8 +74,10 @@ namespace LinBox
     struct BlasMatrixDomainMulAdd_specialized
     {
         typedef typename Operand1::Field::Element Element;        
-        static Operand1&  muladdspe( Operand1 &D,const Element &beta,const Operand2 &C,const Element & alpha, const Operand3 &A, const Operand4 &B); 
-        static Operand1&  muladdspe( const Element &beta,const Operand2 &C,const Element & alpha, const Operand3 &A, const Operand4 &B);  
+        static Operand1&  muladdspe( Operand1 &D,const Element &beta,const Operand2 &C,const Element & alpha, const Operand3 &A, const Operand4 &B,
+                                     const BlasParallelPolicy &P = BlasParallelPolicy());
+        static Operand1&  muladdspe( const Element &beta,const Operand2 &C,const Element & alpha, const Operand3 &A, const Operand4 &B,
+                                     const BlasParallelPolicy &P = BlasParallelPolicy());
     };
     
 	template<class Operand1, class Operand2, class Operand3, class Operand4/*, class MatrixVectorType*/>
@@ -82,13 +85,15 @@ namespace LinBox
 	{
 	public:
 		typedef typename Operand1::Field Field;
+		BlasMatrixDomainMulAdd (const BlasParallelPolicy &P = BlasParallelPolicy ()) : _policy (P) {}
+
 		Operand1 &operator() (Operand1 &D,
                               const typename Field::Element &beta, const Operand2 &C,
                               const typename Field::Element &alpha, const Operand3 &A, const Operand4 &B) const
         {
             return BlasMatrixDomainMulAdd_specialized<Operand1,Operand2,Operand3,Operand4,
                                                       typename ContainerTraits<Operand3>::ContainerCategory,
-                                                      typename ContainerTraits<Operand4>::ContainerCategory>::muladdspe(D,beta,C,alpha,A,B);  
+                                                      typename ContainerTraits<Operand4>::ContainerCategory>::muladdspe(D,beta,C,alpha,A,B,_policy);
         }
 
 		Operand1 &operator() (const typename Field::Element &beta, Operand2 &C,
@@ -96,8 +101,11 @@ namespace LinBox
         {
             return BlasMatrixDomainMulAdd_specialized<Operand1,Operand2,Operand3,Operand4,
                                                       typename ContainerTraits<Operand3>::ContainerCategory,
-                                                      typename ContainerTraits<Operand4>::ContainerCategory>::muladdspe(beta,C,alpha,A,B);
+                                                      typename ContainerTraits<Operand4>::ContainerCategory>::muladdspe(beta,C,alpha,A,B,_policy);
         }
+
+	protected:
+		BlasParallelPolicy _policy;
 	};
 	
 
@@ -146,10 +154,15 @@ namespace LinBox
 	template< class Operand1, class Operand2, class Operand3>
 	class BlasMatrixDomainMul {
 	public:
+		BlasMatrixDomainMul (const BlasParallelPolicy &P = BlasParallelPolicy ()) : _policy (P) {}
+
 		Operand1 &operator() (Operand1 &C, const Operand2 &A, const Operand3 &B) const
 		{
-			return BlasMatrixDomainMulAdd<Operand1,Operand1,Operand2,Operand3/*,Operand1::MatrixVectorType*/>()(  C.field().zero, C, C.field().one, A, B );
+			return BlasMatrixDomainMulAdd<Operand1,Operand1,Operand2,Operand3/*,Operand1::MatrixVectorType*/>(_policy)(  C.field().zero, C, C.field().one, A, B );
 		}
+
+	protected:
+		BlasParallelPolicy _policy;
 	};
 
 	/*! @internal
@@ -170,13 +183,15 @@ namespace LinBox
 	template< class Operand1, class Operand2>
 	class BlasMatrixDomainMulin {
 	public:
+		BlasMatrixDomainMulin (const BlasParallelPolicy &P = BlasParallelPolicy ()) : _policy (P) {}
+
 		// Defines a dummy mulin over generic matrices using a temporary
 		Operand1 &operator() (Operand1 &A, const Operand2 &B) const
 		{
 			Operand1* tmp = new Operand1(A);
 			// Effective copy of A
             //	*tmp = A; PG: not needed
-			BlasMatrixDomainMulAdd<Operand1,Operand1,Operand1,Operand2>()( A.field().zero, A, A.field().one, *tmp, B );
+			BlasMatrixDomainMulAdd<Operand1,Operand1,Operand1,Operand2>(_policy)( A.field().zero, A, A.field().one, *tmp, B );
 			delete tmp;
 			return A;
 		}
@@ -186,10 +201,13 @@ namespace LinBox
 			Operand1* tmp = new Operand1(B);
 			// Effective copy of B
 			//*tmp = B; PG: not needed
-			BlasMatrixDomainMulAdd<Operand1,Operand1,Operand2,Operand1>()(  A.field().zero, B, A.field().one, A, *tmp );
+			BlasMatrixDomainMulAdd<Operand1,Operand1,Operand2,Operand1>(_policy)(  A.field().zero, B, A.field().one, A, *tmp );
 			delete tmp;
 			return B;
 		}
+
+	protected:
+		BlasParallelPolicy _policy;
 	};
 
 
@@ -225,8 +243,13 @@ namespace LinBox
 	template<class Matrix>
 	class BlasMatrixDomainRank {
 	public:
+		BlasMatrixDomainRank (const BlasParallelPolicy &P = BlasParallelPolicy ()) : _policy (P) {}
+
         size_t operator() (const Matrix& A) const;
 		size_t operator() (Matrix& A) const;
+
+	protected:
+		BlasParallelPolicy _policy;
 	};
 
 	/*! @internal
@@ -241,8 +264,13 @@ namespace LinBox
 	template<class Matrix>
 	class BlasMatrixDomainDet {
     public:
+        BlasMatrixDomainDet (const BlasParallelPolicy &P = BlasParallelPolicy ()) : _policy (P) {}
+
         typename Matrix::Field::Element operator() (const Matrix& A) const;
         typename Matrix::Field::Element operator() (Matrix& A) const;
+
+    protected:
+        BlasParallelPolicy _policy;
     };
 
 	/*! @internal
@@ -321,22 +349,28 @@ namespace LinBox
 	protected:
 
 		const Field  * _field;
+		BlasParallelPolicy _policy;
 
 	public:
 
 		//! Constructor of BlasDomain.
 		BlasMatrixDomain () {}
 		BlasMatrixDomain (const Field& F ) { init(F); }
+		BlasMatrixDomain (const Field& F, const BlasParallelPolicy& P ) : _policy(P) { init(F); }
 
 		void init(const Field& F ){_field = &F;}
 
 		//! Copy constructor
-		BlasMatrixDomain (const BlasMatrixDomain<Field> & BMD): _field(BMD._field) {}
+		BlasMatrixDomain (const BlasMatrixDomain<Field> & BMD): _field(BMD._field), _policy(BMD._policy) {}
 
 
 		//! Field accessor
 		const Field& field() const { return *_field; }
 
+		//! Threads and grain of the FFLAS-FFPACK calls (sequential by default).
+		const BlasParallelPolicy& parallelPolicy() const { return _policy; }
+		void setParallelPolicy(const BlasParallelPolicy& P) { _policy = P; }
+
 		/*
 		 * Basics operation available matrix respecting BlasMatrix interface
 		 */
@@ -346,7 +380,7 @@ namespace LinBox
 		template <class Operand1, class Operand2, class Operand3>
 		Operand1& mul(Operand1& C, const Operand2& A, const Operand3& B) const
 		{
-			return BlasMatrixDomainMul<Operand1,Operand2,Operand3>()(C,A,B);
+			return BlasMatrixDomainMul<Operand1,Operand2,Operand3>(_policy)(C,A,B);
 		}
 
 		//! addition.
@@ -402,7 +436,7 @@ namespace LinBox
 		template <class Operand1, class Operand2>
 		Operand1& mulin_left(Operand1& A, const Operand2& B ) const
 		{
-			return BlasMatrixDomainMulin<Operand1,Operand2>()(A,B);
+			return BlasMatrixDomainMulin<Operand1,Operand2>(_policy)(A,B);
 		}
 
 		//! In place multiplication.
@@ -410,7 +444,7 @@ namespace LinBox
 		template <class Operand1, class Operand2>
 		Operand2& mulin_right(const Operand1& A, Operand2& B ) const
 		{
-			return BlasMatrixDomainMulin<Operand2,Operand1>()(A,B);
+			return BlasMatrixDomainMulin<Operand2,Operand1>(_policy)(A,B);
 		}
 
 		template <class Matrix1, class Matrix2>
@@ -473,7 +507,7 @@ namespace LinBox
 		Operand1& muladd(Operand1& D, const Element& beta, const Operand2& C,
                          const Element& alpha, const Operand3& A, const Operand4& B) const
 		{
-			return BlasMatrixDomainMulAdd<Operand1,Operand2,Operand3,Operand4>()(D,beta,C,alpha,A,B);
+			return BlasMatrixDomainMulAdd<Operand1,Operand2,Operand3,Operand4>(_policy)(D,beta,C,alpha,A,B);
 		}
 
 		//! muladdin.
@@ -482,7 +516,7 @@ namespace LinBox
 		Operand1& muladdin(const Element& beta, Operand1& C,
                            const Element& alpha, const Operand2& A, const Operand3& B) const
 		{
-			return BlasMatrixDomainMulAdd<Operand1,Operand1,Operand2,Operand3>()(beta,C,alpha,A,B);
+			return BlasMatrixDomainMulAdd<Operand1,Operand1,Operand2,Operand3>(_policy)(beta,C,alpha,A,B);
 		}
 
 
@@ -563,21 +597,21 @@ namespace LinBox
 		template <class Matrix>
 		unsigned int rank(const Matrix &A) const
 		{
-			return BlasMatrixDomainRank<Matrix>()(A);
+			return BlasMatrixDomainRank<Matrix>(_policy)(A);
 		}
 
 		//! in-place Rank (the matrix is modified)
 		template <class Matrix>
 		unsigned int rankInPlace(Matrix &A) const
 		{
-			return BlasMatrixDomainRank<Matrix>()(A);
+			return BlasMatrixDomainRank<Matrix>(_policy)(A);
 		}
 
 		//! determinant
 		template <class Matrix>
 		Element det(const Matrix &A) const
 		{
-			return BlasMatrixDomainDet<Matrix>()(A);
+			return BlasMatrixDomainDet<Matrix>(_policy)(A);
 		}
 
 		//! in-place Determinant (the matrix is modified)
@@ -585,7 +619,7 @@ namespace LinBox
 		Element detInPlace(Matrix &A) const
 		{
 
-			return BlasMatrixDomainDet<Matrix>()(A);
+			return BlasMatrixDomainDet<Matrix>(_policy)(A);
 		}
 		//@}
 
@@ -45,7 +45,7 @@ namespace LinBox
         if (A.rowdim() != A.coldim())
             return A.field().zero;
         typename Matrix::matrixType Acopy(A);
-        return 	BlasMatrixDomainDet<typename Matrix::matrixType>()(Acopy);
+        return 	BlasMatrixDomainDet<typename Matrix::matrixType>(_policy)(Acopy);
     }
 
 	template<class Matrix>
@@ -55,12 +55,14 @@ namespace LinBox
         if (A.rowdim() != A.coldim())
             return A.field().zero;
         typename Matrix::Field::Element det; A.field().init(det);
-        return FFPACK::Det(A.field(), det, A.coldim(), A.getPointer(), A.getStride());
+        return BlasParallel::Det(_policy, A.field(), det, A.coldim(), A.getPointer(), A.getStride());
 	}
 
 	template< class Matrix>
     class BlasMatrixDomainDet<TriangularBlasMatrix<Matrix> >{
     public:
+        BlasMatrixDomainDet (const BlasParallelPolicy & = BlasParallelPolicy ()) {}
+
         typename Matrix::Field::Element operator() (const TriangularBlasMatrix<Matrix> & A) const
         {
             if (A.rowdim() != A.coldim())
@@ -89,14 +91,14 @@ namespace LinBox
 	BlasMatrixDomainRank<Matrix>::operator() (const  Matrix  &A) const
 	{
         typename Matrix::matrixType Acopy(A);
-        return 	BlasMatrixDomainRank<typename Matrix::matrixType>()(Acopy);
+        return 	BlasMatrixDomainRank<typename Matrix::matrixType>(_policy)(Acopy);
 	}
 
 	template<class Matrix>
     size_t
 	BlasMatrixDomainRank<Matrix>::operator() (Matrix        &A) const
 	{
-        return FFPACK::Rank(A.field(),A.rowdim(), A.coldim(), A.getPointer(), A.getStride());
+        return BlasParallel::Rank(_policy, A.field(),A.rowdim(), A.coldim(), A.getPointer(), A.getStride());
 	}
 
 } // LinBox
@@ -0,0 +1,204 @@
+/* linbox/matrix/matrixdomain/blas-parallel-policy.h
+ * Copyright (C) 2026 The LinBox group
+ *
+ * ========LICENCE========
+ * This file is part of the library LinBox.
+ *
+  * LinBox is free software: you can redistribute it and/or modify
+ * it under the terms of the  GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.	 See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ * ========LICENCE========
+ */
+
+/*! @file matrix/matrixdomain/blas-parallel-policy.h
+ * @ingroup matrixdomain
+ * @brief Execution policy of the dense FFLAS-FFPACK kernels.
+ *
+ * The kernels of \c BlasMatrixDomain, \c PLUQMatrix and of the dense
+ * echelon forms run sequentially unless given a \ref BlasParallelPolicy
+ * with more than one thread.  The \c BlasParallel functions forward the
+ * FFLAS-FFPACK calls to their recursive parallel variants when the policy
+ * and the dimensions allow it, and to the sequential ones otherwise.
+ */
+
+#ifndef __LINBOX_matrix_matrixdomain_blas_parallel_policy_H
+#define __LINBOX_matrix_matrixdomain_blas_parallel_policy_H
+
+#include <algorithm>
+
+#include <fflas-ffpack/fflas/fflas.h>
+#include <fflas-ffpack/ffpack/ffpack.h>
+#include <fflas-ffpack/paladin/parallel.h>
+
+#include "linbox/linbox-config.h"
+
+/*! Smallest dimension for which a dense kernel goes parallel.
+ * Below it, the task overhead is larger than the gain.
+ */
+#ifndef LINBOX_DEFAULT_PARALLEL_GRAIN
+#define LINBOX_DEFAULT_PARALLEL_GRAIN 256
+#endif
+
+namespace LinBox
+{
+
+	/** \brief Number of threads and grain size of the dense kernels.
+	 *
+	 * The default policy is sequential.  A thread count of 0 means all the
+	 * threads of the OpenMP runtime (MAX_THREADS).  The grain is the smallest
+	 * dimension of an operation that is run in parallel.
+	 */
+	struct BlasParallelPolicy {
+		size_t numThreads;
+		size_t grain;
+
+		BlasParallelPolicy (size_t t = 1, size_t g = LINBOX_DEFAULT_PARALLEL_GRAIN) :
+			numThreads (t), grain (g)
+		{}
+
+		static BlasParallelPolicy sequential () { return BlasParallelPolicy (1); }
+		static BlasParallelPolicy parallel (size_t t = 0, size_t g = LINBOX_DEFAULT_PARALLEL_GRAIN)
+		{
+			return BlasParallelPolicy (t, g);
+		}
+
+		size_t threads () const
+		{
+			return numThreads ? numThreads : (size_t) MAX_THREADS;
+		}
+
+		//! Whether an operation of dimensions \p m x \p n (x \p k) should go parallel.
+		bool useParallel (size_t m, size_t n, size_t k = 0) const
+		{
+			if (threads () <= 1) return false;
+			size_t d = std::min (m, n);
+			if (k) d = std::min (d, k);
+			return d >= grain;
+		}
+	};
+
+	/** Dense kernels dispatched on a \ref BlasParallelPolicy.
+	 * Same arguments as the FFLAS-FFPACK functions of the same name, the
+	 * policy first.
+	 */
+	namespace BlasParallel
+	{
+		typedef FFLAS::ParSeqHelper::Parallel<FFLAS::CuttingStrategy::Recursive,
+						      FFLAS::StrategyParameter::TwoDAdaptive> MulHelper;
+		typedef FFLAS::ParSeqHelper::Parallel<FFLAS::CuttingStrategy::Recursive,
+						      FFLAS::StrategyParameter::Threads> LUHelper;
+
+		template<class Field>
+		inline typename Field::Element_ptr
+		fgemm (const BlasParallelPolicy &P, const Field &F,
+		       const FFLAS::FFLAS_TRANSPOSE ta, const FFLAS::FFLAS_TRANSPOSE tb,
+		       const size_t m, const size_t n, const size_t k,
+		       const typename Field::Element &alpha,
+		       typename Field::ConstElement_ptr A, const size_t lda,
+		       typename Field::ConstElement_ptr B, const size_t ldb,
+		       const typename Field::Element &beta,
+		       typename Field::Element_ptr C, const size_t ldc)
+		{
+			if (! P.useParallel (m, n, k))
+				return FFLAS::fgemm (F, ta, tb, m, n, k, alpha, A, lda, B, ldb, beta, C, ldc);
+
+			MulHelper WH ((int)P.threads ());
+			PAR_BLOCK {
+				FFLAS::fgemm (F, ta, tb, m, n, k, alpha, A, lda, B, ldb, beta, C, ldc, WH);
+			}
+			return C;
+		}
+
+		template<class Field>
+		inline size_t
+		Rank (const BlasParallelPolicy &P, const Field &F, const size_t m, const size_t n,
+		      typename Field::Element_ptr A, const size_t lda)
+		{
+			if (! P.useParallel (m, n))
+				return FFPACK::Rank (F, m, n, A, lda);
+			return FFPACK::pRank (F, m, n, A, lda, P.threads ());
+		}
+
+		template<class Field>
+		inline typename Field::Element &
+		Det (const BlasParallelPolicy &P, const Field &F, typename Field::Element &det,
+		     const size_t n, typename Field::Element_ptr A, const size_t lda)
+		{
+			if (! P.useParallel (n, n))
+				return FFPACK::Det (F, det, n, A, lda);
+			return FFPACK::pDet (F, det, n, A, lda, P.threads ());
+		}
+
+		template<class Field>
+		inline size_t
+		PLUQ (const BlasParallelPolicy &P, const Field &F, const FFLAS::FFLAS_DIAG diag,
+		      const size_t m, const size_t n, typename Field::Element_ptr A, const size_t lda,
+		      size_t *Pp, size_t *Qp)
+		{
+			if (! P.useParallel (m, n))
+				return FFPACK::PLUQ (F, diag, m, n, A, lda, Pp, Qp);
+			return FFPACK::pPLUQ (F, diag, m, n, A, lda, Pp, Qp, (int)P.threads ());
+		}
+
+		/*! LU variant of the echelon forms below for the policy \p P.
+		 * The parallel echelon forms use the tile recursive PLUQ, the
+		 * sequential ones the slab recursive LUdivine; their outputs are
+		 * stored differently, so the \c FFPACK::getEchelon* and
+		 * \c FFPACK::getReducedEchelon* calls reading them must be given
+		 * the same tag.
+		 */
+		inline FFPACK::FFPACK_LU_TAG
+		EchelonTag (const BlasParallelPolicy &P, const size_t m, const size_t n)
+		{
+			return P.useParallel (m, n) ? FFPACK::FfpackTileRecursive : FFPACK::FfpackSlabRecursive;
+		}
+
+#define LINBOX_BLAS_PARALLEL_ECHELON(Name)                                              \
+		template<class Field>                                                           \
+		inline size_t                                                                   \
+		Name (const BlasParallelPolicy &P, const Field &F, const size_t m, const size_t n, \
+		      typename Field::Element_ptr A, const size_t lda,                          \
+		      size_t *Pp, size_t *Qp, const bool transform = false)                     \
+		{                                                                               \
+			if (EchelonTag (P, m, n) == FFPACK::FfpackSlabRecursive)                    \
+				return FFPACK::Name (F, m, n, A, lda, Pp, Qp, transform,                \
+						     FFPACK::FfpackSlabRecursive);                              \
+			size_t R;                                                                   \
+			LUHelper PSH ((int)P.threads ());                                           \
+			PAR_BLOCK {                                                                 \
+				R = FFPACK::Name (F, m, n, A, lda, Pp, Qp, transform,                   \
+						  FFPACK::FfpackTileRecursive, PSH);                            \
+			}                                                                           \
+			return R;                                                                   \
+		}
+
+		LINBOX_BLAS_PARALLEL_ECHELON(RowEchelonForm)
+		LINBOX_BLAS_PARALLEL_ECHELON(ReducedRowEchelonForm)
+		LINBOX_BLAS_PARALLEL_ECHELON(ColumnEchelonForm)
+		LINBOX_BLAS_PARALLEL_ECHELON(ReducedColumnEchelonForm)
+
+#undef LINBOX_BLAS_PARALLEL_ECHELON
+
+	} // BlasParallel
+
+} // LinBox
+
+#endif // __LINBOX_matrix_matrixdomain_blas_parallel_policy_H
+
+// Local Variables:
+// mode: C++
+// tab-width: 4
+// indent-tabs-mode: nil
+// c-basic-offset: 4
+// End:
+// vim:sts=4:sw=4:ts=4:et:sr:cino=>s,f0,{0,g0,(0,\:0,t0,+0,=s
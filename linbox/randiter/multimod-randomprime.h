@@ -32,6 +32,10 @@
 
 #include "linbox/integer.h"
 #include "linbox/util/timer.h"
+#include "linbox/randiter/random-prime.h"
+#include <algorithm>
+#include <array>
+#include <iostream>
 #include <vector>
 
 namespace LinBox
@@ -124,6 +128,80 @@ namespace LinBox
 
 
 	};
+
+	/** \brief K distinct primes, drawn together.
+	 *
+	 * Converts to the product of the primes,
+	 * which is the modulus seen by the \ref CRA builders.
+	 */
+	template <size_t K>
+	struct MultiPrime {
+		std::array<integer, K> primes;
+		integer product;
+
+		operator const integer& () const { return product; }
+
+		friend std::ostream& operator<< (std::ostream& os, const MultiPrime& p)
+		{
+			os << '{';
+			for (size_t l = 0; l < K; ++l)
+				os << p.primes[l] << ((l + 1 < K) ? "," : "}");
+			return os;
+		}
+	};
+
+	/** \brief Prime iterator drawing K distinct primes at a time.
+	 *
+	 * Each \c operator++ draws K distinct primes from the underlying
+	 * \ref PrimeIterator. It is the prime iterator of the \ref CRA loops
+	 * over \ref MultiModLanes, one domain per batch of K primes.
+	 * @ingroup primes
+	 * @ingroup randiter
+	 */
+	template <size_t K, class Trait = IteratorCategories::HeuristicTag>
+	class MultiPrimeIterator {
+	public:
+		typedef MultiPrime<K> Prime_Type;
+		typedef UniqueSamplingTrait<Trait> UniqueSamplingTag;
+		typedef Trait IteratorTag;
+
+		/*! Constructor.
+		 * @param bits size of the primes, below 26.
+		 * 22 or 23 bits allow long delayed accumulations in MultiModLanes.
+		 * @param seed if \c 0 a seed will be generated.
+		 */
+		MultiPrimeIterator (uint64_t bits = 23, uint64_t seed = 0) :
+			_iter (bits, seed)
+		{
+			generatePrimes ();
+		}
+
+		inline MultiPrimeIterator& operator++ ()
+		{
+			generatePrimes ();
+			return *this;
+		}
+
+		const Prime_Type& operator* () const { return _primes; }
+
+		uint64_t getBits () const { return _iter.getBits (); }
+
+	protected:
+		void generatePrimes ()
+		{
+			_primes.product = 1;
+			for (size_t l = 0; l < K; ++l) {
+				do {
+					++_iter;
+				} while (std::find (_primes.primes.begin (), _primes.primes.begin () + l, *_iter) != _primes.primes.begin () + l);
+				_primes.primes[l] = *_iter;
+				_primes.product *= *_iter;
+			}
+		}
+
+		PrimeIterator<Trait> _iter;
+		Prime_Type _primes;
+	};
 }
 
 #endif //__LINBOX_multimod_random_prime_H
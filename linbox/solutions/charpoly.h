@@ -85,13 +85,15 @@ namespace LinBox
 	}
 
 	// The charpoly with Auto Method
+	// The blackbox charpoly gets the multiplicities of the factors of the
+	// minimal polynomial from Monte Carlo ranks: Auto keeps the dense
+	// elimination here, and weighs the two on sparse matrices only (below).
 	template <class Blackbox, class Polynomial>
 	Polynomial& charpoly (Polynomial                       & P,
                               const Blackbox                   & A,
                               const RingCategories::ModularTag & tag,
                               const Method::Auto             & M)
 	{
-		//return charpoly(P, A, tag, Method::Blackbox(M));
 		return charpoly(P, A, tag, Method::DenseElimination(M));
 	}
 
@@ -102,6 +104,8 @@ namespace LinBox
 			      const RingCategories::ModularTag & tag,
 			      const Method::Auto             & M)
 	{
+		if (chooseAutoMethod(A, AutoProblem::CharPoly, M.parallelPolicy.threads()) == AutoMethod::DenseElimination)
+			return charpoly(P, A, tag, Method::DenseElimination(M));
 		return charpoly(P, A, tag, Method::Blackbox(M));
 	}
 
@@ -193,7 +197,7 @@ namespace LinBox
 						  const Method::Auto	       & M)
 	{
 		commentator().start ("Integer Charpoly", "Icharpoly");
-		if (useBlackboxMethod(A))
+		if (chooseAutoMethod(A, AutoProblem::CharPoly, M.parallelPolicy.threads()) == AutoMethod::Blackbox)
 			charpoly(P, A, tag, Method::Blackbox(M) );
 		else
 			charpoly(P, A, tag, Method::DenseElimination(M) );
@@ -294,6 +298,8 @@ namespace LinBox
 		ChineseRemainder< CRABuilderFullMultip<Field > > cra(hbound);
 #endif
 		IntegerModularCharpoly<Matrix, Method> iteration(A, M);
+		cra.setCheckpoint(M.checkpoint);
+		cra.setStatistics(M.statistics);
 		cra.operator() (P, iteration, genprime);
 		commentator().stop ("done", NULL, "IbbCharpoly");
 #ifdef __LB_CRA_TIMING__
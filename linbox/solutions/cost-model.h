@@ -0,0 +1,349 @@
+/*
+ * Copyright(C) LinBox
+ *
+ * ========LICENCE========
+ * This file is part of the library LinBox.
+ *
+ * LinBox is free software: you can redistribute it and/or modify
+ * it under the terms of the  GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ * ========LICENCE========
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <limits>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <linbox/integer.h>
+#include <linbox/matrix/dense-matrix.h>
+#include <linbox/solutions/constants.h>
+
+/**
+ * Cost model behind Method::Auto.
+ *
+ * Method::Auto on a sparse matrix chooses between a blackbox method
+ * (Wiedemann), sparse elimination, and dense elimination after
+ * densification.  The predicted times come from the sparsity of the matrix
+ * (nnz and row lengths), the size of the field, the number of threads of
+ * the dense kernels and a few per-machine constants.
+ *
+ * The constants of a machine are measured by benchmarks/benchmark-cost-model
+ * and written to a profile file.  The profile is read at the first use of
+ * MachineProfile::current() from the file named by the environment variable
+ * LINBOX_MACHINE_PROFILE; the defaults below are used without it.
+ */
+
+namespace LinBox {
+
+    /**
+     * Per-machine constants of the cost model, in seconds.
+     * Costs are for word-size prime fields.
+     */
+    struct MachineProfile {
+        double sparseApply = 3e-9;          //!< Per nonzero, for one blackbox apply.
+        double sparseElimination = 2e-8;    //!< Per sparse row update (one multiply-add) of the Gaussian elimination.
+        double denseElimination = 1.5e-10;  //!< Per multiply-add of the dense (FFPACK) elimination, on one thread.
+        double densify = 4e-9;              //!< Per entry, for the conversion to a dense matrix.
+        double denseParallelEfficiency = 0.7; //!< Speedup of each additional thread of the dense kernels.
+        double fillGrowth = 2.;             //!< Average row length above which sparse elimination fills in.
+        double largeFieldFactor = 12.;      //!< Slowdown of an operation per 64-bit limb squared, above word size.
+        double denseMemory = 8e9;           //!< Largest dense matrix allowed, in bytes.
+
+        /// Reads "name value" lines, '#' starting a comment; unknown names are ignored.
+        std::istream& read(std::istream& is)
+        {
+            std::string line;
+            while (std::getline(is, line)) {
+                line = line.substr(0, line.find('#'));
+                std::istringstream ls(line);
+                std::string name;
+                double value;
+                if (!(ls >> name >> value)) continue;
+                if (double* field = find(name)) *field = value;
+            }
+            return is;
+        }
+
+        std::ostream& write(std::ostream& os) const
+        {
+            os << "# LinBox machine profile, see linbox/solutions/cost-model.h" << std::endl;
+            for (const auto& entry : entries())
+                os << entry.first << ' ' << this->*(entry.second) << std::endl;
+            return os;
+        }
+
+        /**
+         * The profile used by Method::Auto.
+         * Read from $LINBOX_MACHINE_PROFILE on first use when it is set.
+         */
+        static MachineProfile& current()
+        {
+            static MachineProfile profile = fromEnvironment();
+            return profile;
+        }
+
+    private:
+        typedef std::pair<const char*, double MachineProfile::*> Entry;
+
+        static std::vector<Entry> entries()
+        {
+            return {{"sparseApply", &MachineProfile::sparseApply},
+                    {"sparseElimination", &MachineProfile::sparseElimination},
+                    {"denseElimination", &MachineProfile::denseElimination},
+                    {"densify", &MachineProfile::densify},
+                    {"denseParallelEfficiency", &MachineProfile::denseParallelEfficiency},
+                    {"fillGrowth", &MachineProfile::fillGrowth},
+                    {"largeFieldFactor", &MachineProfile::largeFieldFactor},
+                    {"denseMemory", &MachineProfile::denseMemory}};
+        }
+
+        double* find(const std::string& name)
+        {
+            for (const auto& entry : entries())
+                if (name == entry.first) return &(this->*(entry.second));
+            return nullptr;
+        }
+
+        static MachineProfile fromEnvironment()
+        {
+            MachineProfile profile;
+            const char* path = std::getenv("LINBOX_MACHINE_PROFILE");
+            if (path != nullptr) {
+                std::ifstream file(path);
+                if (file) profile.read(file);
+            }
+            return profile;
+        }
+    };
+
+    /**
+     * What Method::Auto is computing.
+     * The number of applies of a blackbox method and the existence of a sparse
+     * elimination depend on it.
+     */
+    enum class AutoProblem {
+        Solve,
+        Rank,
+        Det,
+        MinPoly,
+        CharPoly,
+    };
+
+    /**
+     * Outcome of the cost model.
+     */
+    enum class AutoMethod {
+        Blackbox,
+        SparseElimination,
+        DenseElimination,
+        Elimination, //!< Structure unknown, left to Method::Elimination.
+    };
+
+    /**
+     * Features of a matrix the cost model depends on.
+     * The structure is unknown for blackboxes without an indexed iterator.
+     */
+    struct SparsityProfile {
+        size_t rowdim = 0;
+        size_t coldim = 0;
+        size_t nnz = 0;
+        double rowLengthSquares = 0.; //!< Sum of the squares of the row lengths.
+        size_t fieldBits = 0;         //!< Bit size of the characteristic, 0 over the integers.
+        bool known = false;
+
+        double meanRowLength() const { return rowdim ? double(nnz) / double(rowdim) : 0.; }
+    };
+
+    namespace Protected {
+        template <class Matrix>
+        size_t characteristicBits(const Matrix& A)
+        {
+            integer c;
+            A.field().characteristic(c);
+            return c.bitsize();
+        }
+
+        template <class Matrix>
+        auto sparsityProfile(SparsityProfile& S, const Matrix& A, int)
+            -> decltype(A.IndexedBegin().rowIndex(), A.IndexedEnd(), void())
+        {
+            std::vector<size_t> lengths(A.rowdim(), 0);
+            for (auto it = A.IndexedBegin(); it != A.IndexedEnd(); ++it) {
+                ++lengths[it.rowIndex()];
+                ++S.nnz;
+            }
+            for (size_t l : lengths) S.rowLengthSquares += double(l) * double(l);
+            S.known = true;
+        }
+
+        template <class Matrix>
+        void sparsityProfile(SparsityProfile&, const Matrix&, long)
+        {
+        }
+    }
+
+    /// Sparsity of A, when A can be iterated over its nonzero entries.
+    template <class Matrix>
+    SparsityProfile sparsityProfile(const Matrix& A)
+    {
+        SparsityProfile S;
+        S.rowdim = A.rowdim();
+        S.coldim = A.coldim();
+        S.fieldBits = Protected::characteristicBits(A);
+        Protected::sparsityProfile(S, A, 0);
+        return S;
+    }
+
+    /// Estimate of the bytes read and written by an apply of A:
+    /// the two vectors and, when they are known, the nonzero entries with their indices.
+    template <class Matrix>
+    uint64_t applyBytes(const Matrix& A)
+    {
+        using Element = typename Matrix::Field::Element;
+        SparsityProfile S = sparsityProfile(A);
+        return (uint64_t)S.nnz * (sizeof(Element) + sizeof(size_t)) + (uint64_t)(S.rowdim + S.coldim) * sizeof(Element);
+    }
+
+    /**
+     * Predicted running times of the methods of Method::Auto.
+     *
+     * Blackbox: 2n applies for the minimal polynomial (3n to solve, with a
+     * diagonal or butterfly preconditioner for the rank and the determinant,
+     * log(n) minimal polynomials for the characteristic polynomial) and the
+     * quadratic Berlekamp-Massey.
+     *
+     * Sparse elimination: a pivot costs (row length)^2 x (column length)
+     * updates until the mean row length reaches fillGrowth, after which the
+     * active submatrix is taken as dense, still updated by the sparse
+     * routines.
+     *
+     * Dense elimination: densification and n^3/3 multiply-adds (n^3 for the
+     * polynomials) on the dense kernels' threads.  Above word size there is no
+     * BLAS and a multiply-add costs as much as one of an apply.
+     */
+    class CostModel {
+    public:
+        CostModel(const MachineProfile& profile = MachineProfile::current()) : _profile(profile) {}
+
+        const MachineProfile& profile() const { return _profile; }
+
+        double blackbox(const SparsityProfile& S, AutoProblem problem) const
+        {
+            const double n = double(std::max(S.rowdim, S.coldim));
+            double applies = 2. * n, nnz = double(S.nnz);
+            switch (problem) {
+            case AutoProblem::Solve: applies = 3. * n; break;
+            case AutoProblem::Rank:
+            case AutoProblem::Det: nnz += 2. * n; break;
+            case AutoProblem::MinPoly: break;
+            case AutoProblem::CharPoly: applies *= std::max(1., std::log2(n)); break;
+            }
+            const double berlekampMassey = applies * n;
+            return fieldFactor(S) * _profile.sparseApply * (applies * nnz + berlekampMassey);
+        }
+
+        double sparseElimination(const SparsityProfile& S, AutoProblem problem) const
+        {
+            if (problem == AutoProblem::MinPoly || problem == AutoProblem::CharPoly)
+                return std::numeric_limits<double>::infinity();
+            return fieldFactor(S) * _profile.sparseElimination * sparseEliminationUpdates(S);
+        }
+
+        double denseElimination(const SparsityProfile& S, AutoProblem problem, size_t threads) const
+        {
+            const double m = double(S.rowdim), n = double(S.coldim), d = std::min(m, n);
+            if (m * n * sizeof(double) > _profile.denseMemory) return std::numeric_limits<double>::infinity();
+            const double updates = (problem == AutoProblem::MinPoly || problem == AutoProblem::CharPoly)
+                                       ? n * n * n
+                                       : m * n * d / 3.;
+            const double speedup = 1. + _profile.denseParallelEfficiency * double(threads > 0 ? threads - 1 : 0);
+            const double update = isWordSize(S) ? _profile.denseElimination : fieldFactor(S) * _profile.sparseApply;
+            return _profile.densify * m * n + update * updates / speedup;
+        }
+
+        /// Row updates predicted for the sparse Gaussian elimination of S.
+        double sparseEliminationUpdates(const SparsityProfile& S) const
+        {
+            const double m = double(S.rowdim), n = double(S.coldim), d = std::min(m, n);
+            if (d == 0.) return 0.;
+            const double r = std::max(S.meanRowLength(), 1.);
+            const double meanSquare = S.rowLengthSquares / m;
+            const double colLength = double(S.nnz) / n;
+            // pivots before the fill-in makes the active submatrix dense
+            const double sparsePivots = d * std::min(1., _profile.fillGrowth / r);
+            const double rest = d - sparsePivots;
+            return sparsePivots * meanSquare * std::max(colLength, 1.) + rest * rest * rest / 3.;
+        }
+
+        /**
+         * Cheapest method for S.
+         * Without the structure of the matrix, the dimension threshold
+         * LINBOX_USE_BLACKBOX_THRESHOLD decides between a blackbox method and
+         * Method::Elimination, as before the cost model.
+         */
+        AutoMethod choose(const SparsityProfile& S, AutoProblem problem, size_t threads) const
+        {
+            if (!S.known)
+                return (S.rowdim > LINBOX_USE_BLACKBOX_THRESHOLD && S.coldim > LINBOX_USE_BLACKBOX_THRESHOLD)
+                           ? AutoMethod::Blackbox
+                           : AutoMethod::Elimination;
+
+            AutoMethod best = AutoMethod::Blackbox;
+            double cost = blackbox(S, problem);
+            const double sparse = sparseElimination(S, problem);
+            if (sparse < cost) {
+                best = AutoMethod::SparseElimination;
+                cost = sparse;
+            }
+            if (denseElimination(S, problem, threads) < cost) best = AutoMethod::DenseElimination;
+            return best;
+        }
+
+    protected:
+        static bool isWordSize(const SparsityProfile& S) { return S.fieldBits <= 26; }
+
+        double fieldFactor(const SparsityProfile& S) const
+        {
+            if (isWordSize(S)) return 1.;
+            const double limbs = std::ceil(double(S.fieldBits) / 64.);
+            return _profile.largeFieldFactor * limbs * limbs;
+        }
+
+        MachineProfile _profile;
+    };
+
+    /**
+     * Method Method::Auto uses for A, with the current machine profile.
+     * @param threads number of threads of the dense kernels.
+     */
+    template <class Matrix>
+    AutoMethod chooseAutoMethod(const Matrix& A, AutoProblem problem, size_t threads = 1)
+    {
+        return CostModel().choose(sparsityProfile(A), problem, threads);
+    }
+
+    template <class Field>
+    AutoMethod chooseAutoMethod(const DenseMatrix<Field>& A, AutoProblem problem, size_t threads = 1)
+    {
+        return AutoMethod::DenseElimination;
+    }
+}
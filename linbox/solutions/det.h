@@ -123,11 +123,16 @@ namespace LinBox
 						const RingCategories::ModularTag	&tag,
 						const Method::Auto			&Meth)
 	{
-		if (useBlackboxMethod(A))
+		switch (chooseAutoMethod(A, AutoProblem::Det, Meth.parallelPolicy.threads())) {
+		case AutoMethod::Blackbox:
 			return det(d, A, tag, Method::Blackbox(Meth));
-		else
-
+		case AutoMethod::SparseElimination:
+			return det(d, A, tag, Method::SparseElimination(Meth));
+		case AutoMethod::DenseElimination:
+			return det(d, A, tag, Method::DenseElimination(Meth));
+		default:
 			return det(d, A, tag, Method::Elimination(Meth));
+		}
 	}
 	template<class Blackbox>
 	typename Blackbox::Field::Element &detInPlace (typename Blackbox::Field::Element	&d,
@@ -337,7 +342,7 @@ namespace LinBox
 		linbox_check (A.coldim () == A.rowdim ());
 
 		BlasMatrix<Field> B(A);
-		BlasMatrixDomain<Field> BMD(F);
+		BlasMatrixDomain<Field> BMD(F, Meth.parallelPolicy);
 		d= BMD.detInPlace(B);
 		commentator().stop ("done", NULL, "blasdet");
 
@@ -578,6 +583,8 @@ namespace LinBox
 		//  will call regular cra if C=0
 #ifdef __LINBOX_HAVE_MPI
 		ChineseRemainderDistributed< CRABuilderEarlySingle< Field > > cra(LINBOX_DEFAULT_EARLY_TERMINATION_THRESHOLD, C);
+		cra.setCheckpoint(Meth.checkpoint);
+		cra.setStatistics(Meth.statistics);
 		cra(dd, iteration, genprime);
 		if(!C || C->rank() == 0){
 			A.field().init(d, dd); // convert the result from integer to original type
@@ -585,6 +592,8 @@ namespace LinBox
 		}
 #else
 		ChineseRemainder< CRABuilderEarlySingle< Field > > cra(LINBOX_DEFAULT_EARLY_TERMINATION_THRESHOLD);
+		cra.setCheckpoint(Meth.checkpoint);
+		cra.setStatistics(Meth.statistics);
 		cra(dd, iteration, genprime);
 		A.field().init(d, dd); // convert the result from integer to original type
         commentator().stop ("done", NULL, "idet");
@@ -49,10 +49,12 @@ namespace LinBox {
 
         E = A;
 
-        size_t R = FFPACK::RowEchelonForm (F, m, n, E.getPointer(), E.getStride(), P, Q, false);
+        size_t R = BlasParallel::RowEchelonForm (M.parallelPolicy, F, m, n, E.getPointer(), E.getStride(), P, Q, false);
+
+        const FFPACK::FFPACK_LU_TAG LuTag = BlasParallel::EchelonTag (M.parallelPolicy, m, n);
 
         FFPACK::getEchelonForm (F, FFLAS::FflasUpper, FFLAS::FflasUnit, m, n, R, Q,
-                                E.getPointer(), E.getStride());
+                                E.getPointer(), E.getStride(), LuTag);
 
         delete[] P;
         delete[] Q;
@@ -78,12 +80,14 @@ namespace LinBox {
 
         E = A;
 
-        size_t R = FFPACK::RowEchelonForm (F, m, n, E.getPointer(), E.getStride(), P, Q, false);
+        size_t R = BlasParallel::RowEchelonForm (M.parallelPolicy, F, m, n, E.getPointer(), E.getStride(), P, Q, false);
+
+        const FFPACK::FFPACK_LU_TAG LuTag = BlasParallel::EchelonTag (M.parallelPolicy, m, n);
 
         FFPACK::getEchelonTransform (F, FFLAS::FflasUpper, FFLAS::FflasUnit, m, n, R, P, Q,
-                                     E.getPointer(), E.getStride(), T.getPointer(), T.getStride());
+                                     E.getPointer(), E.getStride(), T.getPointer(), T.getStride(), LuTag);
         FFPACK::getEchelonForm (F, FFLAS::FflasUpper, FFLAS::FflasUnit, m, n, R, Q,
-                                E.getPointer(), E.getStride());
+                                E.getPointer(), E.getStride(), LuTag);
 
         delete[] P;
         delete[] Q;
@@ -107,10 +111,12 @@ namespace LinBox {
         size_t* Q = new size_t[n];
         const Field& F = A.field();
 
-        size_t R = FFPACK::RowEchelonForm (F, m, n, A.getPointer(), A.getStride(), P, Q, false);
+        size_t R = BlasParallel::RowEchelonForm (M.parallelPolicy, F, m, n, A.getPointer(), A.getStride(), P, Q, false);
+
+        const FFPACK::FFPACK_LU_TAG LuTag = BlasParallel::EchelonTag (M.parallelPolicy, m, n);
 
         FFPACK::getEchelonForm (F, FFLAS::FflasUpper, FFLAS::FflasUnit, m, n, R, Q,
-                                A.getPointer(), A.getStride());
+                                A.getPointer(), A.getStride(), LuTag);
 
         delete[] P;
         delete[] Q;
@@ -132,11 +138,13 @@ namespace LinBox {
         size_t* Q = new size_t[n];
         const Field& F = A.field();
 
-        size_t R = FFPACK::RowEchelonForm (F, m, n, A.getPointer(), A.getStride(), P, Q, true);
+        size_t R = BlasParallel::RowEchelonForm (M.parallelPolicy, F, m, n, A.getPointer(), A.getStride(), P, Q, true);
+
+        const FFPACK::FFPACK_LU_TAG LuTag = BlasParallel::EchelonTag (M.parallelPolicy, m, n);
 
         FFPACK::getEchelonTransform (F, FFLAS::FflasUpper, FFLAS::FflasUnit, m, n, R, P, Q,
-                                     A.getPointer(), A.getStride(), T.getPointer(), T.getStride());
-        FFPACK::getEchelonForm (F, FFLAS::FflasUpper, FFLAS::FflasUnit, m, n, R, Q, A.getPointer(), A.getStride());
+                                     A.getPointer(), A.getStride(), T.getPointer(), T.getStride(), LuTag);
+        FFPACK::getEchelonForm (F, FFLAS::FflasUpper, FFLAS::FflasUnit, m, n, R, Q, A.getPointer(), A.getStride(), LuTag);
 
         delete[] P;
         delete[] Q;
@@ -164,9 +172,11 @@ namespace LinBox {
 
         E = A;
 
-        size_t R = FFPACK::ReducedRowEchelonForm (F, m, n, E.getPointer(), E.getStride(), P, Q, false);
+        size_t R = BlasParallel::ReducedRowEchelonForm (M.parallelPolicy, F, m, n, E.getPointer(), E.getStride(), P, Q, false);
 
-        FFPACK::getReducedEchelonForm (F, FFLAS::FflasUpper, m, n, R, Q, E.getPointer(), E.getStride());
+        const FFPACK::FFPACK_LU_TAG LuTag = BlasParallel::EchelonTag (M.parallelPolicy, m, n);
+
+        FFPACK::getReducedEchelonForm (F, FFLAS::FflasUpper, m, n, R, Q, E.getPointer(), E.getStride(), LuTag);
 
         delete[] P;
         delete[] Q;
@@ -191,11 +201,13 @@ namespace LinBox {
 
         E = A;
 
-        size_t R = FFPACK::ReducedRowEchelonForm (F, m, n, E.getPointer(), E.getStride(), P, Q, false);
+        size_t R = BlasParallel::ReducedRowEchelonForm (M.parallelPolicy, F, m, n, E.getPointer(), E.getStride(), P, Q, false);
+
+        const FFPACK::FFPACK_LU_TAG LuTag = BlasParallel::EchelonTag (M.parallelPolicy, m, n);
 
         FFPACK::getReducedEchelonTransform (F, FFLAS::FflasUpper, FFLAS::FflasUnit, m, n, R, P, Q,
-                                            E.getPointer(), E.getStride(), T.getPointer(), T.getStride());
-        FFPACK::getReducedEchelonForm (F, FFLAS::FflasUpper, m, n, R, Q, E.getPointer(), E.getStride());
+                                            E.getPointer(), E.getStride(), T.getPointer(), T.getStride(), LuTag);
+        FFPACK::getReducedEchelonForm (F, FFLAS::FflasUpper, m, n, R, Q, E.getPointer(), E.getStride(), LuTag);
 
         delete[] P;
         delete[] Q;
@@ -219,10 +231,12 @@ namespace LinBox {
         size_t* Q = new size_t[n];
         const Field& F = A.field();
 
-        size_t R = FFPACK::ReducedRowEchelonForm (F, m, n, A.getPointer(), A.getStride(), P, Q, false);
+        size_t R = BlasParallel::ReducedRowEchelonForm (M.parallelPolicy, F, m, n, A.getPointer(), A.getStride(), P, Q, false);
+
+        const FFPACK::FFPACK_LU_TAG LuTag = BlasParallel::EchelonTag (M.parallelPolicy, m, n);
 
         FFPACK::getReducedEchelonForm (F, FFLAS::FflasUpper, m, n, R, Q,
-                                       A.getPointer(), A.getStride());
+                                       A.getPointer(), A.getStride(), LuTag);
 
         delete[] P;
         delete[] Q;
@@ -244,11 +258,13 @@ namespace LinBox {
         size_t* Q = new size_t[n];
         const Field& F = A.field();
 
-        size_t R = FFPACK::ReducedRowEchelonForm (F, m, n, A.getPointer(), A.getStride(), P, Q, true);
+        size_t R = BlasParallel::ReducedRowEchelonForm (M.parallelPolicy, F, m, n, A.getPointer(), A.getStride(), P, Q, true);
+
+        const FFPACK::FFPACK_LU_TAG LuTag = BlasParallel::EchelonTag (M.parallelPolicy, m, n);
 
         FFPACK::getReducedEchelonTransform (F, FFLAS::FflasUpper, FFLAS::FflasUnit, m, n, R, P, Q,
-                                            A.getPointer(), A.getStride(), T.getPointer(), T.getStride());
-        FFPACK::getReducedEchelonForm (F, FFLAS::FflasUpper, m, n, R, Q, A.getPointer(), A.getStride());
+                                            A.getPointer(), A.getStride(), T.getPointer(), T.getStride(), LuTag);
+        FFPACK::getReducedEchelonForm (F, FFLAS::FflasUpper, m, n, R, Q, A.getPointer(), A.getStride(), LuTag);
 
         delete[] P;
         delete[] Q;
@@ -276,10 +292,12 @@ namespace LinBox {
 
         E = A;
 
-        size_t R = FFPACK::ColumnEchelonForm (F, m, n, E.getPointer(), E.getStride(), P, Q, false);
+        size_t R = BlasParallel::ColumnEchelonForm (M.parallelPolicy, F, m, n, E.getPointer(), E.getStride(), P, Q, false);
+
+        const FFPACK::FFPACK_LU_TAG LuTag = BlasParallel::EchelonTag (M.parallelPolicy, m, n);
 
         FFPACK::getEchelonForm (F, FFLAS::FflasLower, FFLAS::FflasUnit, m, n, R, Q,
-                                E.getPointer(), E.getStride());
+                                E.getPointer(), E.getStride(), LuTag);
 
         delete[] P;
         delete[] Q;
@@ -305,12 +323,14 @@ namespace LinBox {
 
         E = A;
 
-        size_t R = FFPACK::ColumnEchelonForm (F, m, n, E.getPointer(), E.getStride(), P, Q, false);
+        size_t R = BlasParallel::ColumnEchelonForm (M.parallelPolicy, F, m, n, E.getPointer(), E.getStride(), P, Q, false);
+
+        const FFPACK::FFPACK_LU_TAG LuTag = BlasParallel::EchelonTag (M.parallelPolicy, m, n);
 
         FFPACK::getEchelonTransform (F, FFLAS::FflasLower, FFLAS::FflasUnit, m, n, R, P, Q,
-                                     E.getPointer(), E.getStride(), T.getPointer(), T.getStride());
+                                     E.getPointer(), E.getStride(), T.getPointer(), T.getStride(), LuTag);
         FFPACK::getEchelonForm (F, FFLAS::FflasLower, FFLAS::FflasUnit, m, n, R, Q,
-                                E.getPointer(), E.getStride());
+                                E.getPointer(), E.getStride(), LuTag);
 
         delete[] P;
         delete[] Q;
@@ -334,10 +354,12 @@ namespace LinBox {
         size_t* Q = new size_t[m];
         const Field& F = A.field();
 
-        size_t R = FFPACK::ColumnEchelonForm (F, m, n, A.getPointer(), A.getStride(), P, Q, false);
+        size_t R = BlasParallel::ColumnEchelonForm (M.parallelPolicy, F, m, n, A.getPointer(), A.getStride(), P, Q, false);
+
+        const FFPACK::FFPACK_LU_TAG LuTag = BlasParallel::EchelonTag (M.parallelPolicy, m, n);
 
         FFPACK::getEchelonForm (F, FFLAS::FflasLower, FFLAS::FflasUnit, m, n, R, Q,
-                                A.getPointer(), A.getStride());
+                                A.getPointer(), A.getStride(), LuTag);
 
         delete[] P;
         delete[] Q;
@@ -359,11 +381,13 @@ namespace LinBox {
         size_t* Q = new size_t[m];
         const Field& F = A.field();
 
-        size_t R = FFPACK::ColumnEchelonForm (F, m, n, A.getPointer(), A.getStride(), P, Q, true);
+        size_t R = BlasParallel::ColumnEchelonForm (M.parallelPolicy, F, m, n, A.getPointer(), A.getStride(), P, Q, true);
+
+        const FFPACK::FFPACK_LU_TAG LuTag = BlasParallel::EchelonTag (M.parallelPolicy, m, n);
 
         FFPACK::getEchelonTransform (F, FFLAS::FflasLower, FFLAS::FflasUnit, m, n, R, P, Q,
-                                     A.getPointer(), A.getStride(), T.getPointer(), T.getStride());
-        FFPACK::getEchelonForm (F, FFLAS::FflasLower, FFLAS::FflasUnit, m, n, R, Q, A.getPointer(), A.getStride());
+                                     A.getPointer(), A.getStride(), T.getPointer(), T.getStride(), LuTag);
+        FFPACK::getEchelonForm (F, FFLAS::FflasLower, FFLAS::FflasUnit, m, n, R, Q, A.getPointer(), A.getStride(), LuTag);
 
         delete[] P;
         delete[] Q;
@@ -391,9 +415,11 @@ namespace LinBox {
 
         E = A;
 
-        size_t R = FFPACK::ReducedColumnEchelonForm (F, m, n, E.getPointer(), E.getStride(), P, Q, false);
+        size_t R = BlasParallel::ReducedColumnEchelonForm (M.parallelPolicy, F, m, n, E.getPointer(), E.getStride(), P, Q, false);
 
-        FFPACK::getReducedEchelonForm (F, FFLAS::FflasLower, m, n, R, Q, E.getPointer(), E.getStride());
+        const FFPACK::FFPACK_LU_TAG LuTag = BlasParallel::EchelonTag (M.parallelPolicy, m, n);
+
+        FFPACK::getReducedEchelonForm (F, FFLAS::FflasLower, m, n, R, Q, E.getPointer(), E.getStride(), LuTag);
 
         delete[] P;
         delete[] Q;
@@ -418,11 +444,13 @@ namespace LinBox {
 
         E = A;
 
-        size_t R = FFPACK::ReducedColumnEchelonForm (F, m, n, E.getPointer(), E.getStride(), P, Q, false);
+        size_t R = BlasParallel::ReducedColumnEchelonForm (M.parallelPolicy, F, m, n, E.getPointer(), E.getStride(), P, Q, false);
+
+        const FFPACK::FFPACK_LU_TAG LuTag = BlasParallel::EchelonTag (M.parallelPolicy, m, n);
 
         FFPACK::getReducedEchelonTransform (F, FFLAS::FflasLower, FFLAS::FflasUnit, m, n, R, P, Q,
-                                            E.getPointer(), E.getStride(), T.getPointer(), T.getStride());
-        FFPACK::getReducedEchelonForm (F, FFLAS::FflasLower, m, n, R, Q, E.getPointer(), E.getStride());
+                                            E.getPointer(), E.getStride(), T.getPointer(), T.getStride(), LuTag);
+        FFPACK::getReducedEchelonForm (F, FFLAS::FflasLower, m, n, R, Q, E.getPointer(), E.getStride(), LuTag);
 
         delete[] P;
         delete[] Q;
@@ -446,10 +474,12 @@ namespace LinBox {
         size_t* Q = new size_t[m];
         const Field& F = A.field();
 
-        size_t R = FFPACK::ReducedColumnEchelonForm (F, m, n, A.getPointer(), A.getStride(), P, Q, false);
+        size_t R = BlasParallel::ReducedColumnEchelonForm (M.parallelPolicy, F, m, n, A.getPointer(), A.getStride(), P, Q, false);
+
+        const FFPACK::FFPACK_LU_TAG LuTag = BlasParallel::EchelonTag (M.parallelPolicy, m, n);
 
         FFPACK::getReducedEchelonForm (F, FFLAS::FflasLower, m, n, R, Q,
-                                       A.getPointer(), A.getStride());
+                                       A.getPointer(), A.getStride(), LuTag);
 
         delete[] P;
         delete[] Q;
@@ -471,11 +501,13 @@ namespace LinBox {
         size_t* Q = new size_t[m];
         const Field& F = A.field();
 
-        size_t R = FFPACK::ReducedColumnEchelonForm (F, m, n, A.getPointer(), A.getStride(), P, Q, true);
+        size_t R = BlasParallel::ReducedColumnEchelonForm (M.parallelPolicy, F, m, n, A.getPointer(), A.getStride(), P, Q, true);
+
+        const FFPACK::FFPACK_LU_TAG LuTag = BlasParallel::EchelonTag (M.parallelPolicy, m, n);
 
         FFPACK::getReducedEchelonTransform (F, FFLAS::FflasLower, FFLAS::FflasUnit, m, n, R, P, Q,
-                                            A.getPointer(), A.getStride(), T.getPointer(), T.getStride());
-        FFPACK::getReducedEchelonForm (F, FFLAS::FflasLower, m, n, R, Q, A.getPointer(), A.getStride());
+                                            A.getPointer(), A.getStride(), T.getPointer(), T.getStride(), LuTag);
+        FFPACK::getReducedEchelonForm (F, FFLAS::FflasLower, m, n, R, Q, A.getPointer(), A.getStride(), LuTag);
 
         delete[] P;
         delete[] Q;
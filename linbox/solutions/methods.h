@@ -24,8 +24,12 @@
 
 #include <linbox/field/field-traits.h>
 #include <linbox/matrix/dense-matrix.h> // Only for useBlackboxMethod
+#include <linbox/matrix/matrixdomain/blas-parallel-policy.h>
 #include <linbox/solutions/constants.h>
+#include <linbox/solutions/cost-model.h>
+#include <linbox/util/checkpoint.h>
 #include <linbox/util/mpicpp.h>
+#include <linbox/util/statistics.h>
 #include <string>
 
 /**
@@ -66,7 +70,8 @@
 
 namespace LinBox {
 
-    // Used to decide which method to use when using Method::Auto on a Blackbox or Sparse matrix.
+    // Dimension threshold between blackbox and elimination methods,
+    // Method::Auto now uses chooseAutoMethod (cost-model.h) instead.
     template <class Matrix>
     bool useBlackboxMethod(const Matrix& A)
     {
@@ -207,14 +212,17 @@ namespace LinBox {
         // ----- Generic solve options.
         Preconditioner preconditioner = Preconditioner::None;
         bool checkResult = false; //!< Ensure that solving worked by checking Ax = b (might not be implemented by all methods).
+        Statistics* statistics = nullptr; //!< If set, the algorithms add their operation counts to it.
 
         // ----- For Integer-based systems.
         Dispatch dispatch = Dispatch::Auto;
         Communicator* pCommunicator = nullptr;
         bool master() const { return (pCommunicator == nullptr) || pCommunicator->master(); }
+        Checkpoint checkpoint; //!< Periodic checkpointing of the CRA loop or of the p-adic lifting.
 
         // ----- For Elimination-based methods.
         PivotStrategy pivotStrategy = PivotStrategy::Linear;
+        BlasParallelPolicy parallelPolicy; //!< Threads and grain of the dense FFLAS-FFPACK kernels (sequential by default).
 
         // ----- For Dixon method.
         // @fixme SingularSolutionType::Deterministic fails with Dense Dixon
@@ -232,6 +240,8 @@ namespace LinBox {
 
         // ----- For Wiedemann (Berlekamp Massey) methods.
         size_t earlyTerminationThreshold = LINBOX_DEFAULT_EARLY_TERMINATION_THRESHOLD;
+        size_t numberOfProjections = 1; //!< Number of projections of the Krylov sequence per apply,
+                                        //!  their generators are combined by lcm (minpoly and rank).
     };
 
     /**
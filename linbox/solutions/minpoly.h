@@ -107,6 +107,8 @@ namespace LinBox
 			     const RingCategories::ModularTag & tag,
 			     const Method::Auto             & M)
 	{
+		if (chooseAutoMethod(A, AutoProblem::MinPoly, M.parallelPolicy.threads()) == AutoMethod::DenseElimination)
+			return minpoly(P, A, tag, Method::DenseElimination(M));
 		return minpoly(P, A, tag, Method::Blackbox(M));
 	}
 
@@ -257,6 +259,8 @@ namespace LinBox
         double hbound = FastCharPolyHadamardBound(A);
 		ChineseRemainder< CRABuilderFullMultip<Field > > cra(hbound);
 #  endif
+		cra.setCheckpoint(M.checkpoint);
+		cra.setStatistics(M.statistics);
 		cra(P, iteration, genprime);
 
 #ifdef __LINBOX_HAVE_MPI
@@ -38,6 +38,7 @@
 #include "linbox/algorithms/blackbox-container-symmetrize.h"
 #include "linbox/algorithms/blackbox-container-symmetric.h"
 #include "linbox/algorithms/blackbox-container.h"
+#include "linbox/algorithms/blackbox-container-multi.h"
 #include "linbox/algorithms/massey-domain.h"
 #include "linbox/algorithms/gauss.h"
 #include "linbox/algorithms/gauss-gf2.h"
@@ -39,6 +39,29 @@
 namespace LinBox
 {
 
+	namespace Protected {
+		/** Pseudo minimal polynomial of a preconditioned blackbox, for the Wiedemann rank.
+		 * With a single projection the sequence is \f$u^T B^i u\f$, of one apply per term
+		 * for a symmetric B; with \p M.numberOfProjections > 1 it is the lcm of the
+		 * generators of \f$u_j^T B^i v\f$, which fails the trace certification less often.
+		 */
+		template <class Field, class Blackbox, class RandIter>
+		inline size_t wiedemannPseudoMinpoly (BlasVector<Field> &phi, size_t &rk,
+						      const Blackbox &B, const Field &F, RandIter &iter,
+						      const Method::Wiedemann &M)
+		{
+			if (M.numberOfProjections > 1) {
+				typedef BlackboxMultiContainer<Field, Blackbox> BBContainerMulti;
+				BBContainerMulti TF (&B, F, M.numberOfProjections, iter);
+				MultiMasseyDomain<Field, BBContainerMulti> WD (&TF, M.earlyTerminationThreshold);
+				return WD.pseudo_minpoly (phi, rk);
+			}
+			BlackboxContainerSymmetric<Field, Blackbox> TF (&B, F, iter);
+			MasseyDomain<Field, BlackboxContainerSymmetric<Field, Blackbox> > WD (&TF, M.earlyTerminationThreshold);
+			return WD.pseudo_minpoly (phi, rk);
+		}
+	}
+
 
 	template <class Blackbox>
 	inline size_t &rank (size_t                    &r,
@@ -47,11 +70,14 @@ namespace LinBox
 				    const Method::Auto             &m)
 	{
 		// we need a BB/Blas hybrid in the style of Duran/Saunders/Wan.
-		//! @bug choose (benchmark) better cuttoff (size, nbnz, sparse rep)
-		if (useBlackboxMethod(A)) {
+		switch (chooseAutoMethod(A, AutoProblem::Rank, m.parallelPolicy.threads())) {
+		case AutoMethod::Blackbox:
 			return rank(r, A, tag, Method::Blackbox(m ));
-		}
-		else {
+		case AutoMethod::SparseElimination:
+			return rank(r, A, tag, Method::SparseElimination( m ));
+		case AutoMethod::DenseElimination:
+			return rank(r, A, tag, Method::DenseElimination( m ));
+		default:
 			return rank(r, A, tag, Method::Elimination( m ));
 		}
 	}
@@ -119,10 +145,8 @@ namespace LinBox
 			Compose<Diagonal<Field>,Blackbox > B_0 (&D_0, &A);
 			BlackBox1 B (&B_0, &D_0);
 
-			BlackboxContainerSymmetric<Field, BlackBox1> TF (&B, F, iter);
-			MasseyDomain<Field, BlackboxContainerSymmetric<Field, BlackBox1> > WD (&TF, M.earlyTerminationThreshold);
 			BlasVector<Field> phi(F);
-			WD.pseudo_minpoly (phi, res);
+			Protected::wiedemannPseudoMinpoly (phi, res, B, F, iter, M);
 			commentator().report(Commentator::LEVEL_ALWAYS,INTERNAL_DESCRIPTION) << "Pseudo Minpoly degree: " << res << std::endl;
 
 			commentator().start ("Monte Carlo certification (1)", "trace");
@@ -163,10 +187,7 @@ namespace LinBox
 				Compose<Diagonal<Field>,Blackbox > B1 (&D1, &A);
 				BlackBox1 B2 (&B1, &D1);
 
-				BlackboxContainerSymmetric<Field, BlackBox1> TF1 (&B2, F, iter);
-				MasseyDomain<Field, BlackboxContainerSymmetric<Field, BlackBox1> > WD1 (&TF1, M.earlyTerminationThreshold);
-
-				WD1.pseudo_minpoly (phi, rk);
+				Protected::wiedemannPseudoMinpoly (phi, rk, B2, F, iter, M);
 				commentator().report(Commentator::LEVEL_ALWAYS,INTERNAL_DESCRIPTION) << "Permuted pseudo Minpoly degree: " << res << std::endl;
 				commentator().start ("Monte Carlo certification (2)", "trace");
 				if (phi.size() >= 2) F.neg(p2, phi[ phi.size()-2]);
@@ -203,10 +224,7 @@ namespace LinBox
 				typedef Compose< Compose< ButD, Blackbox > , Transpose< ButD > > BlackBoxBAB;
 				BlackBoxBAB PAP(&B1, &TP);
 
-				BlackboxContainerSymmetric<Field, BlackBoxBAB> TF1 (&PAP, F, iter);
-				MasseyDomain<Field, BlackboxContainerSymmetric<Field, BlackBoxBAB> > WD1 (&TF1, M.earlyTerminationThreshold);
-
-				WD1.pseudo_minpoly (phi, rk);
+				Protected::wiedemannPseudoMinpoly (phi, rk, PAP, F, iter, M);
 				commentator().report(Commentator::LEVEL_ALWAYS,INTERNAL_DESCRIPTION) << "Butterfly pseudo Minpoly degree: " << res << std::endl;
 				commentator().start ("Monte Carlo certification (3)", "trace");
 				if (phi.size() >= 2) F.neg(p2, phi[ phi.size()-2]);
@@ -259,11 +277,8 @@ namespace LinBox
 			typedef Compose<Compose<Compose<Compose<Diagonal<Field>,Transpose<Blackbox> >, Diagonal<Field> >, Blackbox>, Diagonal<Field> > Blackbox0;
 			Blackbox0 B_i (&B3_i, &D1_i);
 
-			BlackboxContainerSymmetric<Field, Blackbox0> TF_i (&B_i, F, iter);
-			MasseyDomain<Field, BlackboxContainerSymmetric<Field, Blackbox0> > WD (&TF_i, M.earlyTerminationThreshold);
-
 			BlasVector<Field> phi(F);
-			WD.pseudo_minpoly (phi, res);
+			Protected::wiedemannPseudoMinpoly (phi, res, B_i, F, iter, M);
 			commentator().report(Commentator::LEVEL_ALWAYS,INTERNAL_DESCRIPTION) << "Pseudo Minpoly degree: " << res << std::endl;
 			commentator().start ("Monte Carlo certification (4)", "trace");
 
@@ -301,10 +316,7 @@ namespace LinBox
 				typedef Compose<Compose<Compose<Compose<Diagonal<Field>,Transpose<BlackboxP> >, Diagonal<Field> >, BlackboxP>, Diagonal<Field> > Blackbox1;
 				Blackbox1 B (&B3, &D1);
 
-				BlackboxContainerSymmetric<Field, Blackbox1> TF (&B, F, iter);
-				MasseyDomain<Field, BlackboxContainerSymmetric<Field, Blackbox1> > MD (&TF, M.earlyTerminationThreshold);
-
-				MD.pseudo_minpoly (phi, rk);
+				Protected::wiedemannPseudoMinpoly (phi, rk, B, F, iter, M);
 				commentator().report(Commentator::LEVEL_ALWAYS,INTERNAL_DESCRIPTION) << "Permuted pseudo Minpoly degree: " << rk << std::endl;
 				commentator().start ("Monte Carlo certification (5)", "trace");
 				if (phi.size() >= 2) F.neg(p2, phi[ phi.size()-2]);
@@ -345,10 +357,7 @@ namespace LinBox
 				typedef Compose<Compose<Compose<Compose<Diagonal<Field>,Transpose<BlackboxP> >, Diagonal<Field> >, BlackboxP>, Diagonal<Field> > Blackbox1;
 				Blackbox1 B (&B3, &D1);
 
-				BlackboxContainerSymmetric<Field, Blackbox1> TF (&B, F, iter);
-				MasseyDomain<Field, BlackboxContainerSymmetric<Field, Blackbox1> > MD (&TF, M.earlyTerminationThreshold);
-
-				MD.pseudo_minpoly (phi, rk);
+				Protected::wiedemannPseudoMinpoly (phi, rk, B, F, iter, M);
 				commentator().report(Commentator::LEVEL_ALWAYS,INTERNAL_DESCRIPTION) << "Butterfly pseudo Minpoly degree: " << rk << std::endl;
 				commentator().start ("Monte Carlo certification (6)", "trace");
 				if (phi.size() >= 2) F.neg(p2, phi[ phi.size()-2]);
@@ -423,7 +432,7 @@ namespace LinBox
 		linbox_check( a == b );
 		linbox_check( a < LinBox::BlasBound);
 		BlasMatrix<Field> B(A);
-		BlasMatrixDomain<Field> D(F);
+		BlasMatrixDomain<Field> D(F, M.parallelPolicy);
 		r = D.rankInPlace(B);
 		commentator().stop ("done", NULL, "blasrank");
 		return r;
@@ -75,7 +75,9 @@ namespace LinBox {
      *      - Otherwise > Method::SparseElimination but copy to SparseMatrix first
      * - Method::CRA
      *      - IntegerTag
+     *      |   - Dispatch::SMP         > `RationalChineseRemainderParallel`
      *      |   - Dispatch::Distributed > `ChineseRemainderDistributed`
+     *      |   - Dispatch::Combined    > `ChineseRemainderDistributed` with threads on each node
      *      |   - Otherwise             > `RationalChineseRemainder`
      *      - Otherwise > Error
      * - Method::Dixon
@@ -37,11 +37,10 @@ namespace LinBox {
     template <class ResultVector, class Matrix, class Vector, class CategoryTag>
     ResultVector& solve(ResultVector& x, const Matrix& A, const Vector& b, const CategoryTag& tag, const Method::Auto& m)
     {
-        if (useBlackboxMethod(A)) {
-            return solve(x, A, b, tag, reinterpret_cast<const Method::Blackbox&>(m));
-        }
-        else {
-            return solve(x, A, b, tag, reinterpret_cast<const Method::Elimination&>(m));
+        switch (chooseAutoMethod(A, AutoProblem::Solve, m.parallelPolicy.threads())) {
+        case AutoMethod::Blackbox: return solve(x, A, b, tag, reinterpret_cast<const Method::Blackbox&>(m));
+        case AutoMethod::DenseElimination: return solve(x, A, b, tag, reinterpret_cast<const Method::DenseElimination&>(m));
+        default: return solve(x, A, b, tag, reinterpret_cast<const Method::Elimination&>(m));
         }
     }
 
@@ -57,12 +56,17 @@ namespace LinBox {
 
     /**
      * \brief Solve specialisation for Auto with SparseMatrix and ModularTag.
+     * The cost model picks Wiedemann, sparse elimination or dense elimination.
      */
     template <class ResultVector, class... MatrixArgs, class Vector>
     ResultVector& solve(ResultVector& x, const SparseMatrix<MatrixArgs...>& A, const Vector& b,
                         const RingCategories::ModularTag& tag, const Method::Auto& m)
     {
-        return solve(x, A, b, tag, reinterpret_cast<const Method::SparseElimination&>(m));
+        switch (chooseAutoMethod(A, AutoProblem::Solve, m.parallelPolicy.threads())) {
+        case AutoMethod::Blackbox: return solve(x, A, b, tag, reinterpret_cast<const Method::Blackbox&>(m));
+        case AutoMethod::DenseElimination: return solve(x, A, b, tag, reinterpret_cast<const Method::DenseElimination&>(m));
+        default: return solve(x, A, b, tag, reinterpret_cast<const Method::SparseElimination&>(m));
+        }
     }
 
     /**
@@ -109,12 +113,7 @@ namespace LinBox {
     template <class ResultVector, class Matrix, class Vector, class CategoryTag>
     ResultVector& solveInPlace(ResultVector& x, Matrix& A, const Vector& b, const CategoryTag& tag, const Method::Auto& m)
     {
-        if (useBlackboxMethod(A)) {
-            return solve(x, A, b, tag, reinterpret_cast<const Method::Blackbox&>(m));
-        }
-        else {
-            return solve(x, A, b, tag, reinterpret_cast<const Method::Elimination&>(m));
-        }
+        return solve(x, A, b, tag, m);
     }
 
     /**
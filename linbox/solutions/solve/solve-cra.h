@@ -36,6 +36,7 @@
 #include <linbox/algorithms/rational-cra-builder-early-multip.h>
 #include <linbox/algorithms/rational-cra-builder-full-multip.h>
 #include <linbox/algorithms/rational-cra.h>
+#include <linbox/algorithms/rational-cra-parallel.h>
 #include <linbox/field/rebind.h>
 #include <linbox/randiter/random-prime.h>
 #include <linbox/solutions/hadamard-bound.h>
@@ -97,7 +98,15 @@ namespace LinBox {
     /**
      * \brief Solve specialization with Chinese Remainder Algorithm method for an Integer or Rational tags.
      *
-     * If a Dispatch::Distributed is used, please note that the result will only be set on the master node.
+     * If a Dispatch::Distributed or Dispatch::Combined is used,
+     * please note that the result will only be set on the master node.
+     *
+     * With Dispatch::SMP, the primes are dispatched over a thread pool
+     * which shares the only copy of A.
+     * Dispatch::Auto never selects it: without MPI, the solve stays sequential.
+     * With Dispatch::Combined, one MPI process per node is expected,
+     * each running the SMP scheme and reducing its residues locally
+     * before sending them to the master.
      */
     template <class IntVector, class Matrix, class Vector, class IterationMethod>
     inline void solve(IntVector& xNum, typename IntVector::Element& xDen, const Matrix& A, const Vector& b,
@@ -116,8 +125,6 @@ namespace LinBox {
             // we enable it with default communicator if needed.
             newM.dispatch = Dispatch::Distributed;
 #else
-            // @note Currently, Sequential = SMP if OpenMP is active on
-            // the machine, as CRA -> ChineseRemainderSequential or ChineseRemainderOMP in cra-domain.h
             newM.dispatch = Dispatch::Sequential;
 #endif
 
@@ -128,7 +135,7 @@ namespace LinBox {
         // Declare communicator if none was yet.
         //
 
-        if (m.dispatch == Dispatch::Distributed && m.pCommunicator == nullptr) {
+        if ((m.dispatch == Dispatch::Distributed || m.dispatch == Dispatch::Combined) && m.pCommunicator == nullptr) {
             Method::CRA<IterationMethod> newM(m);
             Communicator communicator(nullptr, 0);
             newM.pCommunicator = &communicator;
@@ -172,11 +179,27 @@ namespace LinBox {
         using CRAAlgorithm = typename BestCRABuilder<CRAField, MatrixCategoryTag>::type;
         if (dispatch == Dispatch::Sequential) {
             LinBox::RationalChineseRemainder<CRAAlgorithm> cra(hadamardLogBound);
+            cra.setCheckpoint(m.checkpoint);
+            cra.setStatistics(m.statistics);
+            cra(num, den, iteration, primeGenerator);
+        }
+        else if (dispatch == Dispatch::SMP) {
+            LinBox::RationalChineseRemainderParallel<CRAAlgorithm> cra(hadamardLogBound);
+            cra.setCheckpoint(m.checkpoint);
+            cra.setStatistics(m.statistics);
             cra(num, den, iteration, primeGenerator);
         }
 #if defined(__LINBOX_HAVE_MPI)
         else if (dispatch == Dispatch::Distributed) {
             LinBox::ChineseRemainderDistributed<CRAAlgorithm> cra(hadamardLogBound, m.pCommunicator);
+            cra.setCheckpoint(m.checkpoint);
+            cra.setStatistics(m.statistics);
+            cra(num, den, iteration, primeGenerator);
+        }
+        else if (dispatch == Dispatch::Combined) {
+            LinBox::ChineseRemainderDistributed<CRAAlgorithm> cra(hadamardLogBound, m.pCommunicator, NUM_THREADS);
+            cra.setCheckpoint(m.checkpoint);
+            cra.setStatistics(m.statistics);
             cra(num, den, iteration, primeGenerator);
         }
 #endif
@@ -201,7 +224,7 @@ namespace LinBox {
             }
             R.init(xDen, den);
 
-            // @note During Dispatch::Distributed, we do not dispatch the result to all other nodes,
+            // @note During Dispatch::Distributed or Combined, we do not dispatch the result to all other nodes,
             // to prevent unnecessary broadcast, as the doc says.
 
             commentator().stop("solve.cra.integer");
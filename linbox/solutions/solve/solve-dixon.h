@@ -62,6 +62,7 @@ namespace LinBox {
 
         using Solver = DixonSolver<Ring, Field, PrimeGenerator, typename MethodForMatrix<Blackbox>::type>;
         Solver dixonSolve(A.field(), primeGenerator);
+        dixonSolve.setStatistics(m.statistics);
 
         // @fixme I'm still bit sad that we cannot use generically the function below,
         // just because RationalSolve<..., SparseElimination> has not the same
@@ -97,6 +98,8 @@ namespace LinBox {
 
         using Solver = DixonSolver<Ring, Field, PrimeGenerator, typename MethodForMatrix<Matrix>::type>;
         Solver dixonSolve(A.field(), primeGenerator);
+        dixonSolve.setCheckpoint(m.checkpoint);
+        dixonSolve.setStatistics(m.statistics);
 
         // Either A is known to be non-singular, or we just don't know yet.
         int maxTrials = m.trialsBeforeFailure;
@@ -34,9 +34,6 @@ namespace LinBox {
     // Youse's variant of Numeric Symbolic rational solve.
     //
 
-// @note LPS<...> requires LAPACK
-#if defined(__FFLASFFPACK_HAVE_LAPACK)
-
     template <class IntVector, class Matrix, class Vector>
     inline void solve(IntVector& xNum, typename IntVector::Element& xDen, const Matrix& A, const Vector& b,
                       const RingCategories::IntegerTag& tag, const Method::SymbolicNumericOverlap& m)
@@ -73,8 +70,6 @@ namespace LinBox {
         }
     }
 
-#endif
-
     //
     // Numeric Symbolic Norm
     // Wan's variant of Numeric Symbolic rational solve.
@@ -0,0 +1,135 @@
+/* Copyright (C) 2026 The LinBox group
+ *
+ * ========LICENCE========
+ * This file is part of the library LinBox.
+ *
+  * LinBox is free software: you can redistribute it and/or modify
+ * it under the terms of the  GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.	 See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ * ========LICENCE========
+ */
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <istream>
+#include <ostream>
+#include <string>
+
+/**
+ * Checkpoint/restart of long-running computations.
+ *
+ * A checkpoint file is written with the streaming serialization
+ * of serialization-stream.h and starts with:
+ *  0-3     magic       "LBXK"
+ *  4       version     Checkpoint format version, currently 1
+ *  5       kind        What follows (see CheckpointKind)
+ *
+ * Files are created atomically: the data goes to "<path>.tmp",
+ * which is synced to disk then renamed over "<path>".
+ * A crash while writing therefore leaves the previous checkpoint intact.
+ *
+ * Computations whose state grows (CRA images, p-adic digits) then append
+ * records to the file, so that a checkpoint costs the size of what is new.
+ * A crash while appending leaves a truncated last record, that readers drop.
+ */
+
+namespace LinBox {
+    enum class CheckpointKind : uint8_t {
+        CRA = 1,
+        Lifting = 2,
+    };
+
+    /**
+     * Checkpointing configuration.
+     *
+     * Checkpointing is disabled when path is empty.
+     * A checkpoint is written at most every interval seconds,
+     * so that its cost stays a small fraction of the computation time.
+     * With resume set, a computation starts from the checkpoint found at path, if any.
+     *
+     * @note The same path must not be shared by different computations.
+     */
+    struct Checkpoint {
+        std::string path;
+        double interval = 600.0; //!< Minimal number of seconds between two writes.
+        bool resume = true;      //!< Whether to start from an existing checkpoint.
+
+        Checkpoint() = default;
+        Checkpoint(const std::string& _path, double _interval = 600.0, bool _resume = true)
+            : path(_path)
+            , interval(_interval)
+            , resume(_resume)
+        {
+        }
+
+        bool enabled() const { return !path.empty(); }
+    };
+
+    /**
+     * Tells when the next checkpoint is due.
+     */
+    class CheckpointClock {
+    public:
+        CheckpointClock(double interval = 0.0)
+            : _interval(interval)
+            , _last(std::chrono::steady_clock::now())
+        {
+        }
+
+        bool due() const
+        {
+            std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - _last;
+            return elapsed.count() >= _interval;
+        }
+
+        void reset() { _last = std::chrono::steady_clock::now(); }
+
+    private:
+        double _interval;
+        std::chrono::steady_clock::time_point _last;
+    };
+
+    /**
+     * Atomically replaces the checkpoint file at path
+     * with what writer outputs after the header of the specified kind.
+     * Throws a LinboxError on failure, the previous checkpoint then being left untouched.
+     */
+    void write_checkpoint(const std::string& path, CheckpointKind kind, const std::function<void(std::ostream&)>& writer);
+
+    /**
+     * Appends what writer outputs to the checkpoint file at path,
+     * which must have been created by write_checkpoint.
+     * Throws a LinboxError on failure.
+     */
+    void append_checkpoint(const std::string& path, const std::function<void(std::ostream&)>& writer);
+
+    /**
+     * Calls reader on the content of the checkpoint file at path, after its header.
+     * Returns false if there is no such file.
+     * Throws a LinboxError if the file is not a checkpoint of the specified kind.
+     */
+    bool read_checkpoint(const std::string& path, CheckpointKind kind, const std::function<void(std::istream&)>& reader);
+}
+
+#include "checkpoint.inl"
+
+// Local Variables:
+// mode: C++
+// tab-width: 4
+// indent-tabs-mode: nil
+// c-basic-offset: 4
+// End:
+// vim:sts=4:sw=4:ts=4:et:sr:cino=>s,f0,{0,g0,(0,\:0,t0,+0,=s
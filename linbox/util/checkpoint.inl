@@ -0,0 +1,136 @@
+/* Copyright (C) 2026 The LinBox group
+ *
+ * ========LICENCE========
+ * This file is part of the library LinBox.
+ *
+  * LinBox is free software: you can redistribute it and/or modify
+ * it under the terms of the  GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.	 See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ * ========LICENCE========
+ */
+
+#pragma once
+
+#include "checkpoint.h"
+
+#include <cerrno>
+#include <fcntl.h>
+#include <unistd.h>
+
+#include "linbox/util/error.h"
+#include "linbox/util/serialization-stream.h"
+
+namespace LinBox {
+    inline void write_checkpoint(const std::string& path, CheckpointKind kind, const std::function<void(std::ostream&)>& writer)
+    {
+        const std::string tmpPath = path + ".tmp";
+
+        int fd;
+        do {
+            fd = ::open(tmpPath.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+        } while (fd < 0 && errno == EINTR);
+        if (fd < 0) {
+            throw LinboxError("LinBox ERROR: cannot open checkpoint file " + tmpPath + ".");
+        }
+
+        bool ok;
+        {
+            Protected::FdStreamBuffer buffer(fd);
+            std::ostream os(&buffer);
+            os.write("LBXK", 4);
+            os.put(1);
+            os.put(static_cast<char>(kind));
+            writer(os);
+            os.flush();
+            ok = static_cast<bool>(os);
+        }
+
+        ok = (::fsync(fd) == 0) && ok;
+        ok = (::close(fd) == 0) && ok;
+        if (!ok || ::rename(tmpPath.c_str(), path.c_str()) != 0) {
+            ::unlink(tmpPath.c_str());
+            throw LinboxError("LinBox ERROR: failed to write checkpoint file " + path + ".");
+        }
+    }
+
+    inline void append_checkpoint(const std::string& path, const std::function<void(std::ostream&)>& writer)
+    {
+        int fd;
+        do {
+            fd = ::open(path.c_str(), O_WRONLY | O_APPEND);
+        } while (fd < 0 && errno == EINTR);
+        if (fd < 0) {
+            throw LinboxError("LinBox ERROR: cannot open checkpoint file " + path + ".");
+        }
+
+        bool ok;
+        {
+            Protected::FdStreamBuffer buffer(fd);
+            std::ostream os(&buffer);
+            writer(os);
+            os.flush();
+            ok = static_cast<bool>(os);
+        }
+
+        ok = (::fsync(fd) == 0) && ok;
+        ok = (::close(fd) == 0) && ok;
+        if (!ok) {
+            throw LinboxError("LinBox ERROR: failed to append to checkpoint file " + path + ".");
+        }
+    }
+
+    inline bool read_checkpoint(const std::string& path, CheckpointKind kind, const std::function<void(std::istream&)>& reader)
+    {
+        int fd;
+        do {
+            fd = ::open(path.c_str(), O_RDONLY);
+        } while (fd < 0 && errno == EINTR);
+        if (fd < 0) {
+            return false;
+        }
+
+        try {
+            Protected::FdStreamBuffer buffer(fd);
+            std::istream is(&buffer);
+
+            char header[6];
+            is.read(header, 6);
+            if (!is || header[0] != 'L' || header[1] != 'B' || header[2] != 'X' || header[3] != 'K') {
+                throw LinboxError("LinBox ERROR: " + path + " is not a LinBox checkpoint file.");
+            }
+            if (header[4] != 1) {
+                throw LinboxError("LinBox ERROR: unsupported checkpoint version in " + path + ".");
+            }
+            if (header[5] != static_cast<char>(kind)) {
+                throw LinboxError("LinBox ERROR: " + path + " is a checkpoint of another kind of computation.");
+            }
+
+            reader(is);
+        }
+        catch (...) {
+            ::close(fd);
+            throw;
+        }
+
+        ::close(fd);
+        return true;
+    }
+}
+
+// Local Variables:
+// mode: C++
+// tab-width: 4
+// indent-tabs-mode: nil
+// c-basic-offset: 4
+// End:
+// vim:sts=4:sw=4:ts=4:et:sr:cino=>s,f0,{0,g0,(0,\:0,t0,+0,=s
@@ -49,6 +49,7 @@
 
 //#include "linbox/util/timer.h"
 #include "givaro/givtimer.h"
+#include "linbox/util/instrumentation.h"
 
 #ifndef MAX
 #  define MAX(a,b) (((a) > (b)) ? (a) : (b))
@@ -868,12 +869,13 @@ namespace LinBox
             {}
             inline  ~Commentator ()
             {}
-            inline void start (const char *, const char * = (const char *) 0, unsigned long = 0)
-            {}
+            // activities are still traced, see instrumentation.h
+            inline void start (const char *description, const char * = (const char *) 0, unsigned long = 0)
+            { Instrumentation::begin (description); }
             inline void startIteration (unsigned int , unsigned long = 0)
-            {}
+            { Instrumentation::begin ("Iteration"); }
             inline void stop (const char *, const char * = (const char *) 0, const char * = (const char *) 0)
-            {}
+            { Instrumentation::end (); }
             inline void progress (long = -1, long = -1)
             {}
 
@@ -938,10 +940,10 @@ namespace LinBox
             {}
             inline void setDefaultReportFile (const char *)
             {}
-            inline void start (const char *, const char *, long , const char *)
-            {}
+            inline void start (const char *id, const char *, long , const char *)
+            { Instrumentation::begin (id); }
             inline void stop (const char *, long , const char *, long)
-            {}
+            { Instrumentation::end (); }
             inline void progress (const char *, long , long , long )
             {}
             inline void report (const char *, long , const char *)
@@ -994,15 +996,53 @@ namespace LinBox
 
     namespace LinBox
     {
+        namespace Protected {
+            // Commentator of the calling thread when it runs within a TaskCommentator.
+            inline Commentator*& threadCommentator() {
+                static thread_local Commentator* local = nullptr;
+                return local;
+            }
+        }
+
         // Default static commentator
         inline Commentator& commentator() {
             static Commentator internal_static_commentator;
-            return internal_static_commentator;
+            Commentator* local = Protected::threadCommentator();
+            return local ? *local : internal_static_commentator;
         }
         inline Commentator& commentator(std::ostream& stream) {
             static Commentator internal_static_commentator(stream);
             return internal_static_commentator;
         }
+
+        /** \brief Gives the calling thread a silent commentator of its own.
+         *
+         * The global commentator keeps a stack of activities and is not thread safe.
+         * Tasks run concurrently (e.g. the iterations of a parallel CRA loop)
+         * are wrapped in a TaskCommentator, so that the reports of the code they
+         * call go to their own commentator, and only the thread driving the loop
+         * reports to the global one.
+         */
+        class TaskCommentator {
+        public:
+            TaskCommentator() :
+                _previous(Protected::threadCommentator())
+            {
+                Protected::threadCommentator() = &_commentator;
+            }
+
+            ~TaskCommentator()
+            {
+                Protected::threadCommentator() = _previous;
+            }
+
+            TaskCommentator(const TaskCommentator&) = delete;
+            TaskCommentator& operator=(const TaskCommentator&) = delete;
+
+        private:
+            Commentator _commentator;
+            Commentator* _previous;
+        };
     }
 
 
@@ -146,6 +146,7 @@ namespace LinBox
 
         _activities.push (new_act);
 
+        Instrumentation::begin (description);
         new_act->_timer.start ();
     }
 
@@ -178,6 +179,7 @@ namespace LinBox
         top_act = _activities.top ();
 
         top_act->_timer.stop ();
+        Instrumentation::end ();
 
         realtime = top_act->_timer.time ();
         //usertime = top_act->_timer.usertime ();
@@ -0,0 +1,442 @@
+/* Copyright (C) 2026 The LinBox group
+ *
+ * ========LICENCE========
+ * This file is part of the library LinBox.
+ *
+  * LinBox is free software: you can redistribute it and/or modify
+ * it under the terms of the  GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.	 See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ * ========LICENCE========
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include "linbox/util/timer.h"
+
+/**
+ * Thread-safe tracing of scoped events.
+ *
+ * Each thread records its events (name, start, end, depth and a few
+ * counters) in its own ring buffer, without locks; the oldest events are
+ * overwritten when a buffer is full.  A thread takes a lock only once, to
+ * register its buffer.
+ *
+ * Tracing is off by default and then costs a relaxed atomic load per
+ * scope.  It is switched on by Instrumentation::enable(), or for a whole
+ * run by the environment variable LINBOX_TRACE naming the file to which the
+ * trace is written at exit (CSV when it ends with ".csv", Chrome trace JSON
+ * otherwise, to be opened in chrome://tracing or Perfetto).  Defining
+ * LINBOX_DISABLE_INSTRUMENTATION removes it at compile time.
+ *
+ * \code
+ * void f() {
+ *     LINBOX_TRACE_SCOPE("f");
+ *     for (...) {
+ *         Instrumentation::Scope step("f: step");
+ *         step.counter(0, k);
+ *         ...
+ *     }
+ * }
+ * \endcode
+ * The Commentator activities are traced as well, from start () to stop (),
+ * and so are the phases timed by a TracedTimer (the RSTIMING timers).
+ *
+ * @note The trace should be exported while the traced threads are idle: a
+ * buffer being written to may give a partly overwritten event.
+ */
+
+#ifndef LINBOX_TRACE_BUFFER_SIZE
+#define LINBOX_TRACE_BUFFER_SIZE 16384 //!< Events kept per thread.
+#endif
+
+#ifndef LINBOX_TRACE_MAX_DEPTH
+#define LINBOX_TRACE_MAX_DEPTH 64 //!< Deeper scopes are not recorded.
+#endif
+
+namespace LinBox {
+    namespace Instrumentation {
+        const size_t nameSize = 48;
+        const size_t nbCounters = 2;
+
+        struct Event {
+            char name[nameSize];            //!< Truncated to nameSize-1 characters.
+            uint64_t start;                 //!< In nanoseconds since the first event of the run.
+            uint64_t end;
+            uint32_t thread;                //!< Order of the first event of the thread.
+            uint32_t depth;                 //!< Number of enclosing scopes of the thread.
+            int64_t counters[nbCounters];   //!< Set by Scope::counter() or Instrumentation::counter().
+
+            double duration() const { return double(end - start) * 1e-9; }
+        };
+
+        /// Events of one thread: a ring buffer and the stack of its open scopes.
+        class ThreadBuffer {
+        public:
+            ThreadBuffer(uint32_t thread, size_t capacity) : _events(capacity), _written(0), _thread(thread), _depth(0) {}
+
+            Event* open(const char* name, uint64_t now)
+            {
+                if (_depth++ >= LINBOX_TRACE_MAX_DEPTH) return nullptr;
+                Event& e = _open[_depth - 1];
+                std::strncpy(e.name, name, nameSize - 1);
+                e.name[nameSize - 1] = '\0';
+                e.start = now;
+                e.thread = _thread;
+                e.depth = _depth - 1;
+                std::fill(e.counters, e.counters + nbCounters, 0);
+                return &e;
+            }
+
+            Event* top() { return (_depth > 0 && _depth <= LINBOX_TRACE_MAX_DEPTH) ? &_open[_depth - 1] : nullptr; }
+
+            void close(uint64_t now)
+            {
+                if (_depth == 0) return;
+                Event* e = top();
+                --_depth;
+                if (e == nullptr) return;
+                e->end = now;
+                push(*e);
+            }
+
+            /// Records a complete event within the open scopes, without opening one.
+            void record(const char* name, uint64_t start, uint64_t end)
+            {
+                Event e;
+                std::strncpy(e.name, name, nameSize - 1);
+                e.name[nameSize - 1] = '\0';
+                e.start = start;
+                e.end = end;
+                e.thread = _thread;
+                e.depth = _depth;
+                std::fill(e.counters, e.counters + nbCounters, 0);
+                push(e);
+            }
+
+            /// Appends the recorded events, oldest first.
+            void copy(std::vector<Event>& events) const
+            {
+                const uint64_t w = _written.load(std::memory_order_acquire);
+                const uint64_t n = std::min<uint64_t>(w, _events.size());
+                for (uint64_t k = w - n; k < w; ++k) events.push_back(_events[k % _events.size()]);
+            }
+
+            void clear() { _written.store(0, std::memory_order_release); }
+
+            uint64_t lost() const
+            {
+                const uint64_t w = _written.load(std::memory_order_acquire);
+                return w > _events.size() ? w - _events.size() : 0;
+            }
+
+        private:
+            void push(const Event& e)
+            {
+                if (_events.empty()) return;
+                const uint64_t w = _written.load(std::memory_order_relaxed);
+                _events[w % _events.size()] = e;
+                _written.store(w + 1, std::memory_order_release);
+            }
+
+            std::vector<Event> _events;
+            std::atomic<uint64_t> _written;
+            Event _open[LINBOX_TRACE_MAX_DEPTH];
+            uint32_t _thread;
+            uint32_t _depth;
+        };
+
+        std::ostream& writeChromeTrace(std::ostream& os, const std::vector<Event>& events);
+        std::ostream& writeCSV(std::ostream& os, const std::vector<Event>& events);
+
+        /// The buffers of all threads, and the export at exit asked for by LINBOX_TRACE.
+        class Registry {
+        public:
+            static Registry& instance()
+            {
+                static Registry registry;
+                return registry;
+            }
+
+            static std::atomic<bool>& enabledFlag()
+            {
+                static std::atomic<bool> flag(std::getenv("LINBOX_TRACE") != nullptr);
+                return flag;
+            }
+
+            ThreadBuffer& local()
+            {
+                thread_local ThreadBuffer* buffer = nullptr;
+                if (buffer == nullptr) {
+                    std::lock_guard<std::mutex> lock(_mutex);
+                    _buffers.emplace_back(new ThreadBuffer((uint32_t)_buffers.size(), _capacity));
+                    buffer = _buffers.back().get();
+                }
+                return *buffer;
+            }
+
+            uint64_t now() const
+            {
+                return (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - _origin).count();
+            }
+
+            std::vector<Event> events()
+            {
+                std::vector<Event> all;
+                {
+                    std::lock_guard<std::mutex> lock(_mutex);
+                    for (const auto& buffer : _buffers) buffer->copy(all);
+                }
+                std::stable_sort(all.begin(), all.end(), [](const Event& a, const Event& b) { return a.start < b.start; });
+                return all;
+            }
+
+            void clear()
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+                for (const auto& buffer : _buffers) buffer->clear();
+            }
+
+            uint64_t lost()
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+                uint64_t n = 0;
+                for (const auto& buffer : _buffers) n += buffer->lost();
+                return n;
+            }
+
+            /// Capacity of the buffers of the threads not yet traced.
+            void setCapacity(size_t capacity) { _capacity = capacity; }
+
+            ~Registry()
+            {
+                const char* path = std::getenv("LINBOX_TRACE");
+                if (path == nullptr || *path == '\0') return;
+                std::ofstream file(path);
+                const std::string name(path);
+                if (name.size() >= 4 && name.compare(name.size() - 4, 4, ".csv") == 0)
+                    writeCSV(file, events());
+                else
+                    writeChromeTrace(file, events());
+            }
+
+        private:
+            Registry() : _origin(std::chrono::steady_clock::now()), _capacity(LINBOX_TRACE_BUFFER_SIZE) {}
+
+            std::mutex _mutex;
+            std::vector<std::unique_ptr<ThreadBuffer>> _buffers;
+            std::chrono::steady_clock::time_point _origin;
+            size_t _capacity;
+        };
+
+        /// Whether events are recorded.
+        inline bool enabled()
+        {
+#ifdef LINBOX_DISABLE_INSTRUMENTATION
+            return false;
+#else
+            return Registry::enabledFlag().load(std::memory_order_relaxed);
+#endif
+        }
+
+        /**
+         * Starts recording.
+         * Enabling or disabling inside a traced scope loses the scope.
+         * @param capacity events kept per thread, for the threads not traced yet.
+         */
+        inline void enable(size_t capacity = LINBOX_TRACE_BUFFER_SIZE)
+        {
+            Registry::instance().setCapacity(capacity);
+            Registry::enabledFlag().store(true);
+        }
+
+        inline void disable() { Registry::enabledFlag().store(false); }
+
+        /// Forgets the recorded events.
+        inline void clear() { Registry::instance().clear(); }
+
+        /// Opens a scope of the calling thread (prefer Scope).
+        inline void begin(const char* name)
+        {
+            if (!enabled()) return;
+            Registry& r = Registry::instance();
+            r.local().open(name, r.now());
+        }
+
+        /// Closes the innermost open scope of the calling thread.
+        inline void end()
+        {
+            if (!enabled()) return;
+            Registry& r = Registry::instance();
+            r.local().close(r.now());
+        }
+
+        /// Sets counter i of the innermost open scope of the calling thread.
+        inline void counter(size_t i, int64_t value)
+        {
+            if (!enabled() || i >= nbCounters) return;
+            Event* e = Registry::instance().local().top();
+            if (e != nullptr) e->counters[i] = value;
+        }
+
+        /// Records an event of the calling thread, from start to now.
+        inline void record(const char* name, uint64_t start)
+        {
+            if (!enabled()) return;
+            Registry& r = Registry::instance();
+            r.local().record(name, start, r.now());
+        }
+
+        /// Current time of the trace, in nanoseconds.
+        inline uint64_t now() { return Registry::instance().now(); }
+
+        /// Recorded events of all threads, by start time.
+        inline std::vector<Event> events() { return Registry::instance().events(); }
+
+        /// Number of events overwritten in full buffers.
+        inline uint64_t lost() { return Registry::instance().lost(); }
+
+        /**
+         * Scope traced from construction to destruction.
+         * The name is copied.
+         */
+        class Scope {
+        public:
+            explicit Scope(const char* name) : _active(enabled())
+            {
+                if (_active) {
+                    Registry& r = Registry::instance();
+                    _buffer = &r.local();
+                    _event = _buffer->open(name, r.now());
+                }
+            }
+
+            explicit Scope(const std::string& name) : Scope(name.c_str()) {}
+
+            ~Scope()
+            {
+                if (_active) _buffer->close(Registry::instance().now());
+            }
+
+            void counter(size_t i, int64_t value)
+            {
+                if (_event != nullptr && i < nbCounters) _event->counters[i] = value;
+            }
+
+            Scope(const Scope&) = delete;
+            Scope& operator=(const Scope&) = delete;
+
+        private:
+            bool _active;
+            ThreadBuffer* _buffer = nullptr;
+            Event* _event = nullptr; //!< Open event of this scope, null when too deep.
+        };
+
+        /**
+         * Timer whose start () to stop () intervals are traced as well.
+         *
+         * The interval is recorded when the timer stops, as a complete event:
+         * a timer left running, e.g. by an early return, records nothing and
+         * leaves the open scopes as they are.  The name is not copied.
+         */
+        class TracedTimer : public Timer {
+        public:
+            explicit TracedTimer(const char* name) : _name(name), _start(0), _traced(false) {}
+
+            void start()
+            {
+                Timer::start();
+                _traced = enabled();
+                if (_traced) _start = now();
+            }
+
+            void stop()
+            {
+                Timer::stop();
+                if (_traced) record(_name, _start);
+                _traced = false;
+            }
+
+        private:
+            const char* _name;
+            uint64_t _start;
+            bool _traced;
+        };
+
+        namespace Protected {
+            inline std::ostream& writeJSONString(std::ostream& os, const char* s)
+            {
+                os << '"';
+                for (; *s; ++s) {
+                    if (*s == '"' || *s == '\\')
+                        os << '\\' << *s;
+                    else if ((unsigned char)*s >= 0x20)
+                        os << *s;
+                }
+                return os << '"';
+            }
+        }
+
+        /// Complete ("X") events of the Chrome trace event format, in microseconds.
+        inline std::ostream& writeChromeTrace(std::ostream& os, const std::vector<Event>& events)
+        {
+            os << "{\"traceEvents\":[";
+            bool first = true;
+            for (const Event& e : events) {
+                os << (first ? "\n" : ",\n") << "{\"name\":";
+                Protected::writeJSONString(os, e.name);
+                os << ",\"ph\":\"X\",\"pid\":0,\"tid\":" << e.thread << ",\"ts\":" << double(e.start) * 1e-3
+                   << ",\"dur\":" << double(e.end - e.start) * 1e-3 << ",\"args\":{\"depth\":" << e.depth;
+                for (size_t i = 0; i < nbCounters; ++i) os << ",\"counter" << i << "\":" << e.counters[i];
+                os << "}}";
+                first = false;
+            }
+            return os << "\n],\"displayTimeUnit\":\"ms\"}" << std::endl;
+        }
+
+        /// One line per event; times in seconds.
+        inline std::ostream& writeCSV(std::ostream& os, const std::vector<Event>& events)
+        {
+            os << "name, thread, depth, start, end, duration";
+            for (size_t i = 0; i < nbCounters; ++i) os << ", counter" << i;
+            os << std::endl;
+            for (const Event& e : events) {
+                std::string name(e.name);
+                std::replace(name.begin(), name.end(), ',', ';');
+                os << name << ", " << e.thread << ", " << e.depth << ", " << double(e.start) * 1e-9 << ", "
+                   << double(e.end) * 1e-9 << ", " << e.duration();
+                for (size_t i = 0; i < nbCounters; ++i) os << ", " << e.counters[i];
+                os << std::endl;
+            }
+            return os;
+        }
+    }
+}
+
+#define LINBOX_TRACE_CONCAT_(a, b) a##b
+#define LINBOX_TRACE_CONCAT(a, b) LINBOX_TRACE_CONCAT_(a, b)
+
+/// Traces the enclosing block under the given name.
+#define LINBOX_TRACE_SCOPE(name) LinBox::Instrumentation::Scope LINBOX_TRACE_CONCAT(_linbox_trace_scope_, __LINE__)(name)
@@ -38,15 +38,38 @@ namespace LinBox {
         template <class T> inline void ssend(const T& value, int dest) {}
         template <class T> inline void recv(T& value, int src) {}
         template <class T> inline void bcast(T& value, int src) {}
+        inline bool iprobe(int src) { return false; }
+
+        inline uint64_t chunkSize() const { return 0u; }
+        inline void setChunkSize(uint64_t chunkSize) {}
     };
 }
 #else
 
 #include <mpi.h>
+#include <type_traits>
+#include <vector>
+
+#include "linbox/matrix/sparse-formats.h"
 
 namespace LinBox {
+    template <class _Field, class _Storage> class BlasMatrix;
+    template <class _Field, class _Storage> class BlasVector;
+    template <class _Field, class _Storage> class SparseMatrix;
+    template <class T> struct MPITypeTraits;
+
     /**
      * MPI-based communicator to send/receive LinBox data (like matrices).
+     *
+     * Objects are serialized to bytes before being sent,
+     * except for BlasMatrix, BlasVector and SparseMatrix over word-size elements:
+     * those are sent as typed MPI buffers, straight from their storage for dense ones,
+     * and as packed CSR row starts and column indices (32-bit if possible) for sparse ones,
+     * their values being read and written in place in the rows.
+     * The choice is made at compile time, by tag dispatch on MPITypeTraits.
+     * Buffers are split in chunks of at most chunkSize() bytes,
+     * which are posted all at once (non-blocking), so that objects above 2GB
+     * can be transmitted and the network pipelines the chunks.
      */
     class Communicator {
     public:
@@ -89,12 +112,80 @@ namespace LinBox {
         template <class T> void recv(T& value, int src);
         template <class T> void bcast(T& value, int src);
 
+        // Whether a whole object from src (or MPI_ANY_SOURCE) can be received, without blocking.
+        // On success, status() tells its source.
+        bool iprobe(int src);
+
+        // typed communication of containers (falls back to serialization if elements are not word-size)
+        template <class Field, class Storage> void send(const BlasMatrix<Field, Storage>& M, int dest);
+        template <class Field, class Storage> void ssend(const BlasMatrix<Field, Storage>& M, int dest);
+        template <class Field, class Storage> void recv(BlasMatrix<Field, Storage>& M, int src);
+        template <class Field, class Storage> void bcast(BlasMatrix<Field, Storage>& M, int src);
+
+        template <class Field, class Storage> void send(const BlasVector<Field, Storage>& V, int dest);
+        template <class Field, class Storage> void ssend(const BlasVector<Field, Storage>& V, int dest);
+        template <class Field, class Storage> void recv(BlasVector<Field, Storage>& V, int src);
+        template <class Field, class Storage> void bcast(BlasVector<Field, Storage>& V, int src);
+
+        template <class Field> void send(const SparseMatrix<Field, SparseMatrixFormat::SparseSeq>& M, int dest);
+        template <class Field> void ssend(const SparseMatrix<Field, SparseMatrixFormat::SparseSeq>& M, int dest);
+        template <class Field> void recv(SparseMatrix<Field, SparseMatrixFormat::SparseSeq>& M, int src);
+        template <class Field> void bcast(SparseMatrix<Field, SparseMatrixFormat::SparseSeq>& M, int src);
+
+        // Maximum size in bytes of one MPI message for typed communications.
+        // It may differ between ranks: the receivers use the chunk size of the sender.
+        uint64_t chunkSize() const { return _chunkSize; }
+        void setChunkSize(uint64_t chunkSize) { _chunkSize = chunkSize; }
+
+    protected:
+        // Byte-serialized communication, used for all other types.
+        template <class T> void sendBytes(const T& value, int dest, bool synchronous);
+        template <class T> void recvBytes(T& value, int src);
+        template <class T> void bcastBytes(T& value, int src);
+
+        // Chunked and pipelined buffer transfers, count is the number of T.
+        // The chunk size, in bytes, is the one of the sender, sent in the message header.
+        template <class T> void sendBuffer(const T* data, uint64_t count, int dest, bool synchronous, uint64_t chunkSize);
+        template <class T> void recvBuffer(T* data, uint64_t count, int src, uint64_t chunkSize);
+        template <class T> void bcastBuffer(T* data, uint64_t count, int src, uint64_t chunkSize);
+
+        // Typed communication when the elements are word-size (std::true_type), serialization otherwise.
+        template <class Field> using NativeTag = std::integral_constant<bool, MPITypeTraits<typename Field::Element>::native>;
+
+        template <class T> void sendObject(const T& value, int dest, bool synchronous, std::false_type);
+        template <class T> void recvObject(T& value, int src, std::false_type);
+        template <class T> void bcastObject(T& value, int src, std::false_type);
+
+        template <class Field, class Storage> void sendObject(const BlasMatrix<Field, Storage>& M, int dest, bool synchronous, std::true_type);
+        template <class Field, class Storage> void recvObject(BlasMatrix<Field, Storage>& M, int src, std::true_type);
+        template <class Field, class Storage> void bcastObject(BlasMatrix<Field, Storage>& M, int src, std::true_type);
+
+        template <class Field, class Storage> void sendObject(const BlasVector<Field, Storage>& V, int dest, bool synchronous, std::true_type);
+        template <class Field, class Storage> void recvObject(BlasVector<Field, Storage>& V, int src, std::true_type);
+        template <class Field, class Storage> void bcastObject(BlasVector<Field, Storage>& V, int src, std::true_type);
+
+        template <class Field> void sendObject(const SparseMatrix<Field, SparseMatrixFormat::SparseSeq>& M, int dest, bool synchronous, std::true_type);
+        template <class Field> void recvObject(SparseMatrix<Field, SparseMatrixFormat::SparseSeq>& M, int src, std::true_type);
+        template <class Field> void bcastObject(SparseMatrix<Field, SparseMatrixFormat::SparseSeq>& M, int src, std::true_type);
+
+        template <class Matrix> void sendDense(const Matrix& M, uint64_t n, uint64_t m, int dest, bool synchronous);
+
+        // Sparse rows: row starts and packed column indices, then the values read or written in place in the rows.
+        template <class Field> void packSparse(const SparseMatrix<Field, SparseMatrixFormat::SparseSeq>& M, std::vector<uint64_t>& rowStarts,
+                                               std::vector<uint32_t>& colIndices32, std::vector<uint64_t>& colIndices64);
+        template <class Field> void unpackSparse(SparseMatrix<Field, SparseMatrixFormat::SparseSeq>& M, const uint64_t* header,
+                                                 const std::vector<uint64_t>& rowStarts, const std::vector<uint32_t>& colIndices32,
+                                                 const std::vector<uint64_t>& colIndices64);
+        template <class Field, class Post>
+        void postSparseValues(const SparseMatrix<Field, SparseMatrixFormat::SparseSeq>& M, uint64_t chunkSize, Post post);
+
     protected:
         MPI_Comm _comm;       // MPI's handle for the communicator
         MPI_Status _status;   // status from most recent receive
         int _size = 0;
         int _rank = 0;
         bool _boss = false;   // Whether it's a MPI initializing communicator
+        uint64_t _chunkSize = 1u << 30; // 1GB, below the 2GB limit of MPI int counts
     };
 }
 
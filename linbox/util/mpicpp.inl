@@ -26,8 +26,39 @@
 
 #include "./serialization.h"
 
+#include <algorithm>
+#include <climits>
+
 namespace LinBox {
 
+    /**
+     * MPI datatype of word-size elements,
+     * native is false for all types that need to be serialized.
+     */
+    template <class T> struct MPITypeTraits {
+        static constexpr bool native = false;
+        static MPI_Datatype type() { return MPI_BYTE; }
+    };
+
+#define LINBOX_MPI_TYPE_TRAITS(T, MPIType)                                                                                       \
+    template <> struct MPITypeTraits<T> {                                                                                        \
+        static constexpr bool native = true;                                                                                     \
+        static MPI_Datatype type() { return MPIType; }                                                                           \
+    };
+
+    LINBOX_MPI_TYPE_TRAITS(float, MPI_FLOAT)
+    LINBOX_MPI_TYPE_TRAITS(double, MPI_DOUBLE)
+    LINBOX_MPI_TYPE_TRAITS(int8_t, MPI_INT8_T)
+    LINBOX_MPI_TYPE_TRAITS(uint8_t, MPI_UINT8_T)
+    LINBOX_MPI_TYPE_TRAITS(int16_t, MPI_INT16_T)
+    LINBOX_MPI_TYPE_TRAITS(uint16_t, MPI_UINT16_T)
+    LINBOX_MPI_TYPE_TRAITS(int32_t, MPI_INT32_T)
+    LINBOX_MPI_TYPE_TRAITS(uint32_t, MPI_UINT32_T)
+    LINBOX_MPI_TYPE_TRAITS(int64_t, MPI_INT64_T)
+    LINBOX_MPI_TYPE_TRAITS(uint64_t, MPI_UINT64_T)
+
+#undef LINBOX_MPI_TYPE_TRAITS
+
     // ----- Constructors
 
     Communicator::Communicator(int* argc, char*** argv)
@@ -60,6 +91,7 @@ namespace LinBox {
         , _size(communicator._size)
         , _rank(communicator._rank)
         , _boss(false)
+        , _chunkSize(communicator._chunkSize)
     {
     }
 
@@ -72,6 +104,13 @@ namespace LinBox {
 
     // peer to peer communication
 
+    bool Communicator::iprobe(int src)
+    {
+        int flag = 0;
+        MPI_Iprobe(src, 0, _comm, &flag, &_status);
+        return flag != 0;
+    }
+
     template <class Ptr> void Communicator::send(Ptr b, Ptr e, int dest, int tag)
     {
         MPI_Send(&*b, (e - b) * sizeof(typename Ptr::value_type), MPI_BYTE, dest, tag, _comm);
@@ -94,21 +133,29 @@ namespace LinBox {
 
     // whole object communication
 
-    template <class T> void Communicator::send(const T& value, int dest)
-    {
-        std::vector<uint8_t> bytes;
-        uint64_t length = serialize(bytes, value);
-        MPI_Send(bytes.data(), length, MPI_UINT8_T, dest, 0, _comm);
-    }
+    template <class T> void Communicator::send(const T& value, int dest) { sendBytes(value, dest, false); }
+
+    template <class T> void Communicator::ssend(const T& value, int dest) { sendBytes(value, dest, true); }
+
+    template <class T> void Communicator::recv(T& value, int src) { recvBytes(value, src); }
 
-    template <class T> void Communicator::ssend(const T& value, int dest)
+    template <class T> void Communicator::bcast(T& value, int src) { bcastBytes(value, src); }
+
+    // byte-serialized communication
+
+    template <class T> void Communicator::sendBytes(const T& value, int dest, bool synchronous)
     {
         std::vector<uint8_t> bytes;
         uint64_t length = serialize(bytes, value);
-        MPI_Ssend(bytes.data(), length, MPI_UINT8_T, dest, 0, _comm);
+        if (synchronous) {
+            MPI_Ssend(bytes.data(), length, MPI_UINT8_T, dest, 0, _comm);
+        }
+        else {
+            MPI_Send(bytes.data(), length, MPI_UINT8_T, dest, 0, _comm);
+        }
     }
 
-    template <class T> void Communicator::recv(T& value, int src)
+    template <class T> void Communicator::recvBytes(T& value, int src)
     {
         int length = 0;
         MPI_Probe(src, 0, _comm, &_status);
@@ -119,7 +166,7 @@ namespace LinBox {
         unserialize(value, bytes);
     }
 
-    template <class T> void Communicator::bcast(T& value, int src)
+    template <class T> void Communicator::bcastBytes(T& value, int src)
     {
         uint64_t length = 0;
         std::vector<uint8_t> bytes;
@@ -137,6 +184,417 @@ namespace LinBox {
             unserialize(value, bytes);
         }
     }
+
+    // chunked buffers
+
+    template <class T> void Communicator::sendBuffer(const T* data, uint64_t count, int dest, bool synchronous, uint64_t chunkSize)
+    {
+        const uint64_t chunkCount = std::max<uint64_t>(1u, std::min<uint64_t>(chunkSize / sizeof(T), INT_MAX));
+
+        // @note All chunks are posted at once, so that they are pipelined by MPI,
+        // the non-overtaking rule guarantees they are matched in order.
+        std::vector<MPI_Request> requests;
+        requests.reserve((count + chunkCount - 1) / chunkCount);
+        for (uint64_t offset = 0u; offset < count; offset += chunkCount) {
+            int length = static_cast<int>(std::min(chunkCount, count - offset));
+            requests.emplace_back();
+            T* chunk = const_cast<T*>(data + offset);
+            if (synchronous) {
+                MPI_Issend(chunk, length, MPITypeTraits<T>::type(), dest, 0, _comm, &requests.back());
+            }
+            else {
+                MPI_Isend(chunk, length, MPITypeTraits<T>::type(), dest, 0, _comm, &requests.back());
+            }
+        }
+
+        MPI_Waitall(requests.size(), requests.data(), MPI_STATUSES_IGNORE);
+    }
+
+    template <class T> void Communicator::recvBuffer(T* data, uint64_t count, int src, uint64_t chunkSize)
+    {
+        const uint64_t chunkCount = std::max<uint64_t>(1u, std::min<uint64_t>(chunkSize / sizeof(T), INT_MAX));
+
+        std::vector<MPI_Request> requests;
+        requests.reserve((count + chunkCount - 1) / chunkCount);
+        for (uint64_t offset = 0u; offset < count; offset += chunkCount) {
+            int length = static_cast<int>(std::min(chunkCount, count - offset));
+            requests.emplace_back();
+            MPI_Irecv(data + offset, length, MPITypeTraits<T>::type(), src, 0, _comm, &requests.back());
+        }
+
+        MPI_Waitall(requests.size(), requests.data(), MPI_STATUSES_IGNORE);
+    }
+
+    template <class T> void Communicator::bcastBuffer(T* data, uint64_t count, int src, uint64_t chunkSize)
+    {
+        const uint64_t chunkCount = std::max<uint64_t>(1u, std::min<uint64_t>(chunkSize / sizeof(T), INT_MAX));
+
+        std::vector<MPI_Request> requests;
+        requests.reserve((count + chunkCount - 1) / chunkCount);
+        for (uint64_t offset = 0u; offset < count; offset += chunkCount) {
+            int length = static_cast<int>(std::min(chunkCount, count - offset));
+            requests.emplace_back();
+            MPI_Ibcast(data + offset, length, MPITypeTraits<T>::type(), src, _comm, &requests.back());
+        }
+
+        MPI_Waitall(requests.size(), requests.data(), MPI_STATUSES_IGNORE);
+    }
+
+    // ----- Serialized objects
+
+    template <class T> void Communicator::sendObject(const T& value, int dest, bool synchronous, std::false_type)
+    {
+        sendBytes(value, dest, synchronous);
+    }
+
+    template <class T> void Communicator::recvObject(T& value, int src, std::false_type)
+    {
+        recvBytes(value, src);
+    }
+
+    template <class T> void Communicator::bcastObject(T& value, int src, std::false_type)
+    {
+        bcastBytes(value, src);
+    }
+
+    // ----- BlasMatrix and BlasVector
+
+    /**
+     * Header of typed messages (5 x uint64_t):
+     *  0   n       Row dimension (length for vectors)
+     *  1   m       Column dimension (1 for vectors)
+     *  2   nnz     Number of stored entries
+     *  3   index   Bytes per column index (sparse only, 0 otherwise)
+     *  4   chunk   chunkSize() of the sender, or of the root of a broadcast
+     *
+     * The buffers which follow are split in chunks of header[4] bytes on all sides,
+     * so that the chunks match even if the ranks have set different chunk sizes.
+     */
+
+    template <class Matrix> void Communicator::sendDense(const Matrix& M, uint64_t n, uint64_t m, int dest, bool synchronous)
+    {
+        uint64_t header[5] = {n, m, n * m, 0u, _chunkSize};
+        if (synchronous) {
+            MPI_Ssend(header, 5, MPI_UINT64_T, dest, 0, _comm);
+        }
+        else {
+            MPI_Send(header, 5, MPI_UINT64_T, dest, 0, _comm);
+        }
+        sendBuffer(M.getPointer(), n * m, dest, synchronous, header[4]);
+    }
+
+    template <class Field, class Storage> void Communicator::send(const BlasMatrix<Field, Storage>& M, int dest)
+    {
+        sendObject(M, dest, false, NativeTag<Field>());
+    }
+
+    template <class Field, class Storage> void Communicator::ssend(const BlasMatrix<Field, Storage>& M, int dest)
+    {
+        sendObject(M, dest, true, NativeTag<Field>());
+    }
+
+    template <class Field, class Storage> void Communicator::recv(BlasMatrix<Field, Storage>& M, int src)
+    {
+        recvObject(M, src, NativeTag<Field>());
+    }
+
+    template <class Field, class Storage> void Communicator::bcast(BlasMatrix<Field, Storage>& M, int src)
+    {
+        bcastObject(M, src, NativeTag<Field>());
+    }
+
+    template <class Field, class Storage>
+    void Communicator::sendObject(const BlasMatrix<Field, Storage>& M, int dest, bool synchronous, std::true_type)
+    {
+        sendDense(M, M.rowdim(), M.coldim(), dest, synchronous);
+    }
+
+    template <class Field, class Storage> void Communicator::recvObject(BlasMatrix<Field, Storage>& M, int src, std::true_type)
+    {
+        uint64_t header[5];
+        MPI_Recv(header, 5, MPI_UINT64_T, src, 0, _comm, &_status);
+        M.resize(header[0], header[1]);
+        recvBuffer(M.getPointer(), header[2], _status.MPI_SOURCE, header[4]);
+    }
+
+    template <class Field, class Storage> void Communicator::bcastObject(BlasMatrix<Field, Storage>& M, int src, std::true_type)
+    {
+        uint64_t header[5] = {M.rowdim(), M.coldim(), M.rowdim() * M.coldim(), 0u, _chunkSize};
+        MPI_Bcast(header, 5, MPI_UINT64_T, src, _comm);
+        if (src != _rank) {
+            M.resize(header[0], header[1]);
+        }
+        bcastBuffer(M.getPointer(), header[2], src, header[4]);
+    }
+
+    template <class Field, class Storage> void Communicator::send(const BlasVector<Field, Storage>& V, int dest)
+    {
+        sendObject(V, dest, false, NativeTag<Field>());
+    }
+
+    template <class Field, class Storage> void Communicator::ssend(const BlasVector<Field, Storage>& V, int dest)
+    {
+        sendObject(V, dest, true, NativeTag<Field>());
+    }
+
+    template <class Field, class Storage> void Communicator::recv(BlasVector<Field, Storage>& V, int src)
+    {
+        recvObject(V, src, NativeTag<Field>());
+    }
+
+    template <class Field, class Storage> void Communicator::bcast(BlasVector<Field, Storage>& V, int src)
+    {
+        bcastObject(V, src, NativeTag<Field>());
+    }
+
+    template <class Field, class Storage>
+    void Communicator::sendObject(const BlasVector<Field, Storage>& V, int dest, bool synchronous, std::true_type)
+    {
+        sendDense(V, V.size(), 1u, dest, synchronous);
+    }
+
+    template <class Field, class Storage> void Communicator::recvObject(BlasVector<Field, Storage>& V, int src, std::true_type)
+    {
+        uint64_t header[5];
+        MPI_Recv(header, 5, MPI_UINT64_T, src, 0, _comm, &_status);
+        V.resize(header[0]);
+        recvBuffer(V.getPointer(), header[2], _status.MPI_SOURCE, header[4]);
+    }
+
+    template <class Field, class Storage> void Communicator::bcastObject(BlasVector<Field, Storage>& V, int src, std::true_type)
+    {
+        uint64_t header[5] = {V.size(), 1u, V.size(), 0u, _chunkSize};
+        MPI_Bcast(header, 5, MPI_UINT64_T, src, _comm);
+        if (src != _rank) {
+            V.resize(header[0]);
+        }
+        bcastBuffer(V.getPointer(), header[2], src, header[4]);
+    }
+
+    // ----- SparseMatrix
+
+    template <class Field>
+    void Communicator::packSparse(const SparseMatrix<Field, SparseMatrixFormat::SparseSeq>& M, std::vector<uint64_t>& rowStarts,
+                                  std::vector<uint32_t>& colIndices32, std::vector<uint64_t>& colIndices64)
+    {
+        const bool smallIndices = (M.coldim() <= UINT32_MAX);
+
+        rowStarts.resize(M.rowdim() + 1);
+        rowStarts[0] = 0u;
+        for (uint64_t i = 0u; i < M.rowdim(); ++i) {
+            rowStarts[i + 1] = rowStarts[i] + M[i].size();
+        }
+
+        colIndices32.clear();
+        colIndices64.clear();
+        if (smallIndices) colIndices32.reserve(rowStarts.back());
+        else colIndices64.reserve(rowStarts.back());
+
+        for (uint64_t i = 0u; i < M.rowdim(); ++i) {
+            for (const auto& entry : M[i]) {
+                if (smallIndices) colIndices32.push_back(static_cast<uint32_t>(entry.first));
+                else colIndices64.push_back(entry.first);
+            }
+        }
+    }
+
+    /**
+     * Sizes the rows and sets their column indices,
+     * the values are then received in place.
+     */
+    template <class Field>
+    void Communicator::unpackSparse(SparseMatrix<Field, SparseMatrixFormat::SparseSeq>& M, const uint64_t* header,
+                                    const std::vector<uint64_t>& rowStarts, const std::vector<uint32_t>& colIndices32,
+                                    const std::vector<uint64_t>& colIndices64)
+    {
+        const bool smallIndices = (header[3] == 4u);
+
+        M.resize(header[0], header[1]);
+        for (uint64_t i = 0u; i < header[0]; ++i) {
+            auto& row = M.getRow(i);
+            row.resize(rowStarts[i + 1] - rowStarts[i]);
+            for (uint64_t k = rowStarts[i]; k < rowStarts[i + 1]; ++k) {
+                row[k - rowStarts[i]].first = smallIndices ? colIndices32[k] : colIndices64[k];
+            }
+        }
+    }
+
+    /**
+     * Calls post(type) for consecutive groups of rows of at most chunkSize bytes of values
+     * (a longer row is a group by itself).
+     * The MPI datatype, relative to MPI_BOTTOM, describes the values of the group in place,
+     * strided within the (index, value) entries of the rows, so that no copy is made.
+     */
+    template <class Field, class Post>
+    void Communicator::postSparseValues(const SparseMatrix<Field, SparseMatrixFormat::SparseSeq>& M, uint64_t chunkSize, Post post)
+    {
+        using Element = typename Field::Element;
+        using Entry = typename SparseMatrix<Field, SparseMatrixFormat::SparseSeq>::Row::value_type;
+        const uint64_t chunkCount = std::max<uint64_t>(1u, chunkSize / sizeof(Element));
+
+        MPI_Datatype strided;
+        MPI_Type_create_resized(MPITypeTraits<Element>::type(), 0, sizeof(Entry), &strided);
+
+        std::vector<int> lengths;
+        std::vector<MPI_Aint> displacements;
+        uint64_t count = 0u;
+        auto flush = [&]() {
+            if (lengths.empty()) return;
+            MPI_Datatype group;
+            MPI_Type_create_hindexed(lengths.size(), lengths.data(), displacements.data(), strided, &group);
+            MPI_Type_commit(&group);
+            post(group);
+            // @note Pending communications keep the datatype alive.
+            MPI_Type_free(&group);
+            lengths.clear();
+            displacements.clear();
+            count = 0u;
+        };
+
+        for (uint64_t i = 0u; i < M.rowdim(); ++i) {
+            const auto& row = M[i];
+            if (row.empty()) continue;
+            if (count > 0u && count + row.size() > chunkCount) flush();
+
+            MPI_Aint address;
+            MPI_Get_address(const_cast<Element*>(&row[0].second), &address);
+            lengths.push_back(static_cast<int>(row.size()));
+            displacements.push_back(address);
+            count += row.size();
+        }
+        flush();
+
+        MPI_Type_free(&strided);
+    }
+
+    template <class Field> void Communicator::send(const SparseMatrix<Field, SparseMatrixFormat::SparseSeq>& M, int dest)
+    {
+        sendObject(M, dest, false, NativeTag<Field>());
+    }
+
+    template <class Field> void Communicator::ssend(const SparseMatrix<Field, SparseMatrixFormat::SparseSeq>& M, int dest)
+    {
+        sendObject(M, dest, true, NativeTag<Field>());
+    }
+
+    template <class Field> void Communicator::recv(SparseMatrix<Field, SparseMatrixFormat::SparseSeq>& M, int src)
+    {
+        recvObject(M, src, NativeTag<Field>());
+    }
+
+    template <class Field> void Communicator::bcast(SparseMatrix<Field, SparseMatrixFormat::SparseSeq>& M, int src)
+    {
+        bcastObject(M, src, NativeTag<Field>());
+    }
+
+    template <class Field>
+    void Communicator::sendObject(const SparseMatrix<Field, SparseMatrixFormat::SparseSeq>& M, int dest, bool synchronous, std::true_type)
+    {
+        std::vector<uint64_t> rowStarts;
+        std::vector<uint32_t> colIndices32;
+        std::vector<uint64_t> colIndices64;
+        packSparse(M, rowStarts, colIndices32, colIndices64);
+
+        uint64_t header[5] = {M.rowdim(), M.coldim(), rowStarts.back(), colIndices64.empty() ? 4u : 8u, _chunkSize};
+        if (synchronous) {
+            MPI_Ssend(header, 5, MPI_UINT64_T, dest, 0, _comm);
+        }
+        else {
+            MPI_Send(header, 5, MPI_UINT64_T, dest, 0, _comm);
+        }
+
+        sendBuffer(rowStarts.data(), rowStarts.size(), dest, synchronous, header[4]);
+        if (header[3] == 4u) {
+            sendBuffer(colIndices32.data(), header[2], dest, synchronous, header[4]);
+        }
+        else {
+            sendBuffer(colIndices64.data(), header[2], dest, synchronous, header[4]);
+        }
+
+        std::vector<MPI_Request> requests;
+        postSparseValues(M, header[4], [&](MPI_Datatype group) {
+            requests.emplace_back();
+            if (synchronous) {
+                MPI_Issend(MPI_BOTTOM, 1, group, dest, 0, _comm, &requests.back());
+            }
+            else {
+                MPI_Isend(MPI_BOTTOM, 1, group, dest, 0, _comm, &requests.back());
+            }
+        });
+        MPI_Waitall(requests.size(), requests.data(), MPI_STATUSES_IGNORE);
+    }
+
+    template <class Field>
+    void Communicator::recvObject(SparseMatrix<Field, SparseMatrixFormat::SparseSeq>& M, int src, std::true_type)
+    {
+        uint64_t header[5];
+        MPI_Recv(header, 5, MPI_UINT64_T, src, 0, _comm, &_status);
+        const int source = _status.MPI_SOURCE;
+
+        std::vector<uint64_t> rowStarts(header[0] + 1);
+        std::vector<uint32_t> colIndices32;
+        std::vector<uint64_t> colIndices64;
+
+        recvBuffer(rowStarts.data(), rowStarts.size(), source, header[4]);
+        if (header[3] == 4u) {
+            colIndices32.resize(header[2]);
+            recvBuffer(colIndices32.data(), header[2], source, header[4]);
+        }
+        else {
+            colIndices64.resize(header[2]);
+            recvBuffer(colIndices64.data(), header[2], source, header[4]);
+        }
+        unpackSparse(M, header, rowStarts, colIndices32, colIndices64);
+
+        std::vector<MPI_Request> requests;
+        postSparseValues(M, header[4], [&](MPI_Datatype group) {
+            requests.emplace_back();
+            MPI_Irecv(MPI_BOTTOM, 1, group, source, 0, _comm, &requests.back());
+        });
+        MPI_Waitall(requests.size(), requests.data(), MPI_STATUSES_IGNORE);
+    }
+
+    template <class Field>
+    void Communicator::bcastObject(SparseMatrix<Field, SparseMatrixFormat::SparseSeq>& M, int src, std::true_type)
+    {
+        std::vector<uint64_t> rowStarts;
+        std::vector<uint32_t> colIndices32;
+        std::vector<uint64_t> colIndices64;
+
+        uint64_t header[5] = {0u, 0u, 0u, 0u, _chunkSize};
+        if (src == _rank) {
+            packSparse(M, rowStarts, colIndices32, colIndices64);
+            header[0] = M.rowdim();
+            header[1] = M.coldim();
+            header[2] = rowStarts.back();
+            header[3] = colIndices64.empty() ? 4u : 8u;
+        }
+        MPI_Bcast(header, 5, MPI_UINT64_T, src, _comm);
+
+        if (src != _rank) {
+            rowStarts.resize(header[0] + 1);
+            (header[3] == 4u) ? colIndices32.resize(header[2]) : colIndices64.resize(header[2]);
+        }
+
+        bcastBuffer(rowStarts.data(), rowStarts.size(), src, header[4]);
+        if (header[3] == 4u) {
+            bcastBuffer(colIndices32.data(), header[2], src, header[4]);
+        }
+        else {
+            bcastBuffer(colIndices64.data(), header[2], src, header[4]);
+        }
+
+        if (src != _rank) {
+            unpackSparse(M, header, rowStarts, colIndices32, colIndices64);
+        }
+
+        std::vector<MPI_Request> requests;
+        postSparseValues(M, header[4], [&](MPI_Datatype group) {
+            requests.emplace_back();
+            MPI_Ibcast(MPI_BOTTOM, 1, group, src, _comm, &requests.back());
+        });
+        MPI_Waitall(requests.size(), requests.data(), MPI_STATUSES_IGNORE);
+    }
 }
 
 // Local Variables:
@@ -0,0 +1,106 @@
+/* Copyright (C) 2026 The LinBox group
+ *
+ * ========LICENCE========
+ * This file is part of the library LinBox.
+ *
+  * LinBox is free software: you can redistribute it and/or modify
+ * it under the terms of the  GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.	 See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ * ========LICENCE========
+ */
+
+#pragma once
+
+#include "./serialization.h"
+
+#include <istream>
+#include <ostream>
+#include <string>
+
+/**
+ * Versioned (v2) streaming serialization.
+ *
+ * Unlike the functions of serialization.h, these write to (or read from)
+ * a std::ostream/std::istream or a POSIX file descriptor, one row at a time,
+ * so that memory usage stays bounded by the size of a row.
+ *
+ * Every object starts with a header (by bytes count):
+ *  0-3     magic       "LBX2"
+ *  4-5     version     Format version, currently 2
+ *  6       kind        What follows (see SerializationKind)
+ *  7       limb        sizeof(mp_limb_t) of the writer, informative only
+ *  8       element     sizeof(Element) if elements are word-size, 0 if multiprecision
+ *  9-..    field       Field descriptor (varint length + F.write() output)
+ *  ..      p           Field characteristic, as an Integer
+ *
+ * Unsigned numbers (dimensions, counts, indices) are written as LEB128 varints.
+ * Integers are written as a sign byte, a varint byte count and
+ * their magnitude as little-endian bytes, independently of the GMP limb size.
+ * Word-size elements are packed little-endian on sizeof(Element) bytes.
+ *
+ * Payloads:
+ *  - BlasVector    l, then the l entries
+ *  - BlasMatrix    n, m, then the n * m entries row-majored
+ *  - SparseMatrix  n, m, then for each row: its number of non-zero entries k,
+ *                  k column indices as deltas (first one absolute, then minus previous minus one),
+ *                  then the k values.
+ *
+ * Unserialization throws a LinboxError if the header does not match
+ * the version, the element width or the characteristic of the destination field.
+ */
+
+namespace LinBox {
+    enum class SerializationKind : uint8_t {
+        Integer = 1,
+        BlasVector = 2,
+        BlasMatrix = 3,
+        SparseMatrix = 4,
+    };
+
+    // Raw varint and Integer encoding, no header.
+
+    void write_varint(std::ostream& os, uint64_t value);
+    uint64_t read_varint(std::istream& is);
+
+    void write_integer(std::ostream& os, const Integer& integer);
+    void read_integer(Integer& integer, std::istream& is);
+
+    // Streams
+
+    void serialize_to(std::ostream& os, const Integer& integer);
+    void unserialize_from(Integer& integer, std::istream& is);
+
+    template <class Field> void serialize_to(std::ostream& os, const BlasVector<Field>& V);
+    template <class Field> void unserialize_from(BlasVector<Field>& V, std::istream& is);
+
+    template <class Field> void serialize_to(std::ostream& os, const BlasMatrix<Field>& M);
+    template <class Field> void unserialize_from(BlasMatrix<Field>& M, std::istream& is);
+
+    template <class Field> void serialize_to(std::ostream& os, const SparseMatrix<Field>& M);
+    template <class Field> void unserialize_from(SparseMatrix<Field>& M, std::istream& is);
+
+    // File descriptors, the fd is neither opened nor closed.
+
+    template <class T> void serialize_to(int fd, const T& value);
+    template <class T> void unserialize_from(T& value, int fd);
+}
+
+#include "serialization-stream.inl"
+
+// Local Variables:
+// mode: C++
+// tab-width: 4
+// indent-tabs-mode: nil
+// c-basic-offset: 4
+// End:
+// vim:sts=4:sw=4:ts=4:et:sr:cino=>s,f0,{0,g0,(0,\:0,t0,+0,=s
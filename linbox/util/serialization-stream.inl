@@ -0,0 +1,478 @@
+/* Copyright (C) 2026 The LinBox group
+ *
+ * ========LICENCE========
+ * This file is part of the library LinBox.
+ *
+  * LinBox is free software: you can redistribute it and/or modify
+ * it under the terms of the  GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.	 See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ * ========LICENCE========
+ */
+
+#pragma once
+
+#include "serialization-stream.h"
+
+#include <cerrno>
+#include <sstream>
+#include <type_traits>
+#include <unistd.h>
+
+#include "linbox/util/error.h"
+
+namespace LinBox {
+    // ----- Varints and Integers into byte buffers
+
+    inline void append_varint(std::vector<uint8_t>& bytes, uint64_t value)
+    {
+        while (value >= 0x80u) {
+            bytes.push_back(static_cast<uint8_t>(value | 0x80u));
+            value >>= 7;
+        }
+        bytes.push_back(static_cast<uint8_t>(value));
+    }
+
+    inline void append_integer(std::vector<uint8_t>& bytes, const Integer& integer)
+    {
+        const __mpz_struct* mpzStruct = integer.get_mpz();
+
+        // @note mpz_export writes bytes from the least significant one,
+        // whatever the size of the limbs, so that the format does not depend on GMP configuration.
+        size_t count = (mpz_sizeinbase(mpzStruct, 2) + 7u) / 8u;
+        if (mpzStruct->_mp_size == 0) count = 0u;
+
+        bytes.push_back(mpzStruct->_mp_size < 0 ? 1u : 0u);
+        append_varint(bytes, count);
+
+        auto offset = bytes.size();
+        bytes.resize(offset + count);
+        if (count > 0u) {
+            mpz_export(&bytes[offset], &count, -1, 1, 0, 0, mpzStruct);
+        }
+    }
+
+    // ----- Streams
+
+    inline void write_varint(std::ostream& os, uint64_t value)
+    {
+        std::vector<uint8_t> bytes;
+        append_varint(bytes, value);
+        os.write(reinterpret_cast<const char*>(bytes.data()), bytes.size());
+    }
+
+    inline uint64_t read_varint(std::istream& is)
+    {
+        uint64_t value = 0u;
+        for (uint32_t shift = 0u; shift < 64u; shift += 7u) {
+            int c = is.get();
+            if (c == std::char_traits<char>::eof()) {
+                throw LinboxError("LinBox ERROR: unexpected end of stream while reading a varint.");
+            }
+
+            value |= static_cast<uint64_t>(c & 0x7f) << shift;
+            if ((c & 0x80) == 0) {
+                return value;
+            }
+        }
+
+        throw LinboxError("LinBox ERROR: malformed varint in stream.");
+    }
+
+    inline void write_integer(std::ostream& os, const Integer& integer)
+    {
+        std::vector<uint8_t> bytes;
+        append_integer(bytes, integer);
+        os.write(reinterpret_cast<const char*>(bytes.data()), bytes.size());
+    }
+
+    inline void read_integer(Integer& integer, std::istream& is)
+    {
+        int sign = is.get();
+        uint64_t count = read_varint(is);
+
+        std::vector<uint8_t> bytes(count);
+        is.read(reinterpret_cast<char*>(bytes.data()), count);
+        if (sign == std::char_traits<char>::eof() || !is) {
+            throw LinboxError("LinBox ERROR: unexpected end of stream while reading an Integer.");
+        }
+
+        integer = 0;
+        if (count > 0u) {
+            mpz_import(integer.get_mpz(), count, -1, 1, 0, 0, bytes.data());
+        }
+        if (sign == 1) {
+            integer = -integer;
+        }
+    }
+
+    namespace Protected {
+        /**
+         * How elements are packed: word-size ones on their sizeof,
+         * the others as Integers.
+         */
+        template <class Element, bool isWord = std::is_arithmetic<Element>::value>
+        struct SerializationCodec {
+            static constexpr uint8_t width = sizeof(Element);
+
+            static void append(std::vector<uint8_t>& bytes, const Element& e) { serialize(bytes, e); }
+
+            // Reads count elements at once.
+            template <class Iterator>
+            static void read(Iterator it, uint64_t count, std::istream& is, std::vector<uint8_t>& bytes)
+            {
+                bytes.resize(count * width);
+                is.read(reinterpret_cast<char*>(bytes.data()), bytes.size());
+                if (!is) {
+                    throw LinboxError("LinBox ERROR: unexpected end of stream while reading entries.");
+                }
+
+                for (uint64_t k = 0u; k < count; ++k, ++it) {
+                    unserialize(*it, bytes, k * width);
+                }
+            }
+        };
+
+        template <class Element>
+        struct SerializationCodec<Element, false> {
+            static constexpr uint8_t width = 0u;
+
+            static void append(std::vector<uint8_t>& bytes, const Element& e) { append_integer(bytes, e); }
+
+            template <class Iterator>
+            static void read(Iterator it, uint64_t count, std::istream& is, std::vector<uint8_t>&)
+            {
+                for (uint64_t k = 0u; k < count; ++k, ++it) {
+                    read_integer(*it, is);
+                }
+            }
+        };
+
+        inline void write_bytes(std::ostream& os, std::vector<uint8_t>& bytes)
+        {
+            os.write(reinterpret_cast<const char*>(bytes.data()), bytes.size());
+            bytes.clear();
+        }
+
+        inline void append_header(std::vector<uint8_t>& bytes, SerializationKind kind, uint8_t width,
+                                  const std::string& descriptor, const Integer& characteristic)
+        {
+            bytes.insert(bytes.end(), {'L', 'B', 'X', '2'});
+            serialize(bytes, static_cast<uint16_t>(2u));
+            bytes.push_back(static_cast<uint8_t>(kind));
+            bytes.push_back(static_cast<uint8_t>(sizeof(mp_limb_t)));
+            bytes.push_back(width);
+            append_varint(bytes, descriptor.size());
+            bytes.insert(bytes.end(), descriptor.begin(), descriptor.end());
+            append_integer(bytes, characteristic);
+        }
+
+        template <class Field>
+        inline void write_header(std::ostream& os, SerializationKind kind, const Field& F)
+        {
+            std::ostringstream descriptor;
+            F.write(descriptor);
+            Integer characteristic;
+            F.characteristic(characteristic);
+
+            std::vector<uint8_t> bytes;
+            append_header(bytes, kind, SerializationCodec<typename Field::Element>::width, descriptor.str(), characteristic);
+            write_bytes(os, bytes);
+        }
+
+        // Checks everything but the field, returns its characteristic.
+        inline Integer read_header_common(std::istream& is, SerializationKind kind, uint8_t width)
+        {
+            uint8_t bytes[9];
+            is.read(reinterpret_cast<char*>(bytes), 9);
+            if (!is || bytes[0] != 'L' || bytes[1] != 'B' || bytes[2] != 'X' || bytes[3] != '2') {
+                throw LinboxError("LinBox ERROR: not a LinBox v2 serialized stream.");
+            }
+
+            uint16_t version;
+            unserialize(version, std::vector<uint8_t>(bytes + 4, bytes + 6));
+            if (version != 2u) {
+                throw LinboxError("LinBox ERROR: unsupported serialization version.");
+            }
+            if (bytes[6] != static_cast<uint8_t>(kind)) {
+                throw LinboxError("LinBox ERROR: serialized object is not of the expected kind.");
+            }
+            if (bytes[8] != width) {
+                throw LinboxError("LinBox ERROR: serialized elements do not have the expected width.");
+            }
+
+            // The field descriptor is informative only.
+            uint64_t descriptorLength = read_varint(is);
+            is.ignore(descriptorLength);
+
+            Integer characteristic;
+            read_integer(characteristic, is);
+            return characteristic;
+        }
+
+        template <class Field>
+        inline void read_header(std::istream& is, SerializationKind kind, const Field& F)
+        {
+            Integer characteristic = read_header_common(is, kind, SerializationCodec<typename Field::Element>::width);
+
+            Integer expected;
+            F.characteristic(expected);
+            if (characteristic != expected) {
+                throw LinboxError("LinBox ERROR: serialized object is over a field of another characteristic.");
+            }
+        }
+
+        /**
+         * Minimal buffered std::streambuf over a POSIX file descriptor.
+         * @note When reading, it reads ahead by blocks; the unread part
+         * is given back on destruction if the descriptor is seekable,
+         * so that objects can be read one after the other from a file.
+         */
+        class FdStreamBuffer : public std::streambuf {
+        public:
+            FdStreamBuffer(int fd, size_t size = 1u << 16)
+                : _fd(fd)
+                , _buffer(size)
+            {
+                setp(_buffer.data(), _buffer.data() + _buffer.size());
+                setg(_buffer.data(), _buffer.data(), _buffer.data());
+            }
+
+            ~FdStreamBuffer()
+            {
+                sync();
+                if (gptr() < egptr()) {
+                    ::lseek(_fd, -static_cast<off_t>(egptr() - gptr()), SEEK_CUR);
+                }
+            }
+
+        protected:
+            int_type overflow(int_type c) override
+            {
+                if (sync() != 0) return traits_type::eof();
+                if (!traits_type::eq_int_type(c, traits_type::eof())) {
+                    *pptr() = traits_type::to_char_type(c);
+                    pbump(1);
+                }
+                return traits_type::not_eof(c);
+            }
+
+            int sync() override
+            {
+                const char* data = pbase();
+                while (data < pptr()) {
+                    ssize_t written = ::write(_fd, data, pptr() - data);
+                    if (written < 0 && errno == EINTR) continue;
+                    if (written <= 0) return -1;
+                    data += written;
+                }
+                setp(_buffer.data(), _buffer.data() + _buffer.size());
+                return 0;
+            }
+
+            int_type underflow() override
+            {
+                if (gptr() < egptr()) return traits_type::to_int_type(*gptr());
+
+                ssize_t count;
+                do {
+                    count = ::read(_fd, _buffer.data(), _buffer.size());
+                } while (count < 0 && errno == EINTR);
+                if (count <= 0) return traits_type::eof();
+
+                setg(_buffer.data(), _buffer.data(), _buffer.data() + count);
+                return traits_type::to_int_type(*gptr());
+            }
+
+        private:
+            int _fd;
+            std::vector<char> _buffer;
+        };
+    }
+
+    // ----- Integer
+
+    inline void serialize_to(std::ostream& os, const Integer& integer)
+    {
+        std::vector<uint8_t> bytes;
+        Protected::append_header(bytes, SerializationKind::Integer, 0u, "Integer", Integer(0));
+        append_integer(bytes, integer);
+        Protected::write_bytes(os, bytes);
+    }
+
+    inline void unserialize_from(Integer& integer, std::istream& is)
+    {
+        Protected::read_header_common(is, SerializationKind::Integer, 0u);
+        read_integer(integer, is);
+    }
+
+    // ----- BlasVector
+
+    template <class Field>
+    inline void serialize_to(std::ostream& os, const BlasVector<Field>& V)
+    {
+        using Codec = Protected::SerializationCodec<typename Field::Element>;
+        Protected::write_header(os, SerializationKind::BlasVector, V.field());
+
+        std::vector<uint8_t> bytes;
+        append_varint(bytes, V.size());
+        for (uint64_t i = 0u; i < V.size(); ++i) {
+            Codec::append(bytes, V[i]);
+            if (bytes.size() >= (1u << 16)) {
+                Protected::write_bytes(os, bytes);
+            }
+        }
+        Protected::write_bytes(os, bytes);
+    }
+
+    template <class Field>
+    inline void unserialize_from(BlasVector<Field>& V, std::istream& is)
+    {
+        using Codec = Protected::SerializationCodec<typename Field::Element>;
+        Protected::read_header(is, SerializationKind::BlasVector, V.field());
+
+        uint64_t l = read_varint(is);
+        V.resize(l);
+
+        std::vector<uint8_t> bytes;
+        Codec::read(V.begin(), l, is, bytes);
+    }
+
+    // ----- BlasMatrix
+
+    template <class Field>
+    inline void serialize_to(std::ostream& os, const BlasMatrix<Field>& M)
+    {
+        using Codec = Protected::SerializationCodec<typename Field::Element>;
+        Protected::write_header(os, SerializationKind::BlasMatrix, M.field());
+
+        std::vector<uint8_t> bytes;
+        uint64_t n = M.rowdim(), m = M.coldim();
+        append_varint(bytes, n);
+        append_varint(bytes, m);
+        for (uint64_t i = 0u; i < n; ++i) {
+            for (uint64_t j = 0u; j < m; ++j) {
+                Codec::append(bytes, M.getEntry(i, j));
+            }
+            Protected::write_bytes(os, bytes);
+        }
+        Protected::write_bytes(os, bytes);
+    }
+
+    template <class Field>
+    inline void unserialize_from(BlasMatrix<Field>& M, std::istream& is)
+    {
+        using Codec = Protected::SerializationCodec<typename Field::Element>;
+        Protected::read_header(is, SerializationKind::BlasMatrix, M.field());
+
+        uint64_t n = read_varint(is);
+        uint64_t m = read_varint(is);
+        M.resize(n, m);
+
+        std::vector<uint8_t> bytes;
+        for (uint64_t i = 0u; i < n; ++i) {
+            Codec::read(M.getPointer() + i * m, m, is, bytes);
+        }
+    }
+
+    // ----- SparseMatrix
+
+    template <class Field>
+    inline void serialize_to(std::ostream& os, const SparseMatrix<Field>& M)
+    {
+        using Codec = Protected::SerializationCodec<typename Field::Element>;
+        Protected::write_header(os, SerializationKind::SparseMatrix, M.field());
+
+        std::vector<uint8_t> bytes;
+        uint64_t n = M.rowdim(), m = M.coldim();
+        append_varint(bytes, n);
+        append_varint(bytes, m);
+
+        // @note Rows are expected to be sorted by column index, as setEntry keeps them.
+        for (uint64_t i = 0u; i < n; ++i) {
+            const auto& row = M[i];
+            append_varint(bytes, row.size());
+
+            uint64_t next = 0u;
+            for (const auto& entry : row) {
+                append_varint(bytes, entry.first - next);
+                next = entry.first + 1u;
+            }
+            for (const auto& entry : row) {
+                Codec::append(bytes, entry.second);
+            }
+
+            Protected::write_bytes(os, bytes);
+        }
+    }
+
+    template <class Field>
+    inline void unserialize_from(SparseMatrix<Field>& M, std::istream& is)
+    {
+        using Codec = Protected::SerializationCodec<typename Field::Element>;
+        Protected::read_header(is, SerializationKind::SparseMatrix, M.field());
+
+        uint64_t n = read_varint(is);
+        uint64_t m = read_varint(is);
+        M.resize(n, m);
+
+        std::vector<uint8_t> bytes;
+        std::vector<typename Field::Element> values;
+        for (uint64_t i = 0u; i < n; ++i) {
+            auto& row = M.getRow(i);
+            uint64_t k = read_varint(is);
+
+            row.resize(k);
+            uint64_t next = 0u;
+            for (auto& entry : row) {
+                entry.first = next + read_varint(is);
+                next = entry.first + 1u;
+            }
+
+            values.resize(k);
+            Codec::read(values.begin(), k, is, bytes);
+            for (uint64_t l = 0u; l < k; ++l) {
+                row[l].second = values[l];
+            }
+        }
+    }
+
+    // ----- File descriptors
+
+    template <class T>
+    inline void serialize_to(int fd, const T& value)
+    {
+        Protected::FdStreamBuffer buffer(fd);
+        std::ostream os(&buffer);
+        serialize_to(os, value);
+        os.flush();
+        if (!os) {
+            throw LinboxError("LinBox ERROR: failed to write serialized object to file descriptor.");
+        }
+    }
+
+    template <class T>
+    inline void unserialize_from(T& value, int fd)
+    {
+        Protected::FdStreamBuffer buffer(fd);
+        std::istream is(&buffer);
+        unserialize_from(value, is);
+    }
+}
+
+// Local Variables:
+// mode: C++
+// tab-width: 4
+// indent-tabs-mode: nil
+// c-basic-offset: 4
+// End:
+// vim:sts=4:sw=4:ts=4:et:sr:cino=>s,f0,{0,g0,(0,\:0,t0,+0,=s
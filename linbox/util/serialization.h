@@ -39,10 +39,11 @@
  *
  * As a convention, all numbers are written little-endian.
  *
- * @todo GMP Integers can be configured with limbs of different sizes (32 or 64 bits),
- * depending on the machine. We do not handle that right now,
- * but storing info about their dimension might be a good idea,
- * to at least emit a warning.
+ * @note GMP Integers can be configured with limbs of different sizes (32 or 64 bits),
+ * depending on the machine. This format always writes 64-bit limbs.
+ * The versioned streaming format of serialization-stream.h records the limb size
+ * in its header and writes Integers independently of it, it is also more compact
+ * and does not need the whole object in memory.
  */
 
 namespace LinBox {
@@ -0,0 +1,199 @@
+/* Copyright (C) 2026 The LinBox group
+ *
+ * ========LICENCE========
+ * This file is part of the library LinBox.
+ *
+  * LinBox is free software: you can redistribute it and/or modify
+ * it under the terms of the  GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.	 See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ * ========LICENCE========
+ */
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "linbox/util/instrumentation.h"
+
+/**
+ * Operation counts of the runs of an algorithm.
+ *
+ * A Statistics is given to the solutions through their Method and
+ * the algorithms add to it what they did:
+ * \code
+ * Statistics stats;
+ * Method::Wiedemann m;
+ * m.statistics = &stats;
+ * minpoly(P, A, m);
+ * stats.write(std::clog) << std::endl;
+ * \endcode
+ * prints one line such as
+ * <code>applies=2001 sequenceLength=2002 earlyTerminationStep=0 bytesMoved=...</code>
+ *
+ * The counters are atomic, so that the residues of a parallel CRA can
+ * all add to the same Statistics; they accumulate until clear().
+ * Counters an algorithm does not know about are left untouched.
+ */
+
+namespace LinBox {
+    class Statistics {
+    public:
+        /// Relaxed atomic counter.
+        class Counter {
+        public:
+            Counter() : _value(0) {}
+
+            Counter& operator+=(uint64_t n)
+            {
+                _value.fetch_add(n, std::memory_order_relaxed);
+                return *this;
+            }
+            Counter& operator++() { return *this += 1; }
+
+            /// Keeps the largest of the current value and n.
+            void maximize(uint64_t n)
+            {
+                uint64_t v = _value.load(std::memory_order_relaxed);
+                while (v < n && !_value.compare_exchange_weak(v, n, std::memory_order_relaxed)) {
+                }
+            }
+
+            uint64_t value() const { return _value.load(std::memory_order_relaxed); }
+            operator uint64_t() const { return value(); }
+            void clear() { _value.store(0, std::memory_order_relaxed); }
+
+        private:
+            std::atomic<uint64_t> _value;
+        };
+
+        // ----- Blackbox methods.
+        Counter applies;              //!< Blackbox applies.
+        Counter sequenceLength;       //!< Terms of the projected sequences given to Berlekamp/Massey.
+        Counter earlyTerminationStep; //!< Largest term at which Berlekamp/Massey terminated early, 0 if it never did.
+        Counter bytesMoved;           //!< Estimate of the bytes read and written by the blackbox applies.
+
+        // ----- Integer methods.
+        Counter primes;    //!< Primes of the Chinese remaindering, bad ones included.
+        Counter badPrimes; //!< Primes of the Chinese remaindering which were skipped or discarded.
+        Counter digits;    //!< p-adic digits lifted.
+
+        Statistics() = default;
+        Statistics(const Statistics&) = delete;
+        Statistics& operator=(const Statistics&) = delete;
+
+        /// Adds seconds to the time of a phase.
+        void addTime(const std::string& phase, double seconds)
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            for (auto& t : _times) {
+                if (t.first == phase) {
+                    t.second += seconds;
+                    return;
+                }
+            }
+            _times.emplace_back(phase, seconds);
+        }
+
+        /// Total time of a phase, in seconds.
+        double time(const std::string& phase) const
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            for (const auto& t : _times) {
+                if (t.first == phase) return t.second;
+            }
+            return 0.;
+        }
+
+        /// Phases and their times, in the order they first ran.
+        std::vector<std::pair<std::string, double>> times() const
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            return _times;
+        }
+
+        /// Adds a Berlekamp/Massey run on a blackbox sequence.
+        template <class Sequence, class Massey>
+        void addMassey(const Sequence& S, const Massey& MD, uint64_t bytesPerApply = 0)
+        {
+            applies += S.applies();
+            bytesMoved += S.applies() * bytesPerApply;
+            sequenceLength += MD.sequenceLength();
+            earlyTerminationStep.maximize(MD.earlyTerminationStep());
+        }
+
+        void clear()
+        {
+            for (Counter* c : {&applies, &sequenceLength, &earlyTerminationStep, &bytesMoved, &primes, &badPrimes, &digits})
+                c->clear();
+            std::lock_guard<std::mutex> lock(_mutex);
+            _times.clear();
+        }
+
+        /// One line of key=value pairs, the phase times in seconds.
+        std::ostream& write(std::ostream& os) const
+        {
+            os << "applies=" << applies.value() << " sequenceLength=" << sequenceLength.value()
+               << " earlyTerminationStep=" << earlyTerminationStep.value() << " bytesMoved=" << bytesMoved.value()
+               << " primes=" << primes.value() << " badPrimes=" << badPrimes.value() << " digits=" << digits.value();
+            for (const auto& t : times()) os << " time[" << t.first << "]=" << t.second;
+            return os;
+        }
+
+        /**
+         * Times a scope as a phase, when statistics are given,
+         * and traces it as an Instrumentation::Scope of the same name.
+         */
+        class Phase {
+        public:
+            Phase(Statistics* statistics, const char* name)
+                : _statistics(statistics)
+                , _name(name)
+                , _scope(name)
+                , _start(std::chrono::steady_clock::now())
+            {
+            }
+
+            ~Phase()
+            {
+                if (_statistics == nullptr) return;
+                std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - _start;
+                _statistics->addTime(_name, elapsed.count());
+            }
+
+            Phase(const Phase&) = delete;
+            Phase& operator=(const Phase&) = delete;
+
+        private:
+            Statistics* _statistics;
+            const char* _name;
+            Instrumentation::Scope _scope;
+            std::chrono::steady_clock::time_point _start;
+        };
+
+    private:
+        mutable std::mutex _mutex;
+        std::vector<std::pair<std::string, double>> _times;
+    };
+
+    inline std::ostream& operator<<(std::ostream& os, const Statistics& statistics)
+    {
+        return statistics.write(os);
+    }
+}
@@ -0,0 +1,266 @@
+/* linbox/vector/aligned-storage.h
+ * Copyright (C) 2026 The LinBox group
+ *
+ * ========LICENCE========
+ * This file is part of the library LinBox.
+ *
+  * LinBox is free software: you can redistribute it and/or modify
+ * it under the terms of the  GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.	 See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ * ========LICENCE========
+ */
+
+/*! @file vector/aligned-storage.h
+ * @ingroup vector
+ * @brief Aligned, huge page and NUMA aware storage for \c BlasVector and \c BlasMatrix.
+ *
+ * \c AlignedStorage<Element, Flags> is a \c std::vector with an
+ * \ref StorageAllocator and can be given as the \c _Storage parameter:
+ * \code
+ * typedef AlignedStorage<double, StorageFlags::Uninitialized | StorageFlags::NumaInterleave> Storage;
+ * BlasMatrix<Givaro::Modular<double>, Storage> A (F, m, n);
+ * \endcode
+ */
+
+#ifndef __LINBOX_vector_aligned_storage_H
+#define __LINBOX_vector_aligned_storage_H
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstdint>
+#include <new>
+#include <utility>
+#include <vector>
+#include <type_traits>
+
+#ifdef __linux__
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#include "linbox/vector/vector-traits.h"
+
+/*! Size from which the huge page and NUMA flags are honoured.
+ * Smaller blocks use the plain aligned allocation.
+ */
+#ifndef LINBOX_HUGE_PAGE_SIZE
+#define LINBOX_HUGE_PAGE_SIZE (size_t(1) << 21)
+#endif
+
+namespace LinBox
+{
+
+	//! Allocation options of \ref StorageAllocator, to be or'ed.
+	struct StorageFlags {
+		enum : unsigned {
+			Default              = 0,
+			TransparentHugePages = 1, //!< align large blocks on huge pages and ask the kernel for transparent huge pages
+			HugePages            = 2, //!< map large blocks from the explicit huge page pool (MAP_HUGETLB), transparent huge pages if it is empty
+			Uninitialized        = 4, //!< elements are default-initialised, neither zeroed nor touched
+			NumaInterleave       = 8  //!< interleave the pages of large blocks over the allowed NUMA nodes
+		};
+	};
+
+	/** \brief Standard allocator with alignment, huge page and NUMA options.
+	 *
+	 * The \p Flags are a combination of \ref StorageFlags.  The allocation
+	 * method only depends on the flags and on the size, so that deallocate
+	 * does not need to keep track of it.  The huge page and NUMA options are
+	 * hints: they are ignored outside of Linux and when the kernel declines.
+	 *
+	 * With StorageFlags::Uninitialized the entries of a new or resized
+	 * container are not written, they are first touched by the thread that
+	 * fills them; this is what places the pages with NumaInterleave or with
+	 * the first touch policy of the kernel.
+	 */
+	template<class T, size_t Alignment = 64, unsigned Flags = StorageFlags::Default>
+	class StorageAllocator {
+	public:
+		typedef T              value_type;
+		typedef T*             pointer;
+		typedef const T*       const_pointer;
+		typedef T&             reference;
+		typedef const T&       const_reference;
+		typedef size_t         size_type;
+		typedef std::ptrdiff_t difference_type;
+
+		static_assert ((Alignment & (Alignment - 1)) == 0 && Alignment >= sizeof (void*),
+			       "StorageAllocator: the alignment must be a power of two, at least sizeof(void*)");
+
+		template<class U>
+		struct rebind {
+			typedef StorageAllocator<U, Alignment, Flags> other;
+		};
+
+		StorageAllocator () noexcept {}
+		template<class U>
+		StorageAllocator (const StorageAllocator<U, Alignment, Flags>&) noexcept {}
+
+		pointer allocate (size_type n, const void* = 0)
+		{
+			if (n == 0) return nullptr;
+			if (n > max_size ()) throw std::bad_alloc ();
+			const size_t bytes = n * sizeof (T);
+			void *p = nullptr;
+#ifdef __linux__
+			if (useMap (bytes)) {
+				const size_t len = mapLength (bytes);
+#ifdef MAP_HUGETLB
+				p = mmap (nullptr, len, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+#else
+				p = MAP_FAILED;
+#endif
+				if (p == MAP_FAILED) {
+					p = mmap (nullptr, len, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+					if (p == MAP_FAILED) throw std::bad_alloc ();
+					adviseHugePages (p, len);
+				}
+				interleave (p, len);
+				return static_cast<pointer> (p);
+			}
+#endif
+			if (posix_memalign (&p, blockAlignment (bytes), bytes))
+				throw std::bad_alloc ();
+#ifdef __linux__
+			if (bytes >= LINBOX_HUGE_PAGE_SIZE) {
+				if (Flags & StorageFlags::TransparentHugePages)
+					adviseHugePages (p, bytes & ~(LINBOX_HUGE_PAGE_SIZE - 1));
+				interleave (p, bytes & ~(size_t (sysconf (_SC_PAGESIZE)) - 1));
+			}
+#endif
+			return static_cast<pointer> (p);
+		}
+
+		void deallocate (pointer p, size_type n) noexcept
+		{
+			if (p == nullptr) return;
+#ifdef __linux__
+			if (useMap (n * sizeof (T))) {
+				munmap (p, mapLength (n * sizeof (T)));
+				return;
+			}
+#endif
+			free (p);
+		}
+
+		size_type max_size () const noexcept
+		{
+			return size_type (-1) / sizeof (T);
+		}
+
+		//! Default-initialisation with StorageFlags::Uninitialized, value-initialisation otherwise.
+		template<class U>
+		void construct (U* p)
+		{
+			if (Flags & StorageFlags::Uninitialized)
+				::new ((void*)p) U;
+			else
+				::new ((void*)p) U ();
+		}
+
+		template<class U, class... Args>
+		void construct (U* p, Args&&... args)
+		{
+			::new ((void*)p) U (std::forward<Args> (args)...);
+		}
+
+		template<class U>
+		void destroy (U* p) { p->~U (); }
+
+		template<class U>
+		bool operator== (const StorageAllocator<U, Alignment, Flags>&) const noexcept { return true; }
+		template<class U>
+		bool operator!= (const StorageAllocator<U, Alignment, Flags>&) const noexcept { return false; }
+
+	protected:
+		static bool useMap (size_t bytes)
+		{
+			return (Flags & StorageFlags::HugePages) && (bytes >= LINBOX_HUGE_PAGE_SIZE);
+		}
+
+		static size_t mapLength (size_t bytes)
+		{
+			return (bytes + LINBOX_HUGE_PAGE_SIZE - 1) & ~(LINBOX_HUGE_PAGE_SIZE - 1);
+		}
+
+		// page alignment for NUMA (mbind works on pages), huge page alignment for THP
+		static size_t blockAlignment (size_t bytes)
+		{
+#ifdef __linux__
+			if (bytes >= LINBOX_HUGE_PAGE_SIZE) {
+				if (Flags & StorageFlags::TransparentHugePages)
+					return std::max (Alignment, size_t (LINBOX_HUGE_PAGE_SIZE));
+				if (Flags & StorageFlags::NumaInterleave)
+					return std::max (Alignment, size_t (sysconf (_SC_PAGESIZE)));
+			}
+#endif
+			return Alignment;
+		}
+
+#ifdef __linux__
+		static void adviseHugePages (void *p, size_t len)
+		{
+#ifdef MADV_HUGEPAGE
+			if (len) madvise (p, len, MADV_HUGEPAGE);
+#endif
+		}
+
+		// MPOL_INTERLEAVE over the nodes allowed to this process
+		static void interleave (void *p, size_t len)
+		{
+#if defined(SYS_mbind) && defined(SYS_get_mempolicy)
+			if (! (Flags & StorageFlags::NumaInterleave) || ! len) return;
+			const unsigned long maxnode = 1024;
+			unsigned long nodes[maxnode / (8 * sizeof (unsigned long))] = {};
+			const int mpolInterleave = 3, mpolMemsAllowed = 4;
+			if (syscall (SYS_get_mempolicy, nullptr, nodes, maxnode, nullptr, mpolMemsAllowed))
+				return;
+			syscall (SYS_mbind, p, len, mpolInterleave, nodes, maxnode, 0);
+#else
+			(void)p; (void)len;
+#endif
+		}
+#endif
+	};
+
+	/** \brief Dense storage with an \ref StorageAllocator (64 byte aligned).
+	 * To be used as the \c _Storage of \c BlasVector and \c BlasMatrix.
+	 */
+	template<class Element, unsigned Flags = StorageFlags::Default, size_t Alignment = 64>
+	using AlignedStorage = std::vector<Element, StorageAllocator<Element, Alignment, Flags> >;
+
+	//! Whether the new entries of a \p Storage are left uninitialised.
+	template<class Storage>
+	struct isUninitializedStorage : std::false_type {};
+
+	template<class T, size_t Alignment, unsigned Flags>
+	struct isUninitializedStorage<std::vector<T, StorageAllocator<T, Alignment, Flags> > > :
+		std::integral_constant<bool, (Flags & StorageFlags::Uninitialized) != 0> {};
+
+	template<class T, size_t Alignment, unsigned Flags, class U>
+	struct Rebind< std::vector<T, StorageAllocator<T, Alignment, Flags> >, U > {
+		typedef std::vector<typename U::Element, StorageAllocator<typename U::Element, Alignment, Flags> > other;
+	};
+
+} // LinBox
+
+#endif // __LINBOX_vector_aligned_storage_H
+
+// Local Variables:
+// mode: C++
+// tab-width: 4
+// indent-tabs-mode: nil
+// c-basic-offset: 4
+// End:
+// vim:sts=4:sw=4:ts=4:et:sr:cino=>s,f0,{0,g0,(0,\:0,t0,+0,=s
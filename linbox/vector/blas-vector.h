@@ -44,6 +44,7 @@
 #include "linbox/field/field-traits.h"
 #include "linbox/field/rebind.h"
 #include "linbox/vector/vector-traits.h"
+#include "linbox/vector/aligned-storage.h"
 #include "linbox/vector/blas-subvector.h"
 
 #include "fflas-ffpack/fflas/fflas.h"
@@ -88,8 +89,10 @@ namespace LinBox {
             _rep.resize(n);
             _ptr = _rep.data();
 // std::cout<<_ptr<<" ("<<n<<")"<<std::endl;
-            for (size_t i=_size;i<n;i++)
-                field().init(_rep[i]);
+            // entries of an uninitialised storage are written by the caller
+            if (! isUninitializedStorage<Storage>::value)
+                for (size_t i=_size;i<n;i++)
+                    field().init(_rep[i]);
             _size = n;
 // std::cout<<"BlasVector resize end."<<std::endl;
         }
@@ -108,6 +108,14 @@ bool testRankMethods(const typename BlackBox::Field & F, size_t n, size_t m, uns
 		equalRank = equalRank and rank_blackbox == rank_elimination;
 #endif
 
+		// Wiedemann rank with the lcm of the generators of several projections
+		size_t rank_projections;
+		Method::Blackbox MBP; MBP.numberOfProjections = 3;
+		LinBox::rank (rank_projections, A, MBP);
+		commentator().report ()
+			<< endl << "blackbox rank with " << MBP.numberOfProjections << " projections " << rank_projections << endl;
+		equalRank = equalRank and rank_projections == rank_elimination;
+
 #if 0
 		Method::Auto MH;
 		LinBox::rank (rank_hybrid, A, MH);